@@ -4,6 +4,7 @@
 #include "../Shared/Enum/AddressMode.hpp"
 #include "../Shared/Enum/BlendFactor.hpp"
 #include "../Shared/Enum/BlendOperator.hpp"
+#include "../Shared/Enum/BlitFilter.hpp"
 #include "../Shared/Enum/BorderColor.hpp"
 #include "../Shared/Enum/ColorMask.hpp"
 #include "../Shared/Enum/CompareOperator.hpp"
@@ -13,6 +14,7 @@
 #include "../Shared/Enum/FilterOptions.hpp"
 #include "../Shared/Enum/FrontFace.hpp"
 #include "../Shared/Enum/IndexType.hpp"
+#include "../Shared/Enum/InputRate.hpp"
 #include "../Shared/Enum/APIVersion.hpp"
 #include "../Shared/Enum/MemoryHeap.hpp"
 #include "../Shared/Enum/PrimitiveTopology.hpp"
@@ -28,9 +30,11 @@
 
 #include "../Shared/BlendProperty.hpp"
 #include "../Shared/DebugReport.hpp"
+#include "../Shared/Hash.hpp"
 #include "../Shared/LayoutElement.hpp"
 #include "../Shared/PixelFormatSizeOf.hpp"
 #include "../Shared/ScissorRect.hpp"
+#include "../Shared/IndirectArguments.hpp"
 #include "../Shared/StencilOperatorInfo.hpp"
 #include "../Shared/Utility.hpp"
 #include "../Shared/ViewPort.hpp"
@@ -48,7 +52,10 @@
 #include "../Interface/GpuDescriptorHeap.hpp"
 #include "../Interface/GpuLogicalDevice.hpp"
 #include "../Interface/GpuGraphicsPipeline.hpp"
+#include "../Interface/GpuAsyncGraphicsPipeline.hpp"
+#include "../Interface/GpuComputePipeline.hpp"
 #include "../Interface/GpuGraphicsCommandList.hpp"
+#include "../Interface/GpuGraphicsBundle.hpp"
 #include "../Interface/GpuFrameBuffer.hpp"
 #include "../Interface/GpuFence.hpp"
 #include "../Interface/GpuDisplayAdapter.hpp"
@@ -56,10 +63,15 @@
 #include "../Interface/GpuCommandAllocator.hpp"
 #include "../Interface/GpuRenderPass.hpp"
 #include "../Interface/GpuTextureRef.hpp"
+#include "../Interface/GpuCommandAllocatorPool.hpp"
+#include "../Interface/GpuFrameContext.hpp"
+#include "../Interface/GpuRenderGraph.hpp"
+#include "../Interface/GpuUploadRing.hpp"
 
 #include "../Interface/GpuResource/GpuTextureBuffer.hpp"
 #include "../Interface/GpuResource/GpuSampler.hpp"
 #include "../Interface/GpuResource/GpuTexture.hpp"
+#include "../Interface/GpuResource/GpuBufferView.hpp"
 #include "../Interface/GpuResource/GpuBuffer.hpp"
 
 #include "../Interface/GpuPipelineState/GpuPipelineFactory.hpp"
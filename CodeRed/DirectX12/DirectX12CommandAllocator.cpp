@@ -25,5 +25,35 @@ CodeRed::DirectX12CommandAllocator::DirectX12CommandAllocator(
 void CodeRed::DirectX12CommandAllocator::reset()
 {
 	mCommandAllocator->Reset();
+
+	// the commands recorded with this allocator are finished, so the heaps are not used
+	mDescriptorHeaps.clear();
+}
+
+auto CodeRed::DirectX12CommandAllocator::allocateDescriptorHeap(
+	const D3D12_DESCRIPTOR_HEAP_TYPE type,
+	const size_t count)
+	-> WRL::ComPtr<ID3D12DescriptorHeap>
+{
+	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get())->device();
+
+	D3D12_DESCRIPTOR_HEAP_DESC desc = {};
+
+	desc.Type = type;
+	desc.NumDescriptors = static_cast<UINT>(count);
+	desc.Flags = type == D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV ?
+		D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE : D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+	desc.NodeMask = 0;
+
+	WRL::ComPtr<ID3D12DescriptorHeap> heap;
+
+	CODE_RED_THROW_IF_FAILED(
+		dxDevice->CreateDescriptorHeap(&desc, IID_PPV_ARGS(&heap)),
+		FailedException(DebugType::Create, { "ID3D12DescriptorHeap" })
+	);
+
+	mDescriptorHeaps.push_back(heap);
+
+	return heap;
 }
 #endif
@@ -7,6 +7,8 @@
 
 #ifdef __ENABLE__DIRECTX12__
 
+#include <vector>
+
 namespace CodeRed {
 
 	class GpuTexture;
@@ -20,10 +22,22 @@ namespace CodeRed {
 		~DirectX12CommandAllocator() = default;
 
 		void reset() override;
+
+		/*
+		 * allocate a descriptor heap that is alive until we reset the allocator
+		 * it is used by the commands that need descriptors internally, for example generateMipmaps
+		 * the heap of D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV is shader visible
+		 */
+		auto allocateDescriptorHeap(
+			const D3D12_DESCRIPTOR_HEAP_TYPE type,
+			const size_t count)
+			-> WRL::ComPtr<ID3D12DescriptorHeap>;
 		
 		auto allocator() const noexcept -> WRL::ComPtr<ID3D12CommandAllocator> { return mCommandAllocator; }
 	private:
 		WRL::ComPtr<ID3D12CommandAllocator> mCommandAllocator;
+
+		std::vector<WRL::ComPtr<ID3D12DescriptorHeap>> mDescriptorHeaps;
 	};
 	
 }
@@ -32,6 +32,26 @@ CodeRed::DirectX12CommandQueue::DirectX12CommandQueue(
 
 void CodeRed::DirectX12CommandQueue::execute(
 	const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists)
+{
+	submit(lists, nullptr, 0);
+
+	mDevice->releaseDeferredObjects();
+}
+
+void CodeRed::DirectX12CommandQueue::execute(
+	const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists,
+	const std::shared_ptr<GpuFence>& fence,
+	const size_t value)
+{
+	submit(lists, fence, value);
+
+	mDevice->releaseDeferredObjects();
+}
+
+void CodeRed::DirectX12CommandQueue::submit(
+	const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists,
+	const std::shared_ptr<GpuFence>& fence,
+	const size_t value)
 {
 	CODE_RED_DEBUG_WARNING_IF(
 		lists.empty(),
@@ -46,8 +66,30 @@ void CodeRed::DirectX12CommandQueue::execute(
 		);
 	}
 
+	// the submission values should be signaled in order, so the threads submit to the queue with this lock
+	std::lock_guard<std::mutex> lock(mMutex);
+	
 	mCommandQueue->ExecuteCommandLists(
 		static_cast<UINT>(dxLists.size()), dxLists.data());
+
+	if (fence != nullptr) {
+		CODE_RED_THROW_IF_FAILED(
+			mCommandQueue->Signal(
+				static_cast<DirectX12Fence*>(fence.get())->fence().Get(),
+				static_cast<UINT64>(value)),
+			FailedException(DebugType::Set, { "value", "ID3D12Fence" })
+		);
+	}
+
+	// the submission fence is used by deferred destruction
+	CODE_RED_THROW_IF_FAILED(
+		mCommandQueue->Signal(
+			static_cast<DirectX12Fence*>(mSubmissionFence.get())->fence().Get(),
+			static_cast<UINT64>(mSubmissionValue + 1)),
+		FailedException(DebugType::Set, { "value", "ID3D12Fence" })
+	);
+
+	mSubmissionValue++;
 }
 
 void CodeRed::DirectX12CommandQueue::waitIdle()
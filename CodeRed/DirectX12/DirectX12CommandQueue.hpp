@@ -5,6 +5,8 @@
 
 #ifdef __ENABLE__DIRECTX12__
 
+#include <mutex>
+
 namespace CodeRed {
 
 	class DirectX12CommandQueue final : public GpuCommandQueue {
@@ -16,11 +18,25 @@ namespace CodeRed {
 
 		void execute(const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists) override;
 
+		void execute(
+			const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists,
+			const std::shared_ptr<GpuFence>& fence,
+			const size_t value) override;
+
 		void waitIdle() override;
 		
 		auto queue() const noexcept -> WRL::ComPtr<ID3D12CommandQueue> { return mCommandQueue; }
+	private:
+		// submit the lists and signal the fence(if it is not null) and submission fence
+		void submit(
+			const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists,
+			const std::shared_ptr<GpuFence>& fence,
+			const size_t value);
 	private:
 		WRL::ComPtr<ID3D12CommandQueue> mCommandQueue;
+
+		// the threads execute, signal and increase the submission value with this lock
+		std::mutex mMutex;
 	};
 	
 }
@@ -0,0 +1,47 @@
+#include "../Shared/Hash.hpp"
+
+#include "DirectX12PipelineState/DirectX12ShaderState.hpp"
+
+#include "DirectX12ComputePipeline.hpp"
+#include "DirectX12ResourceLayout.hpp"
+#include "DirectX12LogicalDevice.hpp"
+
+#ifdef __ENABLE__DIRECTX12__
+
+using namespace CodeRed::DirectX12;
+
+CodeRed::DirectX12ComputePipeline::DirectX12ComputePipeline(
+	const std::shared_ptr<GpuLogicalDevice>& device,
+	const std::shared_ptr<GpuResourceLayout>& resource_layout,
+	const std::shared_ptr<GpuShaderState>& compute_shader_state) :
+	GpuComputePipeline(
+		device,
+		resource_layout,
+		compute_shader_state
+	)
+{
+	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get());
+	const auto dxResourceLayout = static_cast<DirectX12ResourceLayout*>(mResourceLayout.get());
+
+	D3D12_COMPUTE_PIPELINE_STATE_DESC desc = {};
+
+	desc.pRootSignature = dxResourceLayout->rootSignature().Get();
+	desc.CS = static_cast<DirectX12ShaderState*>(mComputeShaderState.get())->shader();
+	desc.NodeMask = 0;
+	desc.Flags = D3D12_PIPELINE_STATE_FLAG_NONE;
+
+	//the key of pipeline in pipeline library, it is the hash of root signature and shader code
+	auto key = Hash::value(dxResourceLayout->rootSignatureHash());
+
+	key = Hash::value(desc.CS.BytecodeLength, key);
+	key = Hash::bytes(desc.CS.pShaderBytecode, desc.CS.BytecodeLength, key);
+	
+	mComputePipeline = dxDevice->createComputePipelineState(desc, key);
+}
+
+CodeRed::DirectX12ComputePipeline::~DirectX12ComputePipeline()
+{
+	mDevice->deferDestruction([pipeline = mComputePipeline]() mutable { pipeline.Reset(); });
+}
+
+#endif
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../Interface/GpuComputePipeline.hpp"
+#include "DirectX12Utility.hpp"
+
+#ifdef __ENABLE__DIRECTX12__
+
+namespace CodeRed {
+
+	class DirectX12ComputePipeline final : public GpuComputePipeline {
+	public:
+		explicit DirectX12ComputePipeline(
+			const std::shared_ptr<GpuLogicalDevice>& device,
+			const std::shared_ptr<GpuResourceLayout>& resource_layout,
+			const std::shared_ptr<GpuShaderState>& compute_shader_state);
+
+		~DirectX12ComputePipeline();
+
+		auto pipeline() const noexcept -> WRL::ComPtr<ID3D12PipelineState> { return mComputePipeline; }
+	private:
+		WRL::ComPtr<ID3D12PipelineState> mComputePipeline;
+	};
+	
+}
+
+#endif
@@ -1,5 +1,6 @@
 #include "../Shared/Exception/InvalidException.hpp"
 #include "../Shared/Exception/FailedException.hpp"
+#include "../Shared/Exception/ZeroException.hpp"
 
 #include "DirectX12Resource/DirectX12Texture.hpp"
 #include "DirectX12Resource/DirectX12Buffer.hpp"
@@ -37,6 +38,12 @@ CodeRed::DirectX12DescriptorHeap::DirectX12DescriptorHeap(
 	mDescriptorSize = dxDevice->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
 }
 
+CodeRed::DirectX12DescriptorHeap::~DirectX12DescriptorHeap()
+{
+	// the heap may be set by the submissions in flight
+	mDevice->deferDestruction([heap = mDescriptorHeap]() mutable { heap.Reset(); });
+}
+
 void CodeRed::DirectX12DescriptorHeap::bindTexture(
 	const std::shared_ptr<GpuTextureRef>& texture, 
 	const size_t index)
@@ -71,7 +78,7 @@ void CodeRed::DirectX12DescriptorHeap::bindTexture(
 }
 
 void CodeRed::DirectX12DescriptorHeap::bindBuffer(
-	const std::shared_ptr<GpuBuffer>& buffer,
+	const GpuBufferView& view,
 	const size_t index)
 {
 	CODE_RED_DEBUG_THROW_IF(
@@ -80,13 +87,18 @@ void CodeRed::DirectX12DescriptorHeap::bindBuffer(
 	);
 
 	CODE_RED_DEBUG_THROW_IF(
-		mResourceLayout->mElements[index].Type != buffer->type() ||
+		mResourceLayout->mElements[index].Type != view.Buffer->type() ||
 		mResourceLayout->mElements[index].Type == ResourceType::Texture,
 		InvalidException<ResourceType>({ "element(index).Type" })
 	);
 
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset + view.Size > view.Buffer->size(),
+		InvalidException<GpuBufferView>({ "view" }, { "the range of view is out of the buffer." })
+	);
+
 	const auto dxDevice = std::static_pointer_cast<DirectX12LogicalDevice>(mDevice)->device();
-	const auto dxBuffer = std::static_pointer_cast<DirectX12Buffer>(buffer);
+	const auto dxBuffer = std::static_pointer_cast<DirectX12Buffer>(view.Buffer);
 
 	const D3D12_CPU_DESCRIPTOR_HANDLE cpuHandle = {
 		mDescriptorHeap->GetCPUDescriptorHandleForHeapStart().ptr +
@@ -98,8 +110,8 @@ void CodeRed::DirectX12DescriptorHeap::bindBuffer(
 	case ResourceType::Buffer:
 		{
 			D3D12_CONSTANT_BUFFER_VIEW_DESC bufferView = {
-				dxBuffer->buffer()->GetGPUVirtualAddress(),
-				static_cast<UINT>(dxBuffer->size())
+				dxBuffer->buffer()->GetGPUVirtualAddress() + view.Offset,
+				static_cast<UINT>(view.Size)
 			};
 
 			dxDevice->CreateConstantBufferView(&bufferView, cpuHandle);
@@ -108,15 +120,50 @@ void CodeRed::DirectX12DescriptorHeap::bindBuffer(
 		}
 	case ResourceType::GroupBuffer:
 		{
+			CODE_RED_DEBUG_THROW_IF(
+				view.Stride == 0,
+				ZeroException<size_t>({ "view.Stride" })
+			);
+
+			// the view of group buffer starts at an element, so the offset should be multiple of stride
+			CODE_RED_DEBUG_THROW_IF(
+				view.Offset % view.Stride != 0,
+				InvalidException<GpuBufferView>({ "view" },
+					{ "the offset of view is not multiple of stride." })
+			);
+			
+			if (mResourceLayout->mElements[index].ReadWrite) {
+				//the unordered access view can not be created for the buffer in upload or readback heap
+				CODE_RED_DEBUG_THROW_IF(
+					dxBuffer->heap() != MemoryHeap::Default,
+					InvalidException<MemoryHeap>({ "view.Buffer->heap()" },
+						{ "the read-write group buffer must be in default heap." })
+				);
+				
+				D3D12_UNORDERED_ACCESS_VIEW_DESC accessView = {};
+
+				accessView.Format = DXGI_FORMAT_UNKNOWN;
+				accessView.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
+				accessView.Buffer.FirstElement = static_cast<UINT64>(view.Offset / view.Stride);
+				accessView.Buffer.NumElements = static_cast<UINT>(view.Size / view.Stride);
+				accessView.Buffer.StructureByteStride = static_cast<UINT>(view.Stride);
+				accessView.Buffer.CounterOffsetInBytes = 0;
+				accessView.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_NONE;
+
+				dxDevice->CreateUnorderedAccessView(dxBuffer->buffer().Get(), nullptr, &accessView, cpuHandle);
+
+				break;
+			}
+			
 			D3D12_SHADER_RESOURCE_VIEW_DESC resourceView = {};
 
 			resourceView.Format = DXGI_FORMAT_UNKNOWN;
 			resourceView.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
 			resourceView.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-			resourceView.Buffer.FirstElement = 0;
-			resourceView.Buffer.NumElements = static_cast<UINT>(dxBuffer->count());
+			resourceView.Buffer.FirstElement = static_cast<UINT64>(view.Offset / view.Stride);
+			resourceView.Buffer.NumElements = static_cast<UINT>(view.Size / view.Stride);
 			resourceView.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
-			resourceView.Buffer.StructureByteStride = static_cast<UINT>(dxBuffer->stride());
+			resourceView.Buffer.StructureByteStride = static_cast<UINT>(view.Stride);
 
 			dxDevice->CreateShaderResourceView(dxBuffer->buffer().Get(), &resourceView, cpuHandle);
 
@@ -128,4 +175,5 @@ void CodeRed::DirectX12DescriptorHeap::bindBuffer(
 	}
 	
 }
+
 #endif
@@ -13,7 +13,7 @@ namespace CodeRed {
 			const std::shared_ptr<GpuLogicalDevice>& device,
 			const std::shared_ptr<GpuResourceLayout>& resource_layout);
 
-		~DirectX12DescriptorHeap() = default;
+		~DirectX12DescriptorHeap();
 
 		void bindTexture(
 			const std::shared_ptr<GpuTextureRef>& texture, 
@@ -24,7 +24,7 @@ namespace CodeRed {
 			const size_t index) override;
 
 		void bindBuffer(
-			const std::shared_ptr<GpuBuffer>& buffer, 
+			const GpuBufferView& view,
 			const size_t index) override;
 
 		auto heap() const noexcept -> WRL::ComPtr<ID3D12DescriptorHeap> { return mDescriptorHeap; }
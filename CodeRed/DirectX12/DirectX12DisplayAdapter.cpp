@@ -8,8 +8,9 @@ CodeRed::DirectX12DisplayAdapter::DirectX12DisplayAdapter(
 	const WRL::ComPtr<IDXGIAdapter1> &adapter,
 	const std::string &name,
 	const size_t device_id,
-	const size_t vendor_id) :
-	GpuDisplayAdapter(name, device_id, vendor_id),
+	const size_t vendor_id,
+	const size_t driver_version) :
+	GpuDisplayAdapter(name, device_id, vendor_id, driver_version),
 	mAdapter(adapter)
 {
 	
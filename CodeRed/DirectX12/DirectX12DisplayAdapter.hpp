@@ -13,7 +13,8 @@ namespace CodeRed {
 			const WRL::ComPtr<IDXGIAdapter1> &dxgi_adapter,
 			const std::string &name,
 			const size_t device_id,
-			const size_t vendor_id);
+			const size_t vendor_id,
+			const size_t driver_version);
 
 		~DirectX12DisplayAdapter() = default;
 
@@ -21,21 +21,54 @@ CodeRed::DirectX12Fence::DirectX12Fence(
 	);
 }
 
-void CodeRed::DirectX12Fence::wait(const WRL::ComPtr<ID3D12CommandQueue>& queue)
+void CodeRed::DirectX12Fence::signal(
+	const std::shared_ptr<GpuCommandQueue>& queue,
+	const size_t value)
+{
+	const auto dxQueue = static_cast<DirectX12CommandQueue*>(queue.get())->queue();
+
+	CODE_RED_THROW_IF_FAILED(
+		dxQueue->Signal(mFence.Get(), static_cast<UINT64>(value)),
+		FailedException(DebugType::Set, { "value", "ID3D12Fence" })
+	);
+}
+
+auto CodeRed::DirectX12Fence::wait(
+	const size_t value,
+	const size_t timeout)
+	-> bool
 {
-	queue->Signal(mFence.Get(), ++mFenceValue);;
+	if (mFence->GetCompletedValue() >= static_cast<UINT64>(value)) return true;
+	if (timeout == 0) return false;
 
-	if (mFence->GetCompletedValue() < mFenceValue) {
-		const auto event_handle = CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS);
+	const auto event_handle = CreateEventEx(nullptr, nullptr, false, EVENT_ALL_ACCESS);
 
-		mFence->SetEventOnCompletion(mFenceValue, event_handle);
+	if (event_handle == nullptr) {
+		DebugReport::warning(DebugType::Create, { "wait event" });
 
-		if (event_handle != nullptr) {
-			WaitForSingleObject(event_handle, INFINITE);
-			CloseHandle(event_handle);
-		}
-		else DebugReport::warning(DebugType::Create, { "wait event" });
+		return false;
 	}
+
+	mFence->SetEventOnCompletion(static_cast<UINT64>(value), event_handle);
+
+	const auto result = WaitForSingleObject(event_handle,
+		timeout >= static_cast<size_t>(INFINITE) ? INFINITE : static_cast<DWORD>(timeout));
+
+	CloseHandle(event_handle);
+
+	return result == WAIT_OBJECT_0;
+}
+
+auto CodeRed::DirectX12Fence::completedValue() -> size_t
+{
+	return static_cast<size_t>(mFence->GetCompletedValue());
+}
+
+void CodeRed::DirectX12Fence::wait(const WRL::ComPtr<ID3D12CommandQueue>& queue)
+{
+	queue->Signal(mFence.Get(), ++mFenceValue);
+
+	wait(static_cast<size_t>(mFenceValue));
 }
 
 #endif
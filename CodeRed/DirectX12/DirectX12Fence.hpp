@@ -14,6 +14,17 @@ namespace CodeRed {
 
 		~DirectX12Fence() = default;
 
+		void signal(
+			const std::shared_ptr<GpuCommandQueue>& queue,
+			const size_t value) override;
+
+		auto wait(
+			const size_t value,
+			const size_t timeout = SIZE_MAX)
+			-> bool override;
+
+		auto completedValue() -> size_t override;
+		
 		auto fence() const noexcept -> WRL::ComPtr<ID3D12Fence> { return mFence; }
 	private:
 		void wait(const WRL::ComPtr<ID3D12CommandQueue>& queue);
@@ -26,4 +37,4 @@ namespace CodeRed {
 	};	
 }
 
-#endif
\ No newline at end of file
+#endif
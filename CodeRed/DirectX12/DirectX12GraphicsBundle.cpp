@@ -0,0 +1,219 @@
+#include "../Shared/Exception/FailedException.hpp"
+#include "../Shared/Exception/ZeroException.hpp"
+#include "../Shared/DebugReport.hpp"
+
+#include "DirectX12Resource/DirectX12Buffer.hpp"
+
+#include "DirectX12GraphicsPipeline.hpp"
+#include "DirectX12GraphicsBundle.hpp"
+#include "DirectX12ResourceLayout.hpp"
+#include "DirectX12DescriptorHeap.hpp"
+#include "DirectX12LogicalDevice.hpp"
+
+#undef min
+
+#ifdef __ENABLE__DIRECTX12__
+
+using namespace CodeRed::DirectX12;
+
+CodeRed::DirectX12GraphicsBundle::DirectX12GraphicsBundle(
+	const std::shared_ptr<GpuLogicalDevice>& device) :
+	GpuGraphicsBundle(device)
+{
+	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get())->device();
+
+	CODE_RED_THROW_IF_FAILED(
+		dxDevice->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_BUNDLE, IID_PPV_ARGS(&mCommandAllocator)),
+		FailedException(DebugType::Create, { "ID3D12CommandAllocator" })
+	);
+	
+	CODE_RED_THROW_IF_FAILED(
+		dxDevice->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_BUNDLE,
+			mCommandAllocator.Get(), nullptr, IID_PPV_ARGS(&mGraphicsCommandList)),
+		FailedException(DebugType::Create, { "ID3D12GraphicsCommandList" })
+	);
+
+	mGraphicsCommandList->Close();
+}
+
+void CodeRed::DirectX12GraphicsBundle::beginRecording(
+	const std::shared_ptr<GpuRenderPass>& render_pass)
+{
+	// the bundle of DirectX12 does not need render pass, the render targets are inherited
+	mCommandAllocator->Reset();
+	mGraphicsCommandList->Reset(mCommandAllocator.Get(), nullptr);
+
+	mResourceLayout.reset();
+}
+
+void CodeRed::DirectX12GraphicsBundle::endRecording()
+{
+	mGraphicsCommandList->Close();
+}
+
+void CodeRed::DirectX12GraphicsBundle::setGraphicsPipeline(
+	const std::shared_ptr<GpuGraphicsPipeline>& pipeline)
+{
+	mGraphicsCommandList->SetPipelineState(
+		static_cast<DirectX12GraphicsPipeline*>(pipeline.get())->pipeline().Get()
+	);
+
+	mGraphicsCommandList->IASetPrimitiveTopology(
+		enumConvert(pipeline->inputAssembly()->primitiveTopology()));
+}
+
+void CodeRed::DirectX12GraphicsBundle::setResourceLayout(
+	const std::shared_ptr<GpuResourceLayout>& layout)
+{
+	const auto dxLayout = std::static_pointer_cast<DirectX12ResourceLayout>(layout);
+
+	mGraphicsCommandList->SetGraphicsRootSignature(
+		dxLayout->rootSignature().Get()
+	);
+
+	mResourceLayout = dxLayout;
+}
+
+void CodeRed::DirectX12GraphicsBundle::setVertexBuffer(const GpuBufferView& view)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset + view.Size > view.Buffer->size(),
+		InvalidException<GpuBufferView>({ "view" }, { "the range of view is out of the buffer." })
+	);
+	
+	D3D12_VERTEX_BUFFER_VIEW vertexView = {
+		static_cast<DirectX12Buffer*>(view.Buffer.get())->buffer()->GetGPUVirtualAddress() + view.Offset,
+		static_cast<UINT>(view.Size),
+		static_cast<UINT>(view.Stride)
+	};
+
+	mGraphicsCommandList->IASetVertexBuffers(0, 1, &vertexView);
+}
+
+void CodeRed::DirectX12GraphicsBundle::setVertexBuffers(
+	const std::vector<GpuBufferView>& views,
+	const size_t startSlot)
+{
+	auto vertexViews = std::vector<D3D12_VERTEX_BUFFER_VIEW>(views.size());
+
+	for (size_t index = 0; index < vertexViews.size(); index++) {
+		const auto& buffer = std::static_pointer_cast<DirectX12Buffer>(views[index].Buffer);
+
+		vertexViews[index].BufferLocation = buffer->buffer()->GetGPUVirtualAddress() + views[index].Offset;
+		vertexViews[index].StrideInBytes = static_cast<UINT>(views[index].Stride);
+		vertexViews[index].SizeInBytes = static_cast<UINT>(views[index].Size);
+	}
+
+	mGraphicsCommandList->IASetVertexBuffers(
+		static_cast<UINT>(startSlot),
+		static_cast<UINT>(vertexViews.size()),
+		vertexViews.data());
+}
+
+void CodeRed::DirectX12GraphicsBundle::setIndexBuffer(
+	const GpuBufferView& view,
+	const IndexType type)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset + view.Size > view.Buffer->size(),
+		InvalidException<GpuBufferView>({ "view" }, { "the range of view is out of the buffer." })
+	);
+	
+	D3D12_INDEX_BUFFER_VIEW indexView = {
+		static_cast<DirectX12Buffer*>(view.Buffer.get())->buffer()->GetGPUVirtualAddress() + view.Offset,
+		static_cast<UINT>(view.Size),
+		enumConvert(type)
+	};
+
+	mGraphicsCommandList->IASetIndexBuffer(&indexView);
+}
+
+void CodeRed::DirectX12GraphicsBundle::setDescriptorHeap(
+	const std::shared_ptr<GpuDescriptorHeap>& heap)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		heap->layout() != mResourceLayout,
+		FailedException(DebugType::Set,
+			{ "GpuDescriptorHeap", "Graphics Bundle" },
+			{ "current resource layout is not the one that create the heap." });
+	);
+
+	const auto dxHeap = std::static_pointer_cast<DirectX12DescriptorHeap>(heap)->heap();
+
+	// the heap should be same as the heap set in the command list that executes the bundle
+	mGraphicsCommandList->SetDescriptorHeaps(1, dxHeap.GetAddressOf());
+
+	CODE_RED_TRY_EXECUTE(
+		heap->count() != 0,
+		mGraphicsCommandList->SetGraphicsRootDescriptorTable(
+			static_cast<UINT>(mResourceLayout->elementsIndex()),
+			dxHeap->GetGPUDescriptorHandleForHeapStart())
+	);
+}
+
+void CodeRed::DirectX12GraphicsBundle::setConstant32Bits(
+	const std::vector<Value32Bit>& values)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mResourceLayout == nullptr,
+		FailedException(DebugType::Set,
+			{ "Constant32Bits", "Graphics Bundle" },
+			{ "please set the resource layout, before set constant32Bits." })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		mResourceLayout->constant32Bits().has_value() == false,
+		FailedException(DebugType::Set,
+			{ "Constant32Bits", "Graphics Bundle" },
+			{ "please enable the Constant32Bits in GpuResourceLayout." })
+	);
+
+	mGraphicsCommandList->SetGraphicsRoot32BitConstants(
+		static_cast<UINT>(mResourceLayout->constant32BitsIndex()),
+		static_cast<UINT>(std::min(values.size(), mResourceLayout->constant32Bits()->Count)),
+		values.data(),
+		0
+	);
+}
+
+void CodeRed::DirectX12GraphicsBundle::setViewPort(const ViewPort& view_port)
+{
+	// the bundle can not set view port, it is inherited from the command list
+}
+
+void CodeRed::DirectX12GraphicsBundle::setScissorRect(const ScissorRect& rect)
+{
+	// the bundle can not set scissor rect, it is inherited from the command list
+}
+
+void CodeRed::DirectX12GraphicsBundle::draw(
+	const size_t vertex_count,
+	const size_t instance_count,
+	const size_t start_vertex_location,
+	const size_t start_instance_location)
+{
+	mGraphicsCommandList->DrawInstanced(
+		static_cast<UINT>(vertex_count),
+		static_cast<UINT>(instance_count),
+		static_cast<UINT>(start_vertex_location),
+		static_cast<UINT>(start_instance_location)
+	);
+}
+
+void CodeRed::DirectX12GraphicsBundle::drawIndexed(
+	const size_t index_count,
+	const size_t instance_count,
+	const size_t start_index_location,
+	const size_t base_vertex_location,
+	const size_t start_instance_location)
+{
+	mGraphicsCommandList->DrawIndexedInstanced(
+		static_cast<UINT>(index_count),
+		static_cast<UINT>(instance_count),
+		static_cast<UINT>(start_index_location),
+		static_cast<UINT>(base_vertex_location),
+		static_cast<UINT>(start_instance_location)
+	);
+}
+
+#endif
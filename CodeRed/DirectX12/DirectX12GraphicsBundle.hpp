@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../Interface/GpuGraphicsBundle.hpp"
+#include "DirectX12Utility.hpp"
+
+#ifdef __ENABLE__DIRECTX12__
+
+namespace CodeRed {
+
+	class DirectX12ResourceLayout;
+
+	/*
+	 * DirectX12GraphicsBundle is a bundle command list with its own bundle allocator
+	 * the view port and scissor rect are inherited from the command list that executes it.
+	 */
+	class DirectX12GraphicsBundle final : public GpuGraphicsBundle {
+	public:
+		explicit DirectX12GraphicsBundle(
+			const std::shared_ptr<GpuLogicalDevice>& device);
+
+		~DirectX12GraphicsBundle() = default;
+
+		void beginRecording(
+			const std::shared_ptr<GpuRenderPass>& render_pass) override;
+
+		void endRecording() override;
+
+		void setGraphicsPipeline(
+			const std::shared_ptr<GpuGraphicsPipeline>& pipeline) override;
+
+		void setResourceLayout(
+			const std::shared_ptr<GpuResourceLayout>& layout) override;
+
+		void setVertexBuffer(
+			const GpuBufferView& view) override;
+
+		void setVertexBuffers(
+			const std::vector<GpuBufferView>& views,
+			const size_t startSlot = 0) override;
+
+		void setIndexBuffer(
+			const GpuBufferView& view,
+			const IndexType type = IndexType::UInt32) override;
+
+		void setDescriptorHeap(
+			const std::shared_ptr<GpuDescriptorHeap>& heap) override;
+
+		void setConstant32Bits(
+			const std::vector<Value32Bit>& values) override;
+
+		void setViewPort(
+			const ViewPort& view_port) override;
+
+		void setScissorRect(
+			const ScissorRect& rect) override;
+
+		void draw(
+			const size_t vertex_count,
+			const size_t instance_count = 1,
+			const size_t start_vertex_location = 0,
+			const size_t start_instance_location = 0) override;
+
+		void drawIndexed(
+			const size_t index_count,
+			const size_t instance_count,
+			const size_t start_index_location,
+			const size_t base_vertex_location,
+			const size_t start_instance_location) override;
+
+		auto commandList() const noexcept -> WRL::ComPtr<ID3D12GraphicsCommandList> { return mGraphicsCommandList; }
+	private:
+		WRL::ComPtr<ID3D12CommandAllocator> mCommandAllocator;
+		WRL::ComPtr<ID3D12GraphicsCommandList> mGraphicsCommandList;
+
+		std::shared_ptr<DirectX12ResourceLayout> mResourceLayout;
+	};
+	
+}
+
+#endif
@@ -1,3 +1,4 @@
+#include "../Shared/Exception/NotSupportException.hpp"
 #include "../Shared/Exception/FailedException.hpp"
 #include "../Shared/Exception/ZeroException.hpp"
 
@@ -6,7 +7,10 @@
 #include "DirectX12Resource/DirectX12Buffer.hpp"
 #include "DirectX12GraphicsCommandList.hpp"
 #include "DirectX12GraphicsPipeline.hpp"
+#include "DirectX12ComputePipeline.hpp"
+#include "DirectX12GraphicsBundle.hpp"
 #include "DirectX12CommandAllocator.hpp"
+#include "DirectX12TextureBlitter.hpp"
 #include "DirectX12ResourceLayout.hpp"
 #include "DirectX12DescriptorHeap.hpp"
 #include "DirectX12LogicalDevice.hpp"
@@ -16,7 +20,10 @@
 
 #include "../Shared/DebugReport.hpp"
 
+#include <algorithm>
+
 #undef min
+#undef max
 
 #ifdef __ENABLE__DIRECTX12__
 
@@ -48,6 +55,7 @@ void CodeRed::DirectX12GraphicsCommandList::beginRecording()
 	mGraphicsCommandList->ClearState(nullptr);
 
 	mResourceLayout.reset();
+	mGraphicsPipeline.reset();
 }
 
 void CodeRed::DirectX12GraphicsCommandList::endRecording()
@@ -164,6 +172,16 @@ void CodeRed::DirectX12GraphicsCommandList::setGraphicsPipeline(
 
 	mGraphicsCommandList->IASetPrimitiveTopology(
 		enumConvert(pipeline->inputAssembly()->primitiveTopology()));
+
+	mGraphicsPipeline = pipeline;
+}
+
+void CodeRed::DirectX12GraphicsCommandList::setComputePipeline(
+	const std::shared_ptr<GpuComputePipeline>& pipeline)
+{
+	mGraphicsCommandList->SetPipelineState(
+		static_cast<DirectX12ComputePipeline*>(pipeline.get())->pipeline().Get()
+	);
 }
 
 void CodeRed::DirectX12GraphicsCommandList::setResourceLayout(const std::shared_ptr<GpuResourceLayout>& layout)
@@ -174,51 +192,84 @@ void CodeRed::DirectX12GraphicsCommandList::setResourceLayout(const std::shared_
 		dxLayout->rootSignature().Get()
 	);
 
+	mGraphicsCommandList->SetComputeRootSignature(
+		dxLayout->rootSignature().Get()
+	);
+
 	mResourceLayout = dxLayout;
 }
 
-void CodeRed::DirectX12GraphicsCommandList::setVertexBuffer(const std::shared_ptr<GpuBuffer>& buffer)
+void CodeRed::DirectX12GraphicsCommandList::setVertexBuffer(const GpuBufferView& view)
 {
-	D3D12_VERTEX_BUFFER_VIEW view = {
-		static_cast<DirectX12Buffer*>(buffer.get())->buffer()->GetGPUVirtualAddress(),
-		static_cast<UINT>(buffer->size()),
-		static_cast<UINT>(buffer->stride())
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset + view.Size > view.Buffer->size(),
+		InvalidException<GpuBufferView>({ "view" }, { "the range of view is out of the buffer." })
+	);
+
+	// the stride of vertex buffer comes from the view in DirectX12 and the input assembly state in Vulkan
+	// so they should be same, otherwise the two backends read different vertices
+	CODE_RED_DEBUG_THROW_IF(
+		mGraphicsPipeline != nullptr && mGraphicsPipeline->inputAssembly()->slot() > 0 &&
+		view.Stride != mGraphicsPipeline->inputAssembly()->stride(0),
+		InvalidException<GpuBufferView>({ "view" }, { "the stride of view is not same as the stride of slot in input assembly state." })
+	);
+	
+	D3D12_VERTEX_BUFFER_VIEW vertexView = {
+		static_cast<DirectX12Buffer*>(view.Buffer.get())->buffer()->GetGPUVirtualAddress() + view.Offset,
+		static_cast<UINT>(view.Size),
+		static_cast<UINT>(view.Stride)
 	};
 	
-	mGraphicsCommandList->IASetVertexBuffers(0, 1, &view);
+	mGraphicsCommandList->IASetVertexBuffers(0, 1, &vertexView);
 }
 
 void CodeRed::DirectX12GraphicsCommandList::setVertexBuffers(
-	const std::vector<std::shared_ptr<GpuBuffer>>& buffers,
+	const std::vector<GpuBufferView>& views,
 	const size_t startSlot)
 {
-	auto views = std::vector<D3D12_VERTEX_BUFFER_VIEW>(buffers.size());
+	auto vertexViews = std::vector<D3D12_VERTEX_BUFFER_VIEW>(views.size());
 
-	for (size_t index = 0; index < views.size(); index++) {
-		const auto& buffer = std::static_pointer_cast<DirectX12Buffer>(buffers[index]);
+	for (size_t index = 0; index < vertexViews.size(); index++) {
+		const auto& buffer = std::static_pointer_cast<DirectX12Buffer>(views[index].Buffer);
+
+		CODE_RED_DEBUG_THROW_IF(
+			mGraphicsPipeline != nullptr && startSlot + index < mGraphicsPipeline->inputAssembly()->slot() &&
+			views[index].Stride != mGraphicsPipeline->inputAssembly()->stride(startSlot + index),
+			InvalidException<GpuBufferView>({ "views" }, { "the stride of view is not same as the stride of slot in input assembly state." })
+		);
 
-		views[index].BufferLocation = buffer->buffer()->GetGPUVirtualAddress();
-		views[index].StrideInBytes = static_cast<UINT>(buffer->stride());
-		views[index].SizeInBytes = static_cast<UINT>(buffer->size());
+		vertexViews[index].BufferLocation = buffer->buffer()->GetGPUVirtualAddress() + views[index].Offset;
+		vertexViews[index].StrideInBytes = static_cast<UINT>(views[index].Stride);
+		vertexViews[index].SizeInBytes = static_cast<UINT>(views[index].Size);
 	}
 
 	mGraphicsCommandList->IASetVertexBuffers(
 		static_cast<UINT>(startSlot),
-		static_cast<UINT>(views.size()),
-		views.data());
+		static_cast<UINT>(vertexViews.size()),
+		vertexViews.data());
 }
 
 void CodeRed::DirectX12GraphicsCommandList::setIndexBuffer(
-	const std::shared_ptr<GpuBuffer>& buffer,
+	const GpuBufferView& view,
 	const IndexType type)
 {
-	D3D12_INDEX_BUFFER_VIEW view = {
-		static_cast<DirectX12Buffer*>(buffer.get())->buffer()->GetGPUVirtualAddress(),
-		static_cast<UINT>(buffer->size()),
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset + view.Size > view.Buffer->size(),
+		InvalidException<GpuBufferView>({ "view" }, { "the range of view is out of the buffer." })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset % (type == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t)) != 0,
+		InvalidException<GpuBufferView>({ "view" }, { "the offset of view should be multiple of the size of index." })
+	);
+	
+	D3D12_INDEX_BUFFER_VIEW indexView = {
+		static_cast<DirectX12Buffer*>(view.Buffer.get())->buffer()->GetGPUVirtualAddress() + view.Offset,
+		static_cast<UINT>(view.Size),
 		enumConvert(type)
 	};
 	
-	mGraphicsCommandList->IASetIndexBuffer(&view);
+	mGraphicsCommandList->IASetIndexBuffer(&indexView);
 }
 
 void CodeRed::DirectX12GraphicsCommandList::setDescriptorHeap(
@@ -235,12 +286,15 @@ void CodeRed::DirectX12GraphicsCommandList::setDescriptorHeap(
 	
 	mGraphicsCommandList->SetDescriptorHeaps(1, dxHeap.GetAddressOf());
 
-	CODE_RED_TRY_EXECUTE(
-		heap->count() != 0,
-		mGraphicsCommandList->SetGraphicsRootDescriptorTable(
-			static_cast<UINT>(mResourceLayout->elementsIndex()),
-			dxHeap->GetGPUDescriptorHandleForHeapStart())
-	);
+	if (heap->count() == 0) return;
+
+	// the descriptor table is bound to both of graphics and compute pipeline
+	mGraphicsCommandList->SetGraphicsRootDescriptorTable(
+		static_cast<UINT>(mResourceLayout->elementsIndex()),
+		dxHeap->GetGPUDescriptorHandleForHeapStart());
+	mGraphicsCommandList->SetComputeRootDescriptorTable(
+		static_cast<UINT>(mResourceLayout->elementsIndex()),
+		dxHeap->GetGPUDescriptorHandleForHeapStart());
 }
 
 void CodeRed::DirectX12GraphicsCommandList::setConstant32Bits(
@@ -276,6 +330,13 @@ void CodeRed::DirectX12GraphicsCommandList::setConstant32Bits(
 		values.data(),
 		0
 	);
+
+	mGraphicsCommandList->SetComputeRoot32BitConstants(
+		static_cast<UINT>(mResourceLayout->constant32BitsIndex()),
+		static_cast<UINT>(std::min(values.size(), mResourceLayout->constant32Bits()->Count)),
+		values.data(),
+		0
+	);
 }
 
 void CodeRed::DirectX12GraphicsCommandList::setViewPort(const ViewPort& view_port)
@@ -336,15 +397,10 @@ void CodeRed::DirectX12GraphicsCommandList::layoutTransition(
 		InvalidException<ResourceLayout>({ "old_layout" })
 	);
 
-	auto barrier = resourceBarrier(
-		static_cast<DirectX12Texture*>(texture.get())->texture().Get(),
-		enumConvert(old_layout),
-		enumConvert(new_layout)
-	);
-	
-	mGraphicsCommandList->ResourceBarrier(1, &barrier);
-
-	texture->setLayout(new_layout);
+	textureTransition(texture,
+		ValueRange<size_t>(0, texture->mipLevels()),
+		ValueRange<size_t>(0, texture->arrays()),
+		new_layout);
 }
 
 void CodeRed::DirectX12GraphicsCommandList::layoutTransition(
@@ -368,6 +424,38 @@ void CodeRed::DirectX12GraphicsCommandList::layoutTransition(
 	buffer->setLayout(new_layout);
 }
 
+void CodeRed::DirectX12GraphicsCommandList::layoutTransition(
+	const std::shared_ptr<GpuTextureRef>& texture,
+	const ResourceLayout layout)
+{
+	textureTransition(texture->source(), texture->mipLevel(), texture->array(), layout);
+}
+
+void CodeRed::DirectX12GraphicsCommandList::memoryBarrier(
+	const std::shared_ptr<GpuTextureRef>& texture)
+{
+	const auto source = texture->source();
+
+	auto unorderedAccess = false;
+
+	for (auto arraySlice = texture->array().Start; arraySlice < texture->array().End; arraySlice++) {
+		for (auto mipSlice = texture->mipLevel().Start; mipSlice < texture->mipLevel().End; mipSlice++)
+			unorderedAccess = unorderedAccess || source->layout(mipSlice, arraySlice) == ResourceLayout::GeneralReadWrite;
+	}
+
+	// the commands that write the texture in other states are ordered by DirectX12
+	// so we only need the uav barrier for the unordered access
+	if (!unorderedAccess) return;
+
+	D3D12_RESOURCE_BARRIER barrier = {};
+
+	barrier.Type = D3D12_RESOURCE_BARRIER_TYPE_UAV;
+	barrier.Flags = D3D12_RESOURCE_BARRIER_FLAG_NONE;
+	barrier.UAV.pResource = static_cast<DirectX12Texture*>(source.get())->texture().Get();
+
+	mGraphicsCommandList->ResourceBarrier(1, &barrier);
+}
+
 void CodeRed::DirectX12GraphicsCommandList::resolveTexture(
 	const TextureResolveInfo& source,
 	const TextureResolveInfo& destination)
@@ -413,14 +501,22 @@ void CodeRed::DirectX12GraphicsCommandList::resolveTexture(
 		Exception("The size of source and destination should be same.")
 	);
 
+	// we only translate the sub-textures we resolve, the states of them are the layouts of sub-textures
+	const auto sourceState = enumConvert(source.Texture->layout(source.MipSlice, source.ArraySlice));
+	const auto destinationState = enumConvert(destination.Texture->layout(destination.MipSlice, destination.ArraySlice));
+	
 	D3D12_RESOURCE_BARRIER beginBarriers[2] = {
-		resourceBarrier(dxSource->texture().Get(), enumConvert(dxSource->layout()), D3D12_RESOURCE_STATE_RESOLVE_SOURCE),
-		resourceBarrier(dxDestination->texture().Get(), enumConvert(dxDestination->layout()), D3D12_RESOURCE_STATE_RESOLVE_DEST),
+		resourceBarrier(dxSource->texture().Get(), sourceState, D3D12_RESOURCE_STATE_RESOLVE_SOURCE,
+			static_cast<UINT>(sourceIndex)),
+		resourceBarrier(dxDestination->texture().Get(), destinationState, D3D12_RESOURCE_STATE_RESOLVE_DEST,
+			static_cast<UINT>(destinationIndex)),
 	};
 
 	D3D12_RESOURCE_BARRIER endBarriers[2] = {
-		resourceBarrier(dxSource->texture().Get(), D3D12_RESOURCE_STATE_RESOLVE_SOURCE, enumConvert(dxSource->layout())),
-		resourceBarrier(dxDestination->texture().Get(), D3D12_RESOURCE_STATE_RESOLVE_DEST, enumConvert(dxDestination->layout()))
+		resourceBarrier(dxSource->texture().Get(), D3D12_RESOURCE_STATE_RESOLVE_SOURCE, sourceState,
+			static_cast<UINT>(sourceIndex)),
+		resourceBarrier(dxDestination->texture().Get(), D3D12_RESOURCE_STATE_RESOLVE_DEST, destinationState,
+			static_cast<UINT>(destinationIndex))
 	};
 
 	// Because the layout of image should be vk::ImageLayout::eTransferSrcOptimal and vk::ImageLayout::eTransferDstOptimal
@@ -446,16 +542,7 @@ void CodeRed::DirectX12GraphicsCommandList::copyBuffer(
 	const size_t source_offset,
 	const size_t destination_offset)
 {
-	const auto dxSource = static_cast<DirectX12Buffer*>(source.get())->buffer();
-	const auto dxDestination = static_cast<DirectX12Buffer*>(destination.get())->buffer();
-
-	mGraphicsCommandList->CopyBufferRegion(
-		dxDestination.Get(),
-		static_cast<UINT64>(destination_offset),
-		dxSource.Get(),
-		static_cast<UINT64>(source_offset),
-		static_cast<UINT64>(size)
-	);
+	copyBuffer(source, destination, { BufferCopyRegion(size, source_offset, destination_offset) });
 }
 
 void CodeRed::DirectX12GraphicsCommandList::copyTexture(
@@ -480,107 +567,440 @@ void CodeRed::DirectX12GraphicsCommandList::copyTexture(
 	const TextureCopyInfo& destination, 
 	const size_t width, const size_t height, const size_t depth)
 {
-	const auto dxSource = std::static_pointer_cast<DirectX12Texture>(source.Texture)->texture();
-	const auto dxDestination = std::static_pointer_cast<DirectX12Texture>(destination.Texture)->texture();
+	copyTexture(source.Texture, destination.Texture, {
+		TextureCopyRegion(
+			source.ResourceIndex, source.LocationX, source.LocationY, source.LocationZ,
+			destination.ResourceIndex, destination.LocationX, destination.LocationY, destination.LocationZ,
+			width, height, depth)
+		});
+}
+
+void CodeRed::DirectX12GraphicsCommandList::copyTextureToBuffer(
+	const TextureCopyInfo& source,
+	const TextureBufferCopyInfo& destination, 
+	const size_t width, const size_t height, const size_t depth)
+{
+	copyTextureToBuffer(source.Texture, destination.Buffer, {
+		TextureCopyRegion(
+			source.ResourceIndex, source.LocationX, source.LocationY, source.LocationZ,
+			0, destination.LocationX, destination.LocationY, destination.LocationZ,
+			width, height, depth)
+		});
+}
+
+void CodeRed::DirectX12GraphicsCommandList::copyBufferToTexture(
+	const TextureBufferCopyInfo& source,
+	const TextureCopyInfo& destination, 
+	const size_t width, const size_t height, const size_t depth)
+{
+	copyBufferToTexture(source.Buffer, destination.Texture, {
+		TextureCopyRegion(
+			0, source.LocationX, source.LocationY, source.LocationZ,
+			destination.ResourceIndex, destination.LocationX, destination.LocationY, destination.LocationZ,
+			width, height, depth)
+		});
+}
 
+void CodeRed::DirectX12GraphicsCommandList::copyBuffer(
+	const std::shared_ptr<GpuBuffer>& source,
+	const std::shared_ptr<GpuBuffer>& destination,
+	const std::vector<BufferCopyRegion>& regions)
+{
+	const auto dxSource = static_cast<DirectX12Buffer*>(source.get())->buffer();
+	const auto dxDestination = static_cast<DirectX12Buffer*>(destination.get())->buffer();
+
+	// DirectX12 does not have the multi-region copy command, so we record the regions one by one
+	for (const auto& region : regions) {
+		mGraphicsCommandList->CopyBufferRegion(
+			dxDestination.Get(),
+			static_cast<UINT64>(region.DestinationOffset),
+			dxSource.Get(),
+			static_cast<UINT64>(region.SourceOffset),
+			static_cast<UINT64>(region.Size)
+		);
+	}
+}
+
+void CodeRed::DirectX12GraphicsCommandList::copyTexture(
+	const std::shared_ptr<GpuTexture>& source,
+	const std::shared_ptr<GpuTexture>& destination,
+	const std::vector<TextureCopyRegion>& regions)
+{
 	D3D12_TEXTURE_COPY_LOCATION src;
 	D3D12_TEXTURE_COPY_LOCATION dst;
 
 	src.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-	src.pResource = dxSource.Get();
-	src.SubresourceIndex = static_cast<UINT>(source.ResourceIndex);
+	src.pResource = static_cast<DirectX12Texture*>(source.get())->texture().Get();
 
 	dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-	dst.pResource = dxDestination.Get();
-	dst.SubresourceIndex = static_cast<UINT>(destination.ResourceIndex);
-
-	D3D12_BOX srcRegion = {
-		static_cast<UINT>(source.LocationX),
-		static_cast<UINT>(source.LocationY),
-		static_cast<UINT>(source.LocationZ),
-		static_cast<UINT>(source.LocationX + width),
-		static_cast<UINT>(source.LocationY + height),
-		static_cast<UINT>(source.LocationZ + depth)
-	};
+	dst.pResource = static_cast<DirectX12Texture*>(destination.get())->texture().Get();
+
+	for (const auto& region : regions) {
+		src.SubresourceIndex = static_cast<UINT>(region.SourceIndex);
+		dst.SubresourceIndex = static_cast<UINT>(region.DestinationIndex);
+
+		D3D12_BOX srcRegion = {
+			static_cast<UINT>(region.SourceX),
+			static_cast<UINT>(region.SourceY),
+			static_cast<UINT>(region.SourceZ),
+			static_cast<UINT>(region.SourceX + region.Width),
+			static_cast<UINT>(region.SourceY + region.Height),
+			static_cast<UINT>(region.SourceZ + region.Depth)
+		};
 
-	mGraphicsCommandList->CopyTextureRegion(&dst,
-		static_cast<UINT>(destination.LocationX),
-		static_cast<UINT>(destination.LocationY),
-		static_cast<UINT>(destination.LocationZ),
-		&src,
-		&srcRegion);
+		mGraphicsCommandList->CopyTextureRegion(&dst,
+			static_cast<UINT>(region.DestinationX),
+			static_cast<UINT>(region.DestinationY),
+			static_cast<UINT>(region.DestinationZ),
+			&src,
+			&srcRegion);
+	}
 }
 
 void CodeRed::DirectX12GraphicsCommandList::copyTextureToBuffer(
-	const TextureCopyInfo& source,
-	const TextureBufferCopyInfo& destination, 
-	const size_t width, const size_t height, const size_t depth)
+	const std::shared_ptr<GpuTexture>& source,
+	const std::shared_ptr<GpuTextureBuffer>& destination,
+	const std::vector<TextureCopyRegion>& regions)
 {
-	const auto dxSource = std::static_pointer_cast<DirectX12Texture>(source.Texture)->texture();
-	const auto dxDestination = std::static_pointer_cast<DirectX12TextureBuffer>(destination.Buffer)->texture();
-
 	D3D12_TEXTURE_COPY_LOCATION src;
 	D3D12_TEXTURE_COPY_LOCATION dst;
 
 	src.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-	src.pResource = dxSource.Get();
-	src.SubresourceIndex = static_cast<UINT>(source.ResourceIndex);
+	src.pResource = static_cast<DirectX12Texture*>(source.get())->texture().Get();
 
 	dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-	dst.pResource = dxDestination.Get();
+	dst.pResource = static_cast<DirectX12TextureBuffer*>(destination.get())->texture().Get();
 	dst.SubresourceIndex = 0;
 
-	D3D12_BOX srcRegion = {
-		static_cast<UINT>(source.LocationX),
-		static_cast<UINT>(source.LocationY),
-		static_cast<UINT>(source.LocationZ),
-		static_cast<UINT>(source.LocationX + width),
-		static_cast<UINT>(source.LocationY + height),
-		static_cast<UINT>(source.LocationZ + depth)
-	};
+	//the region of compressed texture must be aligned to blocks
+	const auto format = source->format();
 
-	mGraphicsCommandList->CopyTextureRegion(&dst,
-		static_cast<UINT>(0),
-		static_cast<UINT>(0),
-		static_cast<UINT>(0),
-		&src,
-		&srcRegion);
+	for (const auto& region : regions) {
+		src.SubresourceIndex = static_cast<UINT>(region.SourceIndex);
+
+		D3D12_BOX srcRegion = {
+			static_cast<UINT>(region.SourceX),
+			static_cast<UINT>(region.SourceY),
+			static_cast<UINT>(region.SourceZ),
+			static_cast<UINT>(region.SourceX + PixelFormatSizeOf::blockAlign(format, region.Width)),
+			static_cast<UINT>(region.SourceY + PixelFormatSizeOf::blockAlign(format, region.Height)),
+			static_cast<UINT>(region.SourceZ + region.Depth)
+		};
+
+		mGraphicsCommandList->CopyTextureRegion(&dst,
+			static_cast<UINT>(region.DestinationX),
+			static_cast<UINT>(region.DestinationY),
+			static_cast<UINT>(region.DestinationZ),
+			&src,
+			&srcRegion);
+	}
 }
 
 void CodeRed::DirectX12GraphicsCommandList::copyBufferToTexture(
-	const TextureBufferCopyInfo& source,
-	const TextureCopyInfo& destination, 
-	const size_t width, const size_t height, const size_t depth)
+	const std::shared_ptr<GpuTextureBuffer>& source,
+	const std::shared_ptr<GpuTexture>& destination,
+	const std::vector<TextureCopyRegion>& regions)
 {
-	const auto dxSource = std::static_pointer_cast<DirectX12TextureBuffer>(source.Buffer)->texture();
-	const auto dxDestination = std::static_pointer_cast<DirectX12Texture>(destination.Texture)->texture();
-
 	D3D12_TEXTURE_COPY_LOCATION src;
 	D3D12_TEXTURE_COPY_LOCATION dst;
 
 	src.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-	src.pResource = dxSource.Get();
+	src.pResource = static_cast<DirectX12TextureBuffer*>(source.get())->texture().Get();
 	src.SubresourceIndex = 0;
 
 	dst.Type = D3D12_TEXTURE_COPY_TYPE_SUBRESOURCE_INDEX;
-	dst.pResource = dxDestination.Get();
-	dst.SubresourceIndex = static_cast<UINT>(destination.ResourceIndex);
-
-	D3D12_BOX srcRegion = {
-		static_cast<UINT>(0),
-		static_cast<UINT>(0),
-		static_cast<UINT>(0),
-		static_cast<UINT>(width),
-		static_cast<UINT>(height),
-		static_cast<UINT>(depth)
+	dst.pResource = static_cast<DirectX12Texture*>(destination.get())->texture().Get();
+
+	//the region of compressed texture must be aligned to blocks
+	const auto format = destination->format();
+
+	for (const auto& region : regions) {
+		dst.SubresourceIndex = static_cast<UINT>(region.DestinationIndex);
+
+		D3D12_BOX srcRegion = {
+			static_cast<UINT>(region.SourceX),
+			static_cast<UINT>(region.SourceY),
+			static_cast<UINT>(region.SourceZ),
+			static_cast<UINT>(region.SourceX + PixelFormatSizeOf::blockAlign(format, region.Width)),
+			static_cast<UINT>(region.SourceY + PixelFormatSizeOf::blockAlign(format, region.Height)),
+			static_cast<UINT>(region.SourceZ + region.Depth)
+		};
+
+		mGraphicsCommandList->CopyTextureRegion(&dst,
+			static_cast<UINT>(region.DestinationX),
+			static_cast<UINT>(region.DestinationY),
+			static_cast<UINT>(region.DestinationZ),
+			&src,
+			&srcRegion);
+	}
+}
+
+void CodeRed::DirectX12GraphicsCommandList::blitTexture(
+	const TextureBlitInfo& source,
+	const TextureBlitInfo& destination,
+	const BlitFilter filter)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mRenderPass != nullptr,
+		Exception("please end the render pass before blit texture.")
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		source.Texture->sample() != MultiSample::Count1 ||
+		destination.Texture->sample() != MultiSample::Count1,
+		InvalidException<GpuTexture>({ "source or destination" },
+			{ "We can not blit MSAA texture, please use resolveTexture." })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		!enumHas(destination.Texture->usage(), ResourceUsage::RenderTarget),
+		InvalidException<GpuTexture>({ "destination" },
+			{ "The destination should be created with ResourceUsage::RenderTarget in DirectX12 mode." })
+	);
+
+	// the built-in pipeline does not clip the region, so the region should be in the sub-texture
+	const auto outside = [](const TextureBlitInfo& info)
+	{
+		return
+			info.MipSlice >= info.Texture->mipLevels() ||
+			info.ArraySlice >= info.Texture->arrays() ||
+			std::max(info.Region.Left, info.Region.Right) > info.Texture->width(info.MipSlice) ||
+			std::max(info.Region.Top, info.Region.Bottom) > info.Texture->height(info.MipSlice) ||
+			std::max(info.Region.Front, info.Region.Back) > info.Texture->depth(info.MipSlice);
+	};
+
+	CODE_RED_DEBUG_THROW_IF(
+		outside(source) || outside(destination),
+		InvalidException<TextureBlitInfo>({ "source or destination" },
+			{ "The region is out of the sub-texture." })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		source.Texture->layout(source.MipSlice, source.ArraySlice) != ResourceLayout::CopySource,
+		InvalidException<TextureBlitInfo>({ "source" },
+			{ "The layout of source should be ResourceLayout::CopySource." })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		destination.Texture->layout(destination.MipSlice, destination.ArraySlice) != ResourceLayout::CopyDestination,
+		InvalidException<TextureBlitInfo>({ "destination" },
+			{ "The layout of destination should be ResourceLayout::CopyDestination." })
+	);
+
+	const auto srcIndex = static_cast<UINT>(source.Texture->index(source.MipSlice, source.ArraySlice));
+	const auto dstIndex = static_cast<UINT>(destination.Texture->index(destination.MipSlice, destination.ArraySlice));
+
+	CODE_RED_DEBUG_THROW_IF(
+		source.Texture == destination.Texture && srcIndex == dstIndex,
+		InvalidException<GpuTexture>({ "source and destination" },
+			{ "We can not blit a sub-texture to itself." })
+	);
+
+	if (destination.Region.width() == 0 || destination.Region.height() == 0) return;
+	
+	// the built-in pipeline draws the region as render target, so it only supports texture 2D
+	CODE_RED_TRY_EXECUTE(
+		source.Texture->dimension() != Dimension::Dimension2D ||
+		destination.Texture->dimension() != Dimension::Dimension2D,
+		throw NotSupportException(NotSupportType::Object)
+	);
+
+	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get());
+	const auto dxAllocator = static_cast<DirectX12CommandAllocator*>(mAllocator.get());
+	const auto dxSource = static_cast<DirectX12Texture*>(source.Texture.get())->texture();
+	const auto dxDestination = static_cast<DirectX12Texture*>(destination.Texture.get())->texture();
+
+	const auto srcState = enumConvert(source.Texture->layout(source.MipSlice, source.ArraySlice));
+	const auto dstState = enumConvert(destination.Texture->layout(destination.MipSlice, destination.ArraySlice));
+
+	const auto srvHeap = dxAllocator->allocateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, 1);
+	const auto rtvHeap = dxAllocator->allocateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, 1);
+
+	DirectX12BlitInfo srcInfo;
+	DirectX12BlitInfo dstInfo;
+
+	srcInfo.Resource = dxSource.Get();
+	srcInfo.Format = enumConvert(source.Texture->format());
+	srcInfo.MipSlice = static_cast<UINT>(source.MipSlice);
+	srcInfo.ArraySlice = static_cast<UINT>(source.ArraySlice);
+	srcInfo.Width = static_cast<UINT>(source.Texture->width(source.MipSlice));
+	srcInfo.Height = static_cast<UINT>(source.Texture->height(source.MipSlice));
+	srcInfo.Region = {
+		static_cast<LONG>(source.Region.Left), static_cast<LONG>(source.Region.Top),
+		static_cast<LONG>(source.Region.Right), static_cast<LONG>(source.Region.Bottom)
 	};
 
-	mGraphicsCommandList->CopyTextureRegion(&dst,
-		static_cast<UINT>(destination.LocationX),
-		static_cast<UINT>(destination.LocationY),
-		static_cast<UINT>(destination.LocationZ),
-		&src,
-		&srcRegion);
+	dstInfo.Resource = dxDestination.Get();
+	dstInfo.Format = enumConvert(destination.Texture->format());
+	dstInfo.MipSlice = static_cast<UINT>(destination.MipSlice);
+	dstInfo.ArraySlice = static_cast<UINT>(destination.ArraySlice);
+	dstInfo.Width = static_cast<UINT>(destination.Texture->width(destination.MipSlice));
+	dstInfo.Height = static_cast<UINT>(destination.Texture->height(destination.MipSlice));
+	dstInfo.Region = {
+		static_cast<LONG>(destination.Region.Left), static_cast<LONG>(destination.Region.Top),
+		static_cast<LONG>(destination.Region.Right), static_cast<LONG>(destination.Region.Bottom)
+	};
+
+	std::vector<D3D12_RESOURCE_BARRIER> barriers;
+
+	// we only transition the sub-textures we blit from and to
+	if (srcState != D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE)
+		barriers.push_back(resourceBarrier(dxSource.Get(), srcState, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, srcIndex));
+
+	if (dstState != D3D12_RESOURCE_STATE_RENDER_TARGET)
+		barriers.push_back(resourceBarrier(dxDestination.Get(), dstState, D3D12_RESOURCE_STATE_RENDER_TARGET, dstIndex));
+
+	if (!barriers.empty()) mGraphicsCommandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+
+	mGraphicsCommandList->SetDescriptorHeaps(1, srvHeap.GetAddressOf());
+
+	dxDevice->textureBlitter()->blit(mGraphicsCommandList.Get(), srcInfo, dstInfo, 
+		filter == BlitFilter::Linear,
+		srvHeap->GetCPUDescriptorHandleForHeapStart(),
+		srvHeap->GetGPUDescriptorHandleForHeapStart(),
+		rtvHeap->GetCPUDescriptorHandleForHeapStart());
+
+	// transition the sub-textures back to the layout of textures
+	for (auto& barrier : barriers) std::swap(barrier.Transition.StateBefore, barrier.Transition.StateAfter);
+
+	if (!barriers.empty()) mGraphicsCommandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+
+	// the root signature and descriptor heap are changed by blitter
+	// so we need set the resource layout and descriptor heap again
+	mResourceLayout.reset();
+	mGraphicsPipeline.reset();
+}
+
+void CodeRed::DirectX12GraphicsCommandList::generateMipmaps(
+	const std::shared_ptr<GpuTexture>& texture)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mRenderPass != nullptr,
+		Exception("please end the render pass before generate mipmaps.")
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		texture->sample() != MultiSample::Count1,
+		InvalidException<GpuTexture>({ "texture" },
+			{ "We can not generate mipmaps for MSAA texture." })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		!enumHas(texture->usage(), ResourceUsage::RenderTarget),
+		InvalidException<GpuTexture>({ "texture" },
+			{ "The texture should be created with ResourceUsage::RenderTarget in DirectX12 mode." })
+	);
+
+	if (texture->mipLevels() <= 1) return;
+
+	// the built-in pipeline draws the mip levels as render target, so it only supports texture 2D
+	CODE_RED_TRY_EXECUTE(
+		texture->dimension() != Dimension::Dimension2D,
+		throw NotSupportException(NotSupportType::Object)
+	);
+
+	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get());
+	const auto dxAllocator = static_cast<DirectX12CommandAllocator*>(mAllocator.get());
+	const auto dxTexture = static_cast<DirectX12Texture*>(texture.get())->texture();
+	const auto blitter = dxDevice->textureBlitter();
+
+	const auto levels = texture->mipLevels();
+	const auto arrays = texture->arrays();
+	const auto format = enumConvert(texture->format());
+
+	const auto srvHeap = dxAllocator->allocateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV, (levels - 1) * arrays);
+	const auto rtvHeap = dxAllocator->allocateDescriptorHeap(D3D12_DESCRIPTOR_HEAP_TYPE_RTV, (levels - 1) * arrays);
+	const auto srvSize = dxDevice->device()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+	const auto rtvSize = dxDevice->device()->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_RTV);
+
+	std::vector<D3D12_RESOURCE_BARRIER> barriers;
+
+	// the state of sub-texture before we generate mipmaps, we translate it back at the end
+	const auto state = [&](const size_t mipSlice, const size_t arraySlice)
+	{
+		return enumConvert(texture->layout(mipSlice, arraySlice));
+	};
+	
+	const auto transition = [&](const size_t mipSlice, const size_t arraySlice,
+		const D3D12_RESOURCE_STATES before, const D3D12_RESOURCE_STATES after)
+	{
+		if (before == after) return;
+
+		barriers.push_back(resourceBarrier(dxTexture.Get(), before, after,
+			static_cast<UINT>(texture->index(mipSlice, arraySlice))));
+	};
+
+	const auto flush = [&]()
+	{
+		if (barriers.empty()) return;
+
+		mGraphicsCommandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+
+		barriers.clear();
+	};
+
+	// the mip level 0 is read by pixel shader and the other mip levels are render targets
+	for (size_t arraySlice = 0; arraySlice < arrays; arraySlice++) {
+		transition(0, arraySlice, state(0, arraySlice), D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+
+		for (size_t mipSlice = 1; mipSlice < levels; mipSlice++)
+			transition(mipSlice, arraySlice, state(mipSlice, arraySlice), D3D12_RESOURCE_STATE_RENDER_TARGET);
+	}
+
+	flush();
+
+	mGraphicsCommandList->SetDescriptorHeaps(1, srvHeap.GetAddressOf());
+
+	size_t descriptorIndex = 0;
+
+	for (size_t mipSlice = 1; mipSlice < levels; mipSlice++) {
+		for (size_t arraySlice = 0; arraySlice < arrays; arraySlice++) {
+			DirectX12BlitInfo source;
+			DirectX12BlitInfo destination;
+
+			source.Resource = dxTexture.Get();
+			source.Format = format;
+			source.MipSlice = static_cast<UINT>(mipSlice - 1);
+			source.ArraySlice = static_cast<UINT>(arraySlice);
+			source.Width = static_cast<UINT>(texture->width(mipSlice - 1));
+			source.Height = static_cast<UINT>(texture->height(mipSlice - 1));
+			source.Region = { 0, 0, static_cast<LONG>(source.Width), static_cast<LONG>(source.Height) };
+
+			destination.Resource = dxTexture.Get();
+			destination.Format = format;
+			destination.MipSlice = static_cast<UINT>(mipSlice);
+			destination.ArraySlice = static_cast<UINT>(arraySlice);
+			destination.Width = static_cast<UINT>(texture->width(mipSlice));
+			destination.Height = static_cast<UINT>(texture->height(mipSlice));
+			destination.Region = { 0, 0, static_cast<LONG>(destination.Width), static_cast<LONG>(destination.Height) };
+
+			blitter->blit(mGraphicsCommandList.Get(), source, destination, true,
+				{ srvHeap->GetCPUDescriptorHandleForHeapStart().ptr + descriptorIndex * srvSize },
+				{ srvHeap->GetGPUDescriptorHandleForHeapStart().ptr + descriptorIndex * srvSize },
+				{ rtvHeap->GetCPUDescriptorHandleForHeapStart().ptr + descriptorIndex * rtvSize });
+
+			descriptorIndex++;
+		}
+
+		// the mip level we generated is the source of next mip level
+		for (size_t arraySlice = 0; arraySlice < arrays; arraySlice++)
+			transition(mipSlice, arraySlice, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE);
+		
+		flush();
+	}
+
+	// the sub-textures are translated back to their layouts, so the layouts we track are not changed
+	for (size_t arraySlice = 0; arraySlice < arrays; arraySlice++) {
+		for (size_t mipSlice = 0; mipSlice < levels; mipSlice++)
+			transition(mipSlice, arraySlice, D3D12_RESOURCE_STATE_PIXEL_SHADER_RESOURCE, state(mipSlice, arraySlice));
+	}
+
+	flush();
+
+	// the root signature and descriptor heap are changed by blitter
+	// so we need set the resource layout and descriptor heap again
+	mResourceLayout.reset();
+	mGraphicsPipeline.reset();
 }
 
 void CodeRed::DirectX12GraphicsCommandList::draw(
@@ -613,10 +1033,137 @@ void CodeRed::DirectX12GraphicsCommandList::drawIndexed(
 	);
 }
 
+void CodeRed::DirectX12GraphicsCommandList::drawIndirect(
+	const std::shared_ptr<GpuBuffer>& argument_buffer, 
+	const size_t draw_count,
+	const size_t argument_offset)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		argument_offset + draw_count * sizeof(DrawIndirectArguments) > argument_buffer->size(),
+		InvalidException<GpuBuffer>({ "argument_buffer" }, { "the range of arguments is out of the buffer." })
+	);
+	
+	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get());
+
+	mGraphicsCommandList->ExecuteIndirect(
+		dxDevice->drawCommandSignature().Get(),
+		static_cast<UINT>(draw_count),
+		static_cast<DirectX12Buffer*>(argument_buffer.get())->buffer().Get(),
+		static_cast<UINT64>(argument_offset),
+		nullptr, 0
+	);
+}
+
+void CodeRed::DirectX12GraphicsCommandList::drawIndexedIndirect(
+	const std::shared_ptr<GpuBuffer>& argument_buffer, 
+	const size_t draw_count,
+	const size_t argument_offset)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		argument_offset + draw_count * sizeof(DrawIndexedIndirectArguments) > argument_buffer->size(),
+		InvalidException<GpuBuffer>({ "argument_buffer" }, { "the range of arguments is out of the buffer." })
+	);
+	
+	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get());
+
+	mGraphicsCommandList->ExecuteIndirect(
+		dxDevice->drawIndexedCommandSignature().Get(),
+		static_cast<UINT>(draw_count),
+		static_cast<DirectX12Buffer*>(argument_buffer.get())->buffer().Get(),
+		static_cast<UINT64>(argument_offset),
+		nullptr, 0
+	);
+}
+
+void CodeRed::DirectX12GraphicsCommandList::drawIndirectCount(
+	const std::shared_ptr<GpuBuffer>& argument_buffer,
+	const std::shared_ptr<GpuBuffer>& count_buffer, 
+	const size_t max_draw_count,
+	const size_t argument_offset,
+	const size_t count_offset)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		argument_offset + max_draw_count * sizeof(DrawIndirectArguments) > argument_buffer->size(),
+		InvalidException<GpuBuffer>({ "argument_buffer" }, { "the range of arguments is out of the buffer." })
+	);
+
+	// the count of draws is a 32bit unsigned integer
+	CODE_RED_DEBUG_THROW_IF(
+		count_offset + sizeof(uint32_t) > count_buffer->size(),
+		InvalidException<GpuBuffer>({ "count_buffer" }, { "the range of count is out of the buffer." })
+	);
+
+	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get());
+
+	mGraphicsCommandList->ExecuteIndirect(
+		dxDevice->drawCommandSignature().Get(),
+		static_cast<UINT>(max_draw_count),
+		static_cast<DirectX12Buffer*>(argument_buffer.get())->buffer().Get(),
+		static_cast<UINT64>(argument_offset),
+		static_cast<DirectX12Buffer*>(count_buffer.get())->buffer().Get(),
+		static_cast<UINT64>(count_offset)
+	);
+}
+
+void CodeRed::DirectX12GraphicsCommandList::drawIndexedIndirectCount(
+	const std::shared_ptr<GpuBuffer>& argument_buffer,
+	const std::shared_ptr<GpuBuffer>& count_buffer, 
+	const size_t max_draw_count,
+	const size_t argument_offset,
+	const size_t count_offset)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		argument_offset + max_draw_count * sizeof(DrawIndexedIndirectArguments) > argument_buffer->size(),
+		InvalidException<GpuBuffer>({ "argument_buffer" }, { "the range of arguments is out of the buffer." })
+	);
+
+	// the count of draws is a 32bit unsigned integer
+	CODE_RED_DEBUG_THROW_IF(
+		count_offset + sizeof(uint32_t) > count_buffer->size(),
+		InvalidException<GpuBuffer>({ "count_buffer" }, { "the range of count is out of the buffer." })
+	);
+
+	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get());
+
+	mGraphicsCommandList->ExecuteIndirect(
+		dxDevice->drawIndexedCommandSignature().Get(),
+		static_cast<UINT>(max_draw_count),
+		static_cast<DirectX12Buffer*>(argument_buffer.get())->buffer().Get(),
+		static_cast<UINT64>(argument_offset),
+		static_cast<DirectX12Buffer*>(count_buffer.get())->buffer().Get(),
+		static_cast<UINT64>(count_offset)
+	);
+}
+
+void CodeRed::DirectX12GraphicsCommandList::dispatch(
+	const size_t x, 
+	const size_t y, 
+	const size_t z)
+{
+	mGraphicsCommandList->Dispatch(
+		static_cast<UINT>(x),
+		static_cast<UINT>(y),
+		static_cast<UINT>(z)
+	);
+}
+
+void CodeRed::DirectX12GraphicsCommandList::executeBundle(
+	const std::shared_ptr<GpuGraphicsBundle>& bundle)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mRenderPass == nullptr,
+		Exception("please begin a render pass before execute a bundle.")
+	);
+	
+	mGraphicsCommandList->ExecuteBundle(
+		static_cast<DirectX12GraphicsBundle*>(bundle.get())->commandList().Get());
+}
+
 D3D12_RESOURCE_BARRIER CodeRed::DirectX12GraphicsCommandList::resourceBarrier(
 	ID3D12Resource* pResource,
 	const D3D12_RESOURCE_STATES before, 
-	const D3D12_RESOURCE_STATES after)
+	const D3D12_RESOURCE_STATES after,
+	const UINT subresource)
 {
 
 	D3D12_RESOURCE_BARRIER barrier = {};
@@ -626,11 +1173,63 @@ D3D12_RESOURCE_BARRIER CodeRed::DirectX12GraphicsCommandList::resourceBarrier(
 	barrier.Transition.pResource = pResource;
 	barrier.Transition.StateBefore = before;
 	barrier.Transition.StateAfter = after;
-	barrier.Transition.Subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES;
+	barrier.Transition.Subresource = subresource;
 
 	return barrier;
 }
 
+void CodeRed::DirectX12GraphicsCommandList::textureTransition(
+	const std::shared_ptr<GpuTexture>& texture,
+	const ValueRange<size_t>& mipLevel,
+	const ValueRange<size_t>& array,
+	const ResourceLayout layout)
+{
+	const auto dxTexture = static_cast<DirectX12Texture*>(texture.get())->texture();
+	const auto count = texture->mipLevels() * texture->arrays();
+	const auto first = texture->layout(mipLevel.Start, array.Start);
+
+	auto uniform = true;
+
+	for (auto arraySlice = array.Start; arraySlice < array.End; arraySlice++) {
+		for (auto mipSlice = mipLevel.Start; mipSlice < mipLevel.End; mipSlice++)
+			uniform = uniform && texture->layout(mipSlice, arraySlice) == first;
+	}
+
+	// if we translate all sub-textures with same layout, we only need one barrier
+	if (uniform && mipLevel.size() * array.size() == count) {
+		auto barrier = resourceBarrier(dxTexture.Get(), enumConvert(first), enumConvert(layout));
+
+		mGraphicsCommandList->ResourceBarrier(1, &barrier);
+
+		texture->setLayout(mipLevel, array, layout);
+
+		return;
+	}
+
+	// the format with stencil has two planes, the sub-resources of stencil plane are after the depth plane
+	const size_t planes = texture->format() == PixelFormat::Depth24BitStencil8Bit ? 2 : 1;
+	
+	std::vector<D3D12_RESOURCE_BARRIER> barriers;
+
+	for (auto arraySlice = array.Start; arraySlice < array.End; arraySlice++) {
+		for (auto mipSlice = mipLevel.Start; mipSlice < mipLevel.End; mipSlice++) {
+			const auto before = enumConvert(texture->layout(mipSlice, arraySlice));
+			const auto after = enumConvert(layout);
+
+			if (before == after) continue;
+
+			for (size_t plane = 0; plane < planes; plane++) {
+				barriers.push_back(resourceBarrier(dxTexture.Get(), before, after,
+					static_cast<UINT>(texture->index(mipSlice, arraySlice) + plane * count)));
+			}
+		}
+	}
+
+	if (!barriers.empty()) mGraphicsCommandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+
+	texture->setLayout(mipLevel, array, layout);
+}
+
 void CodeRed::DirectX12GraphicsCommandList::tryLayoutTransition(
 	const std::shared_ptr<GpuTextureRef>& texture,
 	const std::optional<Attachment>& attachment, 
@@ -638,8 +1237,7 @@ void CodeRed::DirectX12GraphicsCommandList::tryLayoutTransition(
 {
 	CODE_RED_TRY_EXECUTE(
 		texture != nullptr && attachment.has_value(),
-		layoutTransition(texture->source(),texture->source()->layout(),
-			final ? attachment->FinalLayout : attachment->InitialLayout)
+		layoutTransition(texture, final ? attachment->FinalLayout : attachment->InitialLayout)
 	);
 }
 
@@ -37,18 +37,21 @@ namespace CodeRed {
 		void setGraphicsPipeline(
 			const std::shared_ptr<GpuGraphicsPipeline>& pipeline) override;
 
+		void setComputePipeline(
+			const std::shared_ptr<GpuComputePipeline>& pipeline) override;
+
 		void setResourceLayout(
 			const std::shared_ptr<GpuResourceLayout>& layout) override;
 
 		void setVertexBuffer(
-			const std::shared_ptr<GpuBuffer>& buffer) override;
+			const GpuBufferView& view) override;
 
 		void setVertexBuffers(
-			const std::vector<std::shared_ptr<GpuBuffer>>& buffers,
+			const std::vector<GpuBufferView>& views,
 			const size_t startSlot = 0) override;
 		
 		void setIndexBuffer(
-			const std::shared_ptr<GpuBuffer>& buffer,
+			const GpuBufferView& view,
 			const IndexType type = IndexType::UInt32) override;
 
 		void setDescriptorHeap(
@@ -77,6 +80,13 @@ namespace CodeRed {
 			const ResourceLayout old_layout, 
 			const ResourceLayout new_layout) override;
 
+		void layoutTransition(
+			const std::shared_ptr<GpuTextureRef>& texture,
+			const ResourceLayout layout) override;
+
+		void memoryBarrier(
+			const std::shared_ptr<GpuTextureRef>& texture) override;
+
 		void resolveTexture(
 			const TextureResolveInfo& source, 
 			const TextureResolveInfo& destination) override;
@@ -116,6 +126,34 @@ namespace CodeRed {
 			const size_t width, 
 			const size_t height, 
 			const size_t depth) override;
+
+		void copyBuffer(
+			const std::shared_ptr<GpuBuffer>& source,
+			const std::shared_ptr<GpuBuffer>& destination,
+			const std::vector<BufferCopyRegion>& regions) override;
+
+		void copyTexture(
+			const std::shared_ptr<GpuTexture>& source,
+			const std::shared_ptr<GpuTexture>& destination,
+			const std::vector<TextureCopyRegion>& regions) override;
+
+		void copyTextureToBuffer(
+			const std::shared_ptr<GpuTexture>& source,
+			const std::shared_ptr<GpuTextureBuffer>& destination,
+			const std::vector<TextureCopyRegion>& regions) override;
+
+		void copyBufferToTexture(
+			const std::shared_ptr<GpuTextureBuffer>& source,
+			const std::shared_ptr<GpuTexture>& destination,
+			const std::vector<TextureCopyRegion>& regions) override;
+
+		void blitTexture(
+			const TextureBlitInfo& source,
+			const TextureBlitInfo& destination,
+			const BlitFilter filter) override;
+
+		void generateMipmaps(
+			const std::shared_ptr<GpuTexture>& texture) override;
 		
 		void draw(
 			const size_t vertex_count, 
@@ -129,13 +167,53 @@ namespace CodeRed {
 			const size_t start_index_location, 
 			const size_t base_vertex_location, 
 			const size_t start_instance_location) override;
+
+		void drawIndirect(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const size_t draw_count = 1,
+			const size_t argument_offset = 0) override;
+
+		void drawIndexedIndirect(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const size_t draw_count = 1,
+			const size_t argument_offset = 0) override;
+
+		void drawIndirectCount(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const std::shared_ptr<GpuBuffer>& count_buffer,
+			const size_t max_draw_count,
+			const size_t argument_offset = 0,
+			const size_t count_offset = 0) override;
+
+		void drawIndexedIndirectCount(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const std::shared_ptr<GpuBuffer>& count_buffer,
+			const size_t max_draw_count,
+			const size_t argument_offset = 0,
+			const size_t count_offset = 0) override;
+
+		void dispatch(
+			const size_t x,
+			const size_t y = 1,
+			const size_t z = 1) override;
+
+		void executeBundle(
+			const std::shared_ptr<GpuGraphicsBundle>& bundle) override;
 		
 		auto commandList() const noexcept -> WRL::ComPtr<ID3D12GraphicsCommandList> { return mGraphicsCommandList; }
 	private:
 		static D3D12_RESOURCE_BARRIER resourceBarrier(
 			ID3D12Resource* pResource,
 			const D3D12_RESOURCE_STATES before,
-			const D3D12_RESOURCE_STATES after);
+			const D3D12_RESOURCE_STATES after,
+			const UINT subresource = D3D12_RESOURCE_BARRIER_ALL_SUBRESOURCES);
+
+		// translate the sub-textures in the range, the old layouts are the layouts of sub-textures
+		void textureTransition(
+			const std::shared_ptr<GpuTexture>& texture,
+			const ValueRange<size_t>& mipLevel,
+			const ValueRange<size_t>& array,
+			const ResourceLayout layout);
 
 		void tryLayoutTransition(
 			const std::shared_ptr<GpuTextureRef>& texture,
@@ -146,6 +224,9 @@ namespace CodeRed {
 
 		std::shared_ptr<DirectX12ResourceLayout> mResourceLayout;
 		std::shared_ptr<DirectX12FrameBuffer> mFrameBuffer;
+
+		// the pipeline we set, we use it to check the strides of vertex buffers
+		std::shared_ptr<GpuGraphicsPipeline> mGraphicsPipeline;
 		std::shared_ptr<DirectX12RenderPass> mRenderPass;
 	};
 	
@@ -1,4 +1,5 @@
 #include "../Shared/Exception/FailedException.hpp"
+#include "../Shared/Hash.hpp"
 
 #include "DirectX12PipelineState/DirectX12InputAssemblyState.hpp"
 #include "DirectX12PipelineState/DirectX12RasterizationState.hpp"
@@ -14,6 +15,97 @@
 
 using namespace CodeRed::DirectX12;
 
+//the key of pipeline in pipeline library, the pointers of desc are not stable between runs
+//so we hash the data they point to instead of the pointers
+static auto hashPipelineStateDesc(
+	const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+	const CodeRed::UInt64 root_signature_hash)
+	-> CodeRed::UInt64
+{
+	using CodeRed::Hash;
+	
+	auto hash = Hash::value(root_signature_hash);
+
+	hash = Hash::bytes(desc.VS.pShaderBytecode, desc.VS.BytecodeLength, Hash::value(desc.VS.BytecodeLength, hash));
+	hash = Hash::bytes(desc.PS.pShaderBytecode, desc.PS.BytecodeLength, Hash::value(desc.PS.BytecodeLength, hash));
+
+	hash = Hash::value(desc.InputLayout.NumElements, hash);
+	
+	for (UINT index = 0; index < desc.InputLayout.NumElements; index++) {
+		const auto& element = desc.InputLayout.pInputElementDescs[index];
+
+		hash = Hash::string(element.SemanticName, hash);
+		hash = Hash::value(element.SemanticIndex, hash);
+		hash = Hash::value(element.Format, hash);
+		hash = Hash::value(element.InputSlot, hash);
+		hash = Hash::value(element.AlignedByteOffset, hash);
+		hash = Hash::value(element.InputSlotClass, hash);
+		hash = Hash::value(element.InstanceDataStepRate, hash);
+	}
+
+	//the blend and depth stencil desc have padding bytes(after UINT8 members)
+	//so we hash the members one by one instead of the bytes of structures
+	hash = Hash::value(desc.BlendState.AlphaToCoverageEnable, hash);
+	hash = Hash::value(desc.BlendState.IndependentBlendEnable, hash);
+
+	for (const auto& target : desc.BlendState.RenderTarget) {
+		hash = Hash::value(target.BlendEnable, hash);
+		hash = Hash::value(target.LogicOpEnable, hash);
+		hash = Hash::value(target.SrcBlend, hash);
+		hash = Hash::value(target.DestBlend, hash);
+		hash = Hash::value(target.BlendOp, hash);
+		hash = Hash::value(target.SrcBlendAlpha, hash);
+		hash = Hash::value(target.DestBlendAlpha, hash);
+		hash = Hash::value(target.BlendOpAlpha, hash);
+		hash = Hash::value(target.LogicOp, hash);
+		hash = Hash::value(target.RenderTargetWriteMask, hash);
+	}
+
+	hash = Hash::value(desc.RasterizerState.FillMode, hash);
+	hash = Hash::value(desc.RasterizerState.CullMode, hash);
+	hash = Hash::value(desc.RasterizerState.FrontCounterClockwise, hash);
+	hash = Hash::value(desc.RasterizerState.DepthBias, hash);
+	hash = Hash::value(desc.RasterizerState.DepthBiasClamp, hash);
+	hash = Hash::value(desc.RasterizerState.SlopeScaledDepthBias, hash);
+	hash = Hash::value(desc.RasterizerState.DepthClipEnable, hash);
+	hash = Hash::value(desc.RasterizerState.MultisampleEnable, hash);
+	hash = Hash::value(desc.RasterizerState.AntialiasedLineEnable, hash);
+	hash = Hash::value(desc.RasterizerState.ForcedSampleCount, hash);
+	hash = Hash::value(desc.RasterizerState.ConservativeRaster, hash);
+
+	const auto hashStencilOp = [](const D3D12_DEPTH_STENCILOP_DESC& op, const CodeRed::UInt64 seed)
+	{
+		auto result = Hash::value(op.StencilFailOp, seed);
+
+		result = Hash::value(op.StencilDepthFailOp, result);
+		result = Hash::value(op.StencilPassOp, result);
+		result = Hash::value(op.StencilFunc, result);
+
+		return result;
+	};
+	
+	hash = Hash::value(desc.DepthStencilState.DepthEnable, hash);
+	hash = Hash::value(desc.DepthStencilState.DepthWriteMask, hash);
+	hash = Hash::value(desc.DepthStencilState.DepthFunc, hash);
+	hash = Hash::value(desc.DepthStencilState.StencilEnable, hash);
+	hash = Hash::value(desc.DepthStencilState.StencilReadMask, hash);
+	hash = Hash::value(desc.DepthStencilState.StencilWriteMask, hash);
+	hash = hashStencilOp(desc.DepthStencilState.FrontFace, hash);
+	hash = hashStencilOp(desc.DepthStencilState.BackFace, hash);
+	
+	hash = Hash::value(desc.SampleMask, hash);
+	hash = Hash::value(desc.IBStripCutValue, hash);
+	hash = Hash::value(desc.PrimitiveTopologyType, hash);
+	hash = Hash::value(desc.NumRenderTargets, hash);
+	hash = Hash::value(desc.RTVFormats, hash);
+	hash = Hash::value(desc.DSVFormat, hash);
+	hash = Hash::value(desc.SampleDesc.Count, hash);
+	hash = Hash::value(desc.SampleDesc.Quality, hash);
+	hash = Hash::value(desc.Flags, hash);
+
+	return hash;
+}
+
 CodeRed::DirectX12GraphicsPipeline::DirectX12GraphicsPipeline(
 	const std::shared_ptr<GpuLogicalDevice>& device,
 	const std::shared_ptr<GpuRenderPass>& render_pass,
@@ -36,12 +128,13 @@ CodeRed::DirectX12GraphicsPipeline::DirectX12GraphicsPipeline(
 		rasterization_state
 	)
 {
-	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get())->device();
+	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get());
+	const auto dxResourceLayout = static_cast<DirectX12ResourceLayout*>(mResourceLayout.get());
 	
 	D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = {};
 	
 	desc.PrimitiveTopologyType = enumConvert1(mInputAssemblyState->primitiveTopology());
-	desc.pRootSignature = static_cast<DirectX12ResourceLayout*>(mResourceLayout.get())->rootSignature().Get();
+	desc.pRootSignature = dxResourceLayout->rootSignature().Get();
 	desc.InputLayout = static_cast<DirectX12InputAssemblyState*>(mInputAssemblyState.get())->layout();
 	desc.VS = static_cast<DirectX12ShaderState*>(mVertexShaderState.get())->shader();
 	desc.PS = static_cast<DirectX12ShaderState*>(mPixelShaderState.get())->shader();
@@ -60,10 +153,13 @@ CodeRed::DirectX12GraphicsPipeline::DirectX12GraphicsPipeline(
 	for (size_t index = 0; index < mRenderPass->size(); index++) 
 		desc.RTVFormats[index] = enumConvert(mRenderPass->color(index)->Format);
 	
-	CODE_RED_THROW_IF_FAILED(
-		dxDevice->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&mGraphicsPipeline)),
-		FailedException(DebugType::Create, { "ID3D12Pipeline of Graphics" })
-	);
+	mGraphicsPipeline = dxDevice->createGraphicsPipelineState(desc,
+		hashPipelineStateDesc(desc, dxResourceLayout->rootSignatureHash()));
+}
+
+CodeRed::DirectX12GraphicsPipeline::~DirectX12GraphicsPipeline()
+{
+	mDevice->deferDestruction([pipeline = mGraphicsPipeline]() mutable { pipeline.Reset(); });
 }
 
 #endif
\ No newline at end of file
@@ -20,7 +20,7 @@ namespace CodeRed {
 			const std::shared_ptr<GpuBlendState>& blend_state,
 			const std::shared_ptr<GpuRasterizationState>& rasterization_state);
 
-		~DirectX12GraphicsPipeline() = default;
+		~DirectX12GraphicsPipeline();
 
 		auto pipeline() const noexcept -> WRL::ComPtr<ID3D12PipelineState> { return mGraphicsPipeline; }
 	private:
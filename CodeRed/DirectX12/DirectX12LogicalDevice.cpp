@@ -1,6 +1,7 @@
 #include "DirectX12PipelineState/DirectX12PipelineFactory.hpp"
 
 #include "../Shared/Exception/FailedException.hpp"
+#include "../Shared/IndirectArguments.hpp"
 #include "../Shared/DebugReport.hpp"
 
 #include "DirectX12Resource/DirectX12TextureBuffer.hpp"
@@ -10,9 +11,12 @@
 
 #include "DirectX12GraphicsCommandList.hpp"
 #include "DirectX12GraphicsPipeline.hpp"
+#include "DirectX12ComputePipeline.hpp"
+#include "DirectX12GraphicsBundle.hpp"
 #include "DirectX12CommandAllocator.hpp"
 #include "DirectX12DisplayAdapter.hpp"
 #include "DirectX12ResourceLayout.hpp"
+#include "DirectX12TextureBlitter.hpp"
 #include "DirectX12DescriptorHeap.hpp"
 #include "DirectX12LogicalDevice.hpp"
 #include "DirectX12CommandQueue.hpp"
@@ -47,6 +51,39 @@ CodeRed::DirectX12LogicalDevice::DirectX12LogicalDevice(const std::shared_ptr<Gp
 		D3D12CreateDevice(dxgiAdapter->adapter().Get(), D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&mDevice)),
 		FailedException(DebugType::Create, { "ID3D12Device" })
 	);
+
+	//the pipeline library needs ID3D12Device1, if it is not supported we do not cache the pipelines
+	if (mDevice->QueryInterface(IID_PPV_ARGS(&mDevice1)) != S_OK ||
+		mDevice1->CreatePipelineLibrary(nullptr, 0, IID_PPV_ARGS(&mPipelineLibrary)) != S_OK) {
+		mPipelineLibrary.Reset();
+
+		DebugReport::warning(DebugType::Create, { "ID3D12PipelineLibrary" });
+	}
+
+	//the command signatures only have draw arguments, so they do not need root signature
+	D3D12_INDIRECT_ARGUMENT_DESC argumentDesc = {};
+	D3D12_COMMAND_SIGNATURE_DESC signatureDesc = {};
+
+	argumentDesc.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW;
+
+	signatureDesc.ByteStride = static_cast<UINT>(sizeof(DrawIndirectArguments));
+	signatureDesc.NumArgumentDescs = 1;
+	signatureDesc.pArgumentDescs = &argumentDesc;
+	signatureDesc.NodeMask = 0;
+
+	CODE_RED_THROW_IF_FAILED(
+		mDevice->CreateCommandSignature(&signatureDesc, nullptr, IID_PPV_ARGS(&mDrawCommandSignature)),
+		FailedException(DebugType::Create, { "ID3D12CommandSignature" })
+	);
+
+	argumentDesc.Type = D3D12_INDIRECT_ARGUMENT_TYPE_DRAW_INDEXED;
+
+	signatureDesc.ByteStride = static_cast<UINT>(sizeof(DrawIndexedIndirectArguments));
+
+	CODE_RED_THROW_IF_FAILED(
+		mDevice->CreateCommandSignature(&signatureDesc, nullptr, IID_PPV_ARGS(&mDrawIndexedCommandSignature)),
+		FailedException(DebugType::Create, { "ID3D12CommandSignature" })
+	);
 }
 
 auto CodeRed::DirectX12LogicalDevice::createFence()
@@ -77,6 +114,13 @@ auto CodeRed::DirectX12LogicalDevice::createGraphicsCommandList(
 			allocator));
 }
 
+auto CodeRed::DirectX12LogicalDevice::createGraphicsBundle()
+	-> std::shared_ptr<GpuGraphicsBundle>
+{
+	return std::static_pointer_cast<GpuGraphicsBundle>(
+		std::make_shared<DirectX12GraphicsBundle>(shared_from_this()));
+}
+
 auto CodeRed::DirectX12LogicalDevice::createCommandQueue()
 	-> std::shared_ptr<GpuCommandQueue>
 {
@@ -116,6 +160,19 @@ auto CodeRed::DirectX12LogicalDevice::createGraphicsPipeline(
 			));
 }
 
+auto CodeRed::DirectX12LogicalDevice::createComputePipeline(
+	const std::shared_ptr<GpuResourceLayout>& resource_layout,
+	const std::shared_ptr<GpuShaderState>& compute_shader_state)
+	-> std::shared_ptr<GpuComputePipeline>
+{
+	return std::static_pointer_cast<GpuComputePipeline>(
+		std::make_shared<DirectX12ComputePipeline>(
+			shared_from_this(),
+			resource_layout,
+			compute_shader_state
+			));
+}
+
 auto CodeRed::DirectX12LogicalDevice::createResourceLayout(
 	const std::vector<ResourceLayoutElement>& elements,
 	const std::vector<SamplerLayoutElement>& samplers,
@@ -219,5 +276,147 @@ auto CodeRed::DirectX12LogicalDevice::createPipelineFactory()
 		std::make_shared<DirectX12PipelineFactory>(shared_from_this()));
 }
 
+auto CodeRed::DirectX12LogicalDevice::isFormatSupported(
+	const PixelFormat format, 
+	const ResourceUsage usage)
+	-> bool
+{
+	if (format == PixelFormat::Unknown) return false;
+	
+	D3D12_FEATURE_DATA_FORMAT_SUPPORT support = {
+		enumConvert(format),
+		D3D12_FORMAT_SUPPORT1_NONE,
+		D3D12_FORMAT_SUPPORT2_NONE
+	};
+
+	if (FAILED(mDevice->CheckFeatureSupport(D3D12_FEATURE_FORMAT_SUPPORT, &support, sizeof(support)))) return false;
+
+	if (enumHas(usage, ResourceUsage::VertexBuffer) &&
+		!(support.Support1 & D3D12_FORMAT_SUPPORT1_IA_VERTEX_BUFFER)) return false;
+
+	if (usage == ResourceUsage::VertexBuffer) return true;
+
+	auto required = D3D12_FORMAT_SUPPORT1_TEXTURE2D;
+
+	if (enumHas(usage, ResourceUsage::RenderTarget)) required = required | D3D12_FORMAT_SUPPORT1_RENDER_TARGET;
+	if (enumHas(usage, ResourceUsage::DepthStencil)) required = required | D3D12_FORMAT_SUPPORT1_DEPTH_STENCIL;
+
+	//the render target and depth stencil need not be sampled, so we only check sampling for other textures
+	//the depth formats can not be sampled directly, they are sampled with the typeless formats
+	if (required == D3D12_FORMAT_SUPPORT1_TEXTURE2D) required = required | D3D12_FORMAT_SUPPORT1_SHADER_SAMPLE;
+
+	return (support.Support1 & required) == required;
+}
+
+auto CodeRed::DirectX12LogicalDevice::textureBlitter() -> std::shared_ptr<DirectX12TextureBlitter>
+{
+	std::lock_guard<std::mutex> lock(mTextureBlitterMutex);
+
+	if (mTextureBlitter == nullptr) mTextureBlitter = std::make_shared<DirectX12TextureBlitter>(mDevice);
+
+	return mTextureBlitter;
+}
+
+auto CodeRed::DirectX12LogicalDevice::createGraphicsPipelineState(
+	const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+	const UInt64 key)
+	-> WRL::ComPtr<ID3D12PipelineState>
+{
+	WRL::ComPtr<ID3D12PipelineState> pipelineState;
+
+	const auto name = std::to_wstring(key);
+
+	{
+		std::lock_guard<std::mutex> lock(mPipelineLibraryMutex);
+
+		//if the desc does not match the stored pipeline, LoadGraphicsPipeline will fail
+		//so we create the pipeline state again
+		if (mPipelineLibrary != nullptr &&
+			mPipelineLibrary->LoadGraphicsPipeline(name.c_str(), &desc, IID_PPV_ARGS(&pipelineState)) == S_OK)
+			return pipelineState;
+	}
+
+	//we do not hold the lock when we compile the pipeline, so the pipelines can be compiled in parallel
+	CODE_RED_THROW_IF_FAILED(
+		mDevice->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipelineState)),
+		FailedException(DebugType::Create, { "ID3D12Pipeline of Graphics" })
+	);
+
+	std::lock_guard<std::mutex> lock(mPipelineLibraryMutex);
+
+	//the name may be used by other pipeline(hash collision), we just do not cache this pipeline
+	if (mPipelineLibrary != nullptr) mPipelineLibrary->StorePipeline(name.c_str(), pipelineState.Get());
+
+	return pipelineState;
+}
+
+auto CodeRed::DirectX12LogicalDevice::createComputePipelineState(
+	const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+	const UInt64 key)
+	-> WRL::ComPtr<ID3D12PipelineState>
+{
+	WRL::ComPtr<ID3D12PipelineState> pipelineState;
+
+	const auto name = std::to_wstring(key);
+
+	{
+		std::lock_guard<std::mutex> lock(mPipelineLibraryMutex);
+
+		if (mPipelineLibrary != nullptr &&
+			mPipelineLibrary->LoadComputePipeline(name.c_str(), &desc, IID_PPV_ARGS(&pipelineState)) == S_OK)
+			return pipelineState;
+	}
+
+	CODE_RED_THROW_IF_FAILED(
+		mDevice->CreateComputePipelineState(&desc, IID_PPV_ARGS(&pipelineState)),
+		FailedException(DebugType::Create, { "ID3D12Pipeline of Compute" })
+	);
+
+	std::lock_guard<std::mutex> lock(mPipelineLibraryMutex);
+
+	if (mPipelineLibrary != nullptr) mPipelineLibrary->StorePipeline(name.c_str(), pipelineState.Get());
+
+	return pipelineState;
+}
+
+auto CodeRed::DirectX12LogicalDevice::pipelineCacheData() -> std::vector<Byte>
+{
+	std::lock_guard<std::mutex> lock(mPipelineLibraryMutex);
+
+	if (mPipelineLibrary == nullptr) return {};
+
+	std::vector<Byte> data(mPipelineLibrary->GetSerializedSize());
+
+	CODE_RED_THROW_IF_FAILED(
+		mPipelineLibrary->Serialize(data.data(), data.size()),
+		FailedException(DebugType::Get, { "data", "ID3D12PipelineLibrary" })
+	);
+
+	return data;
+}
+
+auto CodeRed::DirectX12LogicalDevice::setPipelineCacheData(const std::vector<Byte>& data) -> bool
+{
+	std::lock_guard<std::mutex> lock(mPipelineLibraryMutex);
+
+	if (mDevice1 == nullptr) return false;
+
+	WRL::ComPtr<ID3D12PipelineLibrary> pipelineLibrary;
+
+	auto pipelineLibraryData = data;
+
+	//the library will be rejected if the driver or adapter is changed
+	//(D3D12_ERROR_DRIVER_VERSION_MISMATCH or D3D12_ERROR_ADAPTER_NOT_FOUND), we keep current library
+	if (mDevice1->CreatePipelineLibrary(
+		pipelineLibraryData.data(), pipelineLibraryData.size(),
+		IID_PPV_ARGS(&pipelineLibrary)) != S_OK)
+		return false;
+
+	mPipelineLibrary = pipelineLibrary;
+	mPipelineLibraryData = std::move(pipelineLibraryData);
+
+	return true;
+}
+
 #endif
 
@@ -5,8 +5,12 @@
 
 #ifdef __ENABLE__DIRECTX12__
 
+#include <mutex>
+
 namespace CodeRed {
 
+	class DirectX12TextureBlitter;
+
 	class DirectX12LogicalDevice final : public GpuLogicalDevice {
 	public:
 		explicit DirectX12LogicalDevice(
@@ -25,6 +29,9 @@ namespace CodeRed {
 			const std::shared_ptr<GpuCommandAllocator>& allocator)
 			-> std::shared_ptr<GpuGraphicsCommandList> override;
 		
+		auto createGraphicsBundle()
+			-> std::shared_ptr<GpuGraphicsBundle> override;
+
 		auto createCommandQueue()
 			-> std::shared_ptr<GpuCommandQueue> override;
 
@@ -42,6 +49,11 @@ namespace CodeRed {
 			const std::shared_ptr<GpuRasterizationState>& rasterization_state)
 			-> std::shared_ptr<GpuGraphicsPipeline> override;
 
+		auto createComputePipeline(
+			const std::shared_ptr<GpuResourceLayout>& resource_layout,
+			const std::shared_ptr<GpuShaderState>& compute_shader_state)
+			-> std::shared_ptr<GpuComputePipeline> override;
+
 		auto createResourceLayout(
 			const std::vector<ResourceLayoutElement>& elements = {},
 			const std::vector<SamplerLayoutElement>& samplers = {},
@@ -83,10 +95,58 @@ namespace CodeRed {
 
 		auto createPipelineFactory()
 			-> std::shared_ptr<GpuPipelineFactory> override;
+
+		auto isFormatSupported(
+			const PixelFormat format,
+			const ResourceUsage usage = ResourceUsage::None)
+			-> bool override;
 		
 		auto device() const noexcept -> WRL::ComPtr<ID3D12Device> { return mDevice; }
+
+		auto drawCommandSignature() const noexcept -> WRL::ComPtr<ID3D12CommandSignature> { return mDrawCommandSignature; }
+
+		auto drawIndexedCommandSignature() const noexcept -> WRL::ComPtr<ID3D12CommandSignature> { return mDrawIndexedCommandSignature; }
+
+		/*
+		 * the blitter is used by generateMipmaps, it is created when we use it first time
+		 * because it compiles the shaders at runtime
+		 */
+		auto textureBlitter() -> std::shared_ptr<DirectX12TextureBlitter>;
+
+		/*
+		 * create the pipeline state with the pipeline library, the key is the hash of desc.
+		 * if the pipeline is not in the library, we create it and store it to the library.
+		 * if the pipeline library is not supported, we create the pipeline state directly.
+		 */
+		auto createGraphicsPipelineState(
+			const D3D12_GRAPHICS_PIPELINE_STATE_DESC& desc,
+			const UInt64 key)
+			-> WRL::ComPtr<ID3D12PipelineState>;
+
+		auto createComputePipelineState(
+			const D3D12_COMPUTE_PIPELINE_STATE_DESC& desc,
+			const UInt64 key)
+			-> WRL::ComPtr<ID3D12PipelineState>;
+	protected:
+		auto pipelineCacheData() -> std::vector<Byte> override;
+
+		auto setPipelineCacheData(const std::vector<Byte>& data) -> bool override;
 	private:
 		WRL::ComPtr<ID3D12Device> mDevice;
+		WRL::ComPtr<ID3D12Device1> mDevice1;
+
+		// the command signatures used by ExecuteIndirect, they only change the draw arguments
+		WRL::ComPtr<ID3D12CommandSignature> mDrawCommandSignature;
+		WRL::ComPtr<ID3D12CommandSignature> mDrawIndexedCommandSignature;
+
+		WRL::ComPtr<ID3D12PipelineLibrary> mPipelineLibrary;
+
+		// the pipeline library does not copy the data, so we need keep it until we release the library
+		std::vector<Byte> mPipelineLibraryData;
+		std::mutex mPipelineLibraryMutex;
+
+		std::shared_ptr<DirectX12TextureBlitter> mTextureBlitter;
+		std::mutex mTextureBlitterMutex;
 	};
 	
 }
@@ -1,7 +1,5 @@
 #include "DirectX12InputAssemblyState.hpp"
 
-#include "../../Shared/PixelFormatSizeOf.hpp"
-
 #ifdef __ENABLE__DIRECTX12__
 
 using namespace CodeRed::DirectX12;
@@ -12,20 +10,19 @@ CodeRed::DirectX12InputAssemblyState::DirectX12InputAssemblyState(
 	const PrimitiveTopology primitive_topology) :
 	GpuInputAssemblyState(device, elements, primitive_topology)
 {
-	auto offsetInBytes = std::vector<UINT>(mSlotCount);
-	
-	for (auto &element : mElements) {
+	for (size_t index = 0; index < mElements.size(); index++) {
+		const auto& element = mElements[index];
+		const auto perInstance = mRates[element.Slot] == InputRate::PerInstance;
+		
 		mInputLayoutElements.push_back({
 			element.Name.c_str(),
 			0,
 			enumConvert(element.Format),
 			static_cast<UINT>(element.Slot),
-			offsetInBytes[element.Slot],
-			D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
-			0
+			static_cast<UINT>(mOffsets[index]),
+			perInstance ? D3D12_INPUT_CLASSIFICATION_PER_INSTANCE_DATA : D3D12_INPUT_CLASSIFICATION_PER_VERTEX_DATA,
+			perInstance ? static_cast<UINT>(mStepRates[element.Slot]) : 0
 			});
-
-		offsetInBytes[element.Slot] = offsetInBytes[element.Slot] + static_cast<UINT>(PixelFormatSizeOf::get(element.Format));
 	}
 
 	mInputLayout.NumElements = static_cast<UINT>(mInputLayoutElements.size());
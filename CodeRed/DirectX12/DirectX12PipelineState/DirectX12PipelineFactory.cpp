@@ -22,11 +22,12 @@ auto CodeRed::DirectX12PipelineFactory::createInputAssemblyState(
 	const PrimitiveTopology primitive_topology)
 	-> std::shared_ptr<GpuInputAssemblyState>
 {
-	return std::static_pointer_cast<GpuInputAssemblyState>(
-		std::make_shared<DirectX12InputAssemblyState>(
-			mDevice,
-			elements,
-			primitive_topology));
+	return findOrCreate(mInputAssemblyStates,
+		inputAssemblyStateKey(elements, primitive_topology), [&]()
+		{
+			return std::static_pointer_cast<GpuInputAssemblyState>(
+				std::make_shared<DirectX12InputAssemblyState>(mDevice, elements, primitive_topology));
+		});
 }
 
 auto CodeRed::DirectX12PipelineFactory::createRasterizationState(
@@ -36,13 +37,12 @@ auto CodeRed::DirectX12PipelineFactory::createRasterizationState(
 	const bool depth_clamp)
 	-> std::shared_ptr<GpuRasterizationState>
 {
-	return std::static_pointer_cast<GpuRasterizationState>(
-		std::make_shared<DirectX12RasterizationState>(
-			mDevice,
-			front_face,
-			cull_mode,
-			fill_mode,
-			depth_clamp));
+	return findOrCreate(mRasterizationStates,
+		rasterizationStateKey(front_face, cull_mode, fill_mode, depth_clamp), [&]()
+		{
+			return std::static_pointer_cast<GpuRasterizationState>(
+				std::make_shared<DirectX12RasterizationState>(mDevice, front_face, cull_mode, fill_mode, depth_clamp));
+		});
 }
 
 auto CodeRed::DirectX12PipelineFactory::createDetphStencilState(
@@ -54,15 +54,19 @@ auto CodeRed::DirectX12PipelineFactory::createDetphStencilState(
 	const StencilOperatorInfo& back)
 	-> std::shared_ptr<GpuDepthStencilState>
 {
-	return std::static_pointer_cast<GpuDepthStencilState>(
-		std::make_shared<DirectX12DepthStencilState>(
-			mDevice,
-			depth_enable,
-			depth_write_enable,
-			stencil_enable,
-			depth_operator,
-			front,
-			back));
+	return findOrCreate(mDepthStencilStates,
+		depthStencilStateKey(depth_enable, depth_write_enable, stencil_enable, depth_operator, front, back), [&]()
+		{
+			return std::static_pointer_cast<GpuDepthStencilState>(
+				std::make_shared<DirectX12DepthStencilState>(
+					mDevice,
+					depth_enable,
+					depth_write_enable,
+					stencil_enable,
+					depth_operator,
+					front,
+					back));
+		});
 }
 
 auto CodeRed::DirectX12PipelineFactory::createShaderState(
@@ -71,21 +75,30 @@ auto CodeRed::DirectX12PipelineFactory::createShaderState(
 	const std::string& name)
 	-> std::shared_ptr<GpuShaderState>
 {
-	return std::static_pointer_cast<GpuShaderState>(
-		std::make_shared<DirectX12ShaderState>(mDevice, type, code, name));
+	return findOrCreate(mShaderStates,
+		shaderStateKey(type, code, name), [&]()
+		{
+			return std::static_pointer_cast<GpuShaderState>(
+				std::make_shared<DirectX12ShaderState>(mDevice, type, code, name));
+		});
 }
 
 auto CodeRed::DirectX12PipelineFactory::createBlendState(
 	const std::vector<BlendProperty>& properties) ->
 	std::shared_ptr<GpuBlendState>
 {
-	return std::make_shared<DirectX12BlendState>(mDevice, properties);
+	return findOrCreate(mBlendStates,
+		blendStateKey(properties), [&]()
+		{
+			return std::static_pointer_cast<GpuBlendState>(
+				std::make_shared<DirectX12BlendState>(mDevice, properties));
+		});
 }
 
 auto CodeRed::DirectX12PipelineFactory::createBlendState(
 	const size_t numRenderTargets) -> std::shared_ptr<GpuBlendState>
-{	
-	return std::make_shared<DirectX12BlendState>(mDevice, std::vector<BlendProperty>(numRenderTargets));
+{
+	return createBlendState(std::vector<BlendProperty>(numRenderTargets));
 }
 
 #endif
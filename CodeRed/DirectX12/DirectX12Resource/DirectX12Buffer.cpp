@@ -27,6 +27,10 @@ CodeRed::DirectX12Buffer::DirectX12Buffer(
 	desc.Layout = D3D12_TEXTURE_LAYOUT_ROW_MAJOR;
 	desc.Flags = enumConvert(mInfo.Usage);
 
+	//the group buffer in default heap can be bound as read-write group buffer
+	if (mInfo.Type == ResourceType::GroupBuffer && mInfo.Heap == MemoryHeap::Default)
+		desc.Flags |= D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS;
+
 	D3D12_HEAP_PROPERTIES heapProperties = {
 		enumConvert(mInfo.Heap),
 		D3D12_CPU_PAGE_PROPERTY_UNKNOWN,
@@ -47,10 +51,29 @@ CodeRed::DirectX12Buffer::DirectX12Buffer(
 		),
 		FailedException(DebugType::Create, { "ID3D12Resource of Buffer" })
 	);
+
+	// the buffer in upload or readback heap is mapped persistently
+	// so we do not need to map it when we update or read it every frame
+	if (mInfo.Heap != MemoryHeap::Default) {
+		CODE_RED_THROW_IF_FAILED(
+			mBuffer->Map(0, nullptr, &mMappedMemory),
+			FailedException(DebugType::Get, { "Mapped Memory", "ID3D12Resource of Buffer" })
+		);
+	}
+}
+
+CodeRed::DirectX12Buffer::~DirectX12Buffer()
+{
+	if (mMappedMemory != nullptr) mBuffer->Unmap(0, nullptr);
+
+	// the buffer may be used by the submissions in flight, so we release it after they are finished
+	mDevice->deferDestruction([buffer = mBuffer]() mutable { buffer.Reset(); });
 }
 
 auto CodeRed::DirectX12Buffer::mapMemory() const -> void* 
 {
+	if (mMappedMemory != nullptr) return mMappedMemory;
+	
 	void* data = nullptr;
 
 	mBuffer->Map(0, nullptr, &data);
@@ -60,7 +83,22 @@ auto CodeRed::DirectX12Buffer::mapMemory() const -> void*
 
 void CodeRed::DirectX12Buffer::unmapMemory() const
 {
+	// the persistently mapped memory is unmapped when we destroy the buffer
+	if (mMappedMemory != nullptr) return;
+	
 	mBuffer->Unmap(0, nullptr);
 }
 
+void CodeRed::DirectX12Buffer::flush(const size_t offset, const size_t size) const
+{
+	// the memory of upload heap in DirectX12 is always coherent
+	// so we do not need to flush it
+}
+
+void CodeRed::DirectX12Buffer::invalidate(const size_t offset, const size_t size) const
+{
+	// the memory of upload heap in DirectX12 is always coherent
+	// so we do not need to invalidate it
+}
+
 #endif
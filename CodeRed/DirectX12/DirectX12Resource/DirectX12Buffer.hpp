@@ -13,11 +13,15 @@ namespace CodeRed {
 			const std::shared_ptr<GpuLogicalDevice>& device,
 			const ResourceInfo info);
 
-		~DirectX12Buffer() = default;
+		~DirectX12Buffer();
 
 		auto mapMemory() const -> void* override;
 
 		void unmapMemory() const override;
+
+		void flush(const size_t offset, const size_t size) const override;
+
+		void invalidate(const size_t offset, const size_t size) const override;
 		
 		auto buffer() const noexcept -> WRL::ComPtr<ID3D12Resource> { return mBuffer; }
 	private:
@@ -83,7 +83,8 @@ CodeRed::DirectX12Texture::DirectX12Texture(
 	const WRL::ComPtr<ID3D12Resource>& texture,
 	const ResourceInfo& info) :
 	GpuTexture(device, info),
-	mTexture(texture)
+	mTexture(texture),
+	mBackBuffer(true)
 {
 	const auto dxDevice = static_cast<DirectX12LogicalDevice*>(mDevice.get())->device();
 	const auto dxDesc = texture->GetDesc();
@@ -95,6 +96,13 @@ CodeRed::DirectX12Texture::DirectX12Texture(
 	mAlignment = static_cast<size_t>(allocateInfo.Alignment);
 }
 
+CodeRed::DirectX12Texture::~DirectX12Texture()
+{
+	if (mBackBuffer) return;
+
+	mDevice->deferDestruction([texture = mTexture]() mutable { texture.Reset(); });
+}
+
 auto CodeRed::DirectX12Texture::reference(const TextureRefInfo& info) -> std::shared_ptr<GpuTextureRef>
 {
 	return std::make_shared<DirectX12TextureRef>(
@@ -18,13 +18,16 @@ namespace CodeRed {
 			const WRL::ComPtr<ID3D12Resource>& texture,
 			const ResourceInfo& info);
 
-		~DirectX12Texture() = default;
+		~DirectX12Texture();
 
 		auto reference(const TextureRefInfo& info) -> std::shared_ptr<GpuTextureRef> override;
 		
 		auto texture() const noexcept -> WRL::ComPtr<ID3D12Resource> { return mTexture; }
 	private:
 		WRL::ComPtr<ID3D12Resource> mTexture;
+
+		// the back buffer is released by swap chain before it resizes, so we do not defer it
+		bool mBackBuffer = false;
 	};
 	
 }
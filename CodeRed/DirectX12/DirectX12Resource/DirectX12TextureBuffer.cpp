@@ -18,8 +18,9 @@ CodeRed::DirectX12TextureBuffer::DirectX12TextureBuffer(
 
 	desc.Dimension = enumConvert(mInfo.Dimension);
 	desc.Alignment = 0;
-	desc.Width = mInfo.Width;
-	desc.Height = static_cast<UINT>(mInfo.Height);
+	//the size of compressed texture must be multiple of block size
+	desc.Width = PixelFormatSizeOf::blockAlign(mInfo.Format, mInfo.Width);
+	desc.Height = static_cast<UINT>(PixelFormatSizeOf::blockAlign(mInfo.Format, mInfo.Height));
 	desc.DepthOrArraySize = static_cast<UINT16>(mInfo.Depth);
 	desc.MipLevels = 1;
 	desc.Format = enumConvert(mInfo.Format);
@@ -68,10 +69,15 @@ CodeRed::DirectX12TextureBuffer::DirectX12TextureBuffer(
 {
 }
 
+CodeRed::DirectX12TextureBuffer::~DirectX12TextureBuffer()
+{
+	mDevice->deferDestruction([texture = mTexture]() mutable { texture.Reset(); });
+}
+
 auto CodeRed::DirectX12TextureBuffer::read(const Extent3D<size_t>& extent) const -> std::vector<Byte>
 {
-	const auto rowPitch = mInfo.Width * PixelFormatSizeOf::get(mInfo.Format);
-	const auto depthPitch = rowPitch * mInfo.Height;
+	const auto rowPitch = PixelFormatSizeOf::rowPitch(mInfo.Format, mInfo.Width);
+	const auto depthPitch = rowPitch * PixelFormatSizeOf::rowCount(mInfo.Format, mInfo.Height);
 	const auto region = convert(extent);
 	
 	std::vector<Byte> data(mInfo.Size);
@@ -86,13 +92,16 @@ auto CodeRed::DirectX12TextureBuffer::read(const Extent3D<size_t>& extent) const
 
 auto CodeRed::DirectX12TextureBuffer::read() const -> std::vector<Byte>
 {
-	return read({ 0,0,0, width(), height(), depth() });
+	return read({ 0,0,0,
+		PixelFormatSizeOf::blockAlign(mInfo.Format, width()),
+		PixelFormatSizeOf::blockAlign(mInfo.Format, height()),
+		depth() });
 }
 
 void CodeRed::DirectX12TextureBuffer::write(const Extent3D<size_t>& extent, const void* data)
 {
-	const auto rowPitch = mInfo.Width * PixelFormatSizeOf::get(mInfo.Format);
-	const auto depthPitch = rowPitch * mInfo.Height;
+	const auto rowPitch = PixelFormatSizeOf::rowPitch(mInfo.Format, mInfo.Width);
+	const auto depthPitch = rowPitch * PixelFormatSizeOf::rowCount(mInfo.Format, mInfo.Height);
 	const auto region = convert(extent);
 	
 	mTexture->WriteToSubresource(0, &region, data,
@@ -102,7 +111,15 @@ void CodeRed::DirectX12TextureBuffer::write(const Extent3D<size_t>& extent, cons
 
 void CodeRed::DirectX12TextureBuffer::write(const void* data)
 {
-	write({ 0,0,0, width(), height(), depth() }, data);
+	write({ 0,0,0,
+		PixelFormatSizeOf::blockAlign(mInfo.Format, width()),
+		PixelFormatSizeOf::blockAlign(mInfo.Format, height()),
+		depth() }, data);
+}
+
+void CodeRed::DirectX12TextureBuffer::flush() const
+{
+	//the texture buffer is not mapped, WriteToSubresource writes the memory directly
 }
 
 #endif
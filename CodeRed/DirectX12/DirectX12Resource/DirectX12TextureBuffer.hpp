@@ -18,7 +18,7 @@ namespace CodeRed {
 			const std::shared_ptr<GpuTexture>& texture,
 			const size_t mipSlice = 0);
 		
-		~DirectX12TextureBuffer() = default;
+		~DirectX12TextureBuffer();
 
 		auto read(const Extent3D<size_t>& extent) const -> std::vector<Byte> override;
 		
@@ -28,6 +28,8 @@ namespace CodeRed {
 		
 		void write(const void* data) override;
 
+		void flush() const override;
+
 		auto texture() const noexcept -> WRL::ComPtr<ID3D12Resource> { return mTexture; }
 	private:
 		WRL::ComPtr<ID3D12Resource> mTexture;
@@ -1,5 +1,6 @@
 #include "../Shared/Exception/InvalidException.hpp"
 #include "../Shared/Exception/FailedException.hpp"
+#include "../Shared/Hash.hpp"
 
 #include "DirectX12Resource/DirectX12Texture.hpp"
 #include "DirectX12Resource/DirectX12Sampler.hpp"
@@ -28,8 +29,9 @@ CodeRed::DirectX12ResourceLayout::DirectX12ResourceLayout(
 	size_t index = 0;
 
 	for (auto& element : mElements) {
+		//the read-write group buffer is bound as unordered access view
 		ranges[index++] = {
-			enumConvert(element.Type),
+			element.ReadWrite ? D3D12_DESCRIPTOR_RANGE_TYPE_UAV : enumConvert(element.Type),
 			1,
 			static_cast<UINT>(element.Binding),
 			static_cast<UINT>(element.Space),
@@ -109,6 +111,8 @@ CodeRed::DirectX12ResourceLayout::DirectX12ResourceLayout(
 			IID_PPV_ARGS(&mRootSignature)),
 		FailedException(DebugType::Create, { "ID3D12RootSignature" })
 	);
+
+	mRootSignatureHash = Hash::bytes(rootBlob->GetBufferPointer(), rootBlob->GetBufferSize());
 }
 
 #endif
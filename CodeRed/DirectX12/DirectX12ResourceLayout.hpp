@@ -22,12 +22,17 @@ namespace CodeRed {
 
 		auto rootSignature() const noexcept -> WRL::ComPtr<ID3D12RootSignature> { return mRootSignature; }
 
+		auto rootSignatureHash() const noexcept -> UInt64 { return mRootSignatureHash; }
+
 		auto elementsIndex() const noexcept -> size_t { return mElementsIndex; }
 
 		auto constant32BitsIndex() const noexcept -> size_t { return mConstant32BitsIndex; }
 	private:
 		WRL::ComPtr<ID3D12RootSignature> mRootSignature;
 
+		// the hash of serialized root signature, it is a part of the key of pipeline library
+		UInt64 mRootSignatureHash = 0;
+
 		size_t mElementsIndex = 0;
 		size_t mConstant32BitsIndex = 1;
 	};
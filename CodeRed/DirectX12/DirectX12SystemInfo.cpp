@@ -37,18 +37,26 @@ auto CodeRed::DirectX12SystemInfo::selectDisplayAdapter() const -> std::vector<s
 			continue;
 		}
 
+		//the version of user mode driver, it is used to reject the stale pipeline cache
+		LARGE_INTEGER driverVersion = {};
+
+		if (adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion) != S_OK)
+			driverVersion.QuadPart = 0;
+
 		CODE_RED_DEBUG_LOG(DebugReport::make("adapter [0] --------", { std::to_string(index - 1) }));
 		CODE_RED_DEBUG_LOG("device name  : " + wideStringToMultiString(desc.Description));
 		CODE_RED_DEBUG_LOG("device id    : " + std::to_string(desc.DeviceId));
 		CODE_RED_DEBUG_LOG("vendor id    : " + std::to_string(desc.VendorId));
 		CODE_RED_DEBUG_LOG("video memory : " + std::to_string(desc.DedicatedVideoMemory));
 		CODE_RED_DEBUG_LOG("revision     : " + std::to_string(desc.Revision));
+		CODE_RED_DEBUG_LOG("driver       : " + std::to_string(driverVersion.QuadPart));
 		CODE_RED_DEBUG_LOG("");
 
 		display_adapters.push_back(
 			std::make_shared<DirectX12DisplayAdapter>(
 				adapter,
-				wideStringToMultiString(desc.Description), desc.DeviceId, desc.VendorId));
+				wideStringToMultiString(desc.Description), desc.DeviceId, desc.VendorId,
+				static_cast<size_t>(driverVersion.QuadPart)));
 
 	}
 
@@ -0,0 +1,234 @@
+#include "../Shared/Exception/FailedException.hpp"
+
+#include "DirectX12TextureBlitter.hpp"
+
+#include <cstring>
+
+#ifdef __ENABLE__DIRECTX12__
+
+using namespace CodeRed::DirectX12;
+
+// the vertex shader draws a full screen triangle without vertex buffer
+// the Rect is the region of source in texture coordinates(left, top, right, bottom)
+static const char* blitShaderCode = R"(
+cbuffer BlitConstants : register(b0)
+{
+	float4 Rect;
+	uint Filter;
+};
+
+Texture2DArray<float4> Source : register(t0);
+
+SamplerState PointSampler : register(s0);
+SamplerState LinearSampler : register(s1);
+
+struct Output
+{
+	float4 Position : SV_POSITION;
+	float2 TexCoord : TEXCOORD;
+};
+
+Output vs_main(uint id : SV_VertexID)
+{
+	const float2 uv = float2((id << 1) & 2, id & 2);
+
+	Output output;
+
+	output.Position = float4(uv * float2(2, -2) + float2(-1, 1), 0, 1);
+	output.TexCoord = Rect.xy + (Rect.zw - Rect.xy) * uv;
+
+	return output;
+}
+
+float4 ps_main(Output input) : SV_TARGET
+{
+	if (Filter != 0) return Source.SampleLevel(LinearSampler, float3(input.TexCoord, 0), 0);
+	
+	return Source.SampleLevel(PointSampler, float3(input.TexCoord, 0), 0);
+}
+)";
+
+static auto compileBlitShader(const char* entry, const char* target) -> WRL::ComPtr<ID3DBlob>
+{
+	WRL::ComPtr<ID3DBlob> code;
+	WRL::ComPtr<ID3DBlob> error;
+
+	CODE_RED_THROW_IF_FAILED(
+		D3DCompile(blitShaderCode, std::strlen(blitShaderCode), nullptr, nullptr, nullptr,
+			entry, target, D3DCOMPILE_OPTIMIZATION_LEVEL3, 0, code.GetAddressOf(), error.GetAddressOf()),
+		FailedException(DebugType::Create, { "Shader of DirectX12TextureBlitter" })
+	);
+
+	return code;
+}
+
+CodeRed::DirectX12TextureBlitter::DirectX12TextureBlitter(
+	const WRL::ComPtr<ID3D12Device>& device) :
+	mDevice(device)
+{
+	mVertexShader = compileBlitShader("vs_main", "vs_5_0");
+	mPixelShader = compileBlitShader("ps_main", "ps_5_0");
+
+	const D3D12_DESCRIPTOR_RANGE range = {
+		D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 1, 0, 0, 0
+	};
+
+	D3D12_ROOT_PARAMETER parameters[2];
+
+	parameters[0].ParameterType = D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE;
+	parameters[0].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+	parameters[0].DescriptorTable.NumDescriptorRanges = 1;
+	parameters[0].DescriptorTable.pDescriptorRanges = &range;
+
+	parameters[1].ParameterType = D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS;
+	parameters[1].ShaderVisibility = D3D12_SHADER_VISIBILITY_ALL;
+	parameters[1].Constants.Num32BitValues = 5;
+	parameters[1].Constants.ShaderRegister = 0;
+	parameters[1].Constants.RegisterSpace = 0;
+
+	D3D12_STATIC_SAMPLER_DESC samplers[2] = {};
+
+	for (UINT index = 0; index < 2; index++) {
+		samplers[index].Filter = index == 0 ? D3D12_FILTER_MIN_MAG_MIP_POINT : D3D12_FILTER_MIN_MAG_MIP_LINEAR;
+		samplers[index].AddressU = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+		samplers[index].AddressV = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+		samplers[index].AddressW = D3D12_TEXTURE_ADDRESS_MODE_CLAMP;
+		samplers[index].MaxAnisotropy = 1;
+		samplers[index].ComparisonFunc = D3D12_COMPARISON_FUNC_NEVER;
+		samplers[index].BorderColor = D3D12_STATIC_BORDER_COLOR_TRANSPARENT_BLACK;
+		samplers[index].MinLOD = 0;
+		samplers[index].MaxLOD = D3D12_FLOAT32_MAX;
+		samplers[index].ShaderRegister = index;
+		samplers[index].RegisterSpace = 0;
+		samplers[index].ShaderVisibility = D3D12_SHADER_VISIBILITY_PIXEL;
+	}
+
+	D3D12_ROOT_SIGNATURE_DESC desc = {};
+
+	desc.NumParameters = 2;
+	desc.pParameters = parameters;
+	desc.NumStaticSamplers = 2;
+	desc.pStaticSamplers = samplers;
+	desc.Flags = D3D12_ROOT_SIGNATURE_FLAG_NONE;
+
+	WRL::ComPtr<ID3DBlob> rootBlob;
+	WRL::ComPtr<ID3DBlob> errorBlob;
+
+	CODE_RED_THROW_IF_FAILED(
+		D3D12SerializeRootSignature(&desc, D3D_ROOT_SIGNATURE_VERSION_1,
+			rootBlob.GetAddressOf(), errorBlob.GetAddressOf()),
+		FailedException(DebugType::Create, { "SerializeRootSignature" })
+	);
+
+	CODE_RED_THROW_IF_FAILED(
+		mDevice->CreateRootSignature(0,
+			rootBlob->GetBufferPointer(),
+			rootBlob->GetBufferSize(),
+			IID_PPV_ARGS(&mRootSignature)),
+		FailedException(DebugType::Create, { "ID3D12RootSignature" })
+	);
+}
+
+void CodeRed::DirectX12TextureBlitter::blit(
+	ID3D12GraphicsCommandList* commandList,
+	const DirectX12BlitInfo& source,
+	const DirectX12BlitInfo& destination,
+	const bool linear,
+	const D3D12_CPU_DESCRIPTOR_HANDLE srvCpuHandle,
+	const D3D12_GPU_DESCRIPTOR_HANDLE srvGpuHandle,
+	const D3D12_CPU_DESCRIPTOR_HANDLE rtvCpuHandle)
+{
+	// we always use the Texture2DArray view, so the texture array and cube map can be blitted too
+	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+
+	srvDesc.Format = source.Format;
+	srvDesc.ViewDimension = D3D12_SRV_DIMENSION_TEXTURE2DARRAY;
+	srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
+	srvDesc.Texture2DArray.MostDetailedMip = source.MipSlice;
+	srvDesc.Texture2DArray.MipLevels = 1;
+	srvDesc.Texture2DArray.FirstArraySlice = source.ArraySlice;
+	srvDesc.Texture2DArray.ArraySize = 1;
+	srvDesc.Texture2DArray.PlaneSlice = 0;
+	srvDesc.Texture2DArray.ResourceMinLODClamp = 0;
+
+	D3D12_RENDER_TARGET_VIEW_DESC rtvDesc = {};
+
+	rtvDesc.Format = destination.Format;
+	rtvDesc.ViewDimension = D3D12_RTV_DIMENSION_TEXTURE2DARRAY;
+	rtvDesc.Texture2DArray.MipSlice = destination.MipSlice;
+	rtvDesc.Texture2DArray.FirstArraySlice = destination.ArraySlice;
+	rtvDesc.Texture2DArray.ArraySize = 1;
+	rtvDesc.Texture2DArray.PlaneSlice = 0;
+
+	mDevice->CreateShaderResourceView(source.Resource, &srvDesc, srvCpuHandle);
+	mDevice->CreateRenderTargetView(destination.Resource, &rtvDesc, rtvCpuHandle);
+
+	const D3D12_VIEWPORT viewPort = {
+		static_cast<FLOAT>(destination.Region.left),
+		static_cast<FLOAT>(destination.Region.top),
+		static_cast<FLOAT>(destination.Region.right - destination.Region.left),
+		static_cast<FLOAT>(destination.Region.bottom - destination.Region.top),
+		0.0f, 1.0f
+	};
+
+	const float rect[4] = {
+		static_cast<float>(source.Region.left) / static_cast<float>(source.Width),
+		static_cast<float>(source.Region.top) / static_cast<float>(source.Height),
+		static_cast<float>(source.Region.right) / static_cast<float>(source.Width),
+		static_cast<float>(source.Region.bottom) / static_cast<float>(source.Height)
+	};
+
+	UINT constants[5] = { 0, 0, 0, 0, linear ? 1u : 0u };
+
+	std::memcpy(constants, rect, sizeof(rect));
+
+	commandList->SetPipelineState(pipelineState(destination.Format).Get());
+	commandList->SetGraphicsRootSignature(mRootSignature.Get());
+	commandList->SetGraphicsRootDescriptorTable(0, srvGpuHandle);
+	commandList->SetGraphicsRoot32BitConstants(1, 5, constants, 0);
+	commandList->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
+	commandList->OMSetRenderTargets(1, &rtvCpuHandle, false, nullptr);
+	commandList->RSSetViewports(1, &viewPort);
+	commandList->RSSetScissorRects(1, &destination.Region);
+	commandList->DrawInstanced(3, 1, 0, 0);
+}
+
+auto CodeRed::DirectX12TextureBlitter::pipelineState(const DXGI_FORMAT format)
+	-> WRL::ComPtr<ID3D12PipelineState>
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	const auto it = mPipelineStates.find(format);
+
+	if (it != mPipelineStates.end()) return it->second;
+
+	D3D12_GRAPHICS_PIPELINE_STATE_DESC desc = {};
+
+	desc.pRootSignature = mRootSignature.Get();
+	desc.VS = { mVertexShader->GetBufferPointer(), mVertexShader->GetBufferSize() };
+	desc.PS = { mPixelShader->GetBufferPointer(), mPixelShader->GetBufferSize() };
+	desc.BlendState.RenderTarget[0].RenderTargetWriteMask = D3D12_COLOR_WRITE_ENABLE_ALL;
+	desc.SampleMask = UINT_MAX;
+	desc.RasterizerState.FillMode = D3D12_FILL_MODE_SOLID;
+	desc.RasterizerState.CullMode = D3D12_CULL_MODE_NONE;
+	desc.RasterizerState.DepthClipEnable = TRUE;
+	desc.DepthStencilState.DepthEnable = FALSE;
+	desc.DepthStencilState.StencilEnable = FALSE;
+	desc.PrimitiveTopologyType = D3D12_PRIMITIVE_TOPOLOGY_TYPE_TRIANGLE;
+	desc.NumRenderTargets = 1;
+	desc.RTVFormats[0] = format;
+	desc.DSVFormat = DXGI_FORMAT_UNKNOWN;
+	desc.SampleDesc.Count = 1;
+	desc.SampleDesc.Quality = 0;
+
+	WRL::ComPtr<ID3D12PipelineState> pipeline;
+
+	CODE_RED_THROW_IF_FAILED(
+		mDevice->CreateGraphicsPipelineState(&desc, IID_PPV_ARGS(&pipeline)),
+		FailedException(DebugType::Create, { "ID3D12PipelineState of DirectX12TextureBlitter" })
+	);
+
+	return mPipelineStates[format] = pipeline;
+}
+
+#endif
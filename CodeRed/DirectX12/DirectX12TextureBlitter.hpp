@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../Shared/Noncopyable.hpp"
+#include "DirectX12Utility.hpp"
+
+#ifdef __ENABLE__DIRECTX12__
+
+#include <mutex>
+#include <map>
+
+namespace CodeRed {
+
+	/*
+	 * a sub-texture and the region of it we blit from or to
+	 * the Width and Height are the size of sub-texture, they are used to compute the texture coordinates
+	 */
+	struct DirectX12BlitInfo {
+		ID3D12Resource* Resource = nullptr;
+		DXGI_FORMAT Format = DXGI_FORMAT_UNKNOWN;
+
+		UINT MipSlice = 0;
+		UINT ArraySlice = 0;
+
+		UINT Width = 0;
+		UINT Height = 0;
+
+		D3D12_RECT Region = {};
+
+		DirectX12BlitInfo() = default;
+	};
+
+	/*
+	 * DirectX12 does not have the blit command, so we draw a full screen triangle to blit a texture
+	 * the pixel shader samples the source with point or linear sampler and writes to the render target of destination
+	 * the pipeline states are created for each format of destination and cached
+	 * the source should be PIXEL_SHADER_RESOURCE state and the destination should be RENDER_TARGET state
+	 */
+	class DirectX12TextureBlitter final : public Noncopyable {
+	public:
+		explicit DirectX12TextureBlitter(
+			const WRL::ComPtr<ID3D12Device>& device);
+
+		~DirectX12TextureBlitter() = default;
+
+		/*
+		 * blit the source to destination, srv and rtv are the descriptors we use to create the views
+		 * the descriptor heap of srv should be set to command list before we blit
+		 */
+		void blit(
+			ID3D12GraphicsCommandList* commandList,
+			const DirectX12BlitInfo& source,
+			const DirectX12BlitInfo& destination,
+			const bool linear,
+			const D3D12_CPU_DESCRIPTOR_HANDLE srvCpuHandle,
+			const D3D12_GPU_DESCRIPTOR_HANDLE srvGpuHandle,
+			const D3D12_CPU_DESCRIPTOR_HANDLE rtvCpuHandle);
+	private:
+		auto pipelineState(const DXGI_FORMAT format) -> WRL::ComPtr<ID3D12PipelineState>;
+	private:
+		WRL::ComPtr<ID3D12Device> mDevice;
+		WRL::ComPtr<ID3D12RootSignature> mRootSignature;
+
+		WRL::ComPtr<ID3DBlob> mVertexShader;
+		WRL::ComPtr<ID3DBlob> mPixelShader;
+
+		std::map<DXGI_FORMAT, WRL::ComPtr<ID3D12PipelineState>> mPipelineStates;
+		std::mutex mMutex;
+	};
+	
+}
+
+#endif
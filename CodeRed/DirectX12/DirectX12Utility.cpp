@@ -31,6 +31,7 @@
 
 using namespace CodeRed::DirectX12;
 
+#pragma comment(lib, "d3dcompiler.lib")
 #pragma comment(lib, "d3d12.lib")
 #pragma comment(lib, "dxgi.lib")
 
@@ -138,6 +139,7 @@ auto CodeRed::DirectX12::enumConvert(const ResourceLayout layout)
 {
 	switch (layout) {
 	case ResourceLayout::GeneralRead: return D3D12_RESOURCE_STATE_GENERIC_READ;
+	case ResourceLayout::GeneralReadWrite: return D3D12_RESOURCE_STATE_UNORDERED_ACCESS;
 	case ResourceLayout::RenderTarget: return D3D12_RESOURCE_STATE_RENDER_TARGET;
 	case ResourceLayout::DepthStencil: return D3D12_RESOURCE_STATE_DEPTH_WRITE;
 	case ResourceLayout::CopyDestination: return D3D12_RESOURCE_STATE_COPY_DEST;
@@ -163,7 +165,9 @@ auto CodeRed::DirectX12::enumConvert(const ResourceUsage usage)
 		ResourceUsage::IndexBuffer | ResourceUsage::RenderTarget,
 		ResourceUsage::IndexBuffer | ResourceUsage::DepthStencil,
 		ResourceUsage::ConstantBuffer | ResourceUsage::RenderTarget,
-		ResourceUsage::ConstantBuffer | ResourceUsage::DepthStencil
+		ResourceUsage::ConstantBuffer | ResourceUsage::DepthStencil,
+		ResourceUsage::IndirectBuffer | ResourceUsage::RenderTarget,
+		ResourceUsage::IndirectBuffer | ResourceUsage::DepthStencil
 	};
 
 	//if usage has this mask we disable, we will throw a InvalidException with nullptr
@@ -179,7 +183,8 @@ auto CodeRed::DirectX12::enumConvert(const ResourceUsage usage)
 		ResourceUsage::IndexBuffer,
 		ResourceUsage::ConstantBuffer,
 		ResourceUsage::RenderTarget,
-		ResourceUsage::DepthStencil
+		ResourceUsage::DepthStencil,
+		ResourceUsage::IndirectBuffer
 	};
 
 	static std::vector<D3D12_RESOURCE_FLAGS> targetPool = {
@@ -188,7 +193,8 @@ auto CodeRed::DirectX12::enumConvert(const ResourceUsage usage)
 		D3D12_RESOURCE_FLAG_NONE,
 		D3D12_RESOURCE_FLAG_NONE,
 		D3D12_RESOURCE_FLAG_ALLOW_RENDER_TARGET,
-		D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL
+		D3D12_RESOURCE_FLAG_ALLOW_DEPTH_STENCIL,
+		D3D12_RESOURCE_FLAG_NONE
 	};
 
 	auto res = D3D12_RESOURCE_FLAG_NONE;
@@ -207,6 +213,7 @@ auto CodeRed::DirectX12::enumConvert(const MemoryHeap heap)
 	switch (heap) {
 	case MemoryHeap::Default: return D3D12_HEAP_TYPE_DEFAULT;
 	case MemoryHeap::Upload: return D3D12_HEAP_TYPE_UPLOAD;
+	case MemoryHeap::Readback: return D3D12_HEAP_TYPE_READBACK;
 	default:
 		throw NotSupportException(NotSupportType::Enum);
 	}
@@ -224,6 +231,30 @@ auto CodeRed::DirectX12::enumConvert(const PixelFormat format)
 	case PixelFormat::Depth32BitFloat: return DXGI_FORMAT_D32_FLOAT;
 	case PixelFormat::Red8BitUnknown: return DXGI_FORMAT_R8_UNORM;
 	case PixelFormat::Red32BitFloat: return DXGI_FORMAT_R32_FLOAT;
+	case PixelFormat::Red16BitFloat: return DXGI_FORMAT_R16_FLOAT;
+	case PixelFormat::RedGreen16BitFloat: return DXGI_FORMAT_R16G16_FLOAT;
+	case PixelFormat::RedGreenBlueAlpha16BitFloat: return DXGI_FORMAT_R16G16B16A16_FLOAT;
+	case PixelFormat::Red16BitUnknown: return DXGI_FORMAT_R16_UNORM;
+	case PixelFormat::RedGreen16BitUnknown: return DXGI_FORMAT_R16G16_UNORM;
+	case PixelFormat::RedGreenBlueAlpha16BitUnknown: return DXGI_FORMAT_R16G16B16A16_UNORM;
+	case PixelFormat::RedGreen16BitSignedUnknown: return DXGI_FORMAT_R16G16_SNORM;
+	case PixelFormat::RedGreenBlueAlpha16BitSignedUnknown: return DXGI_FORMAT_R16G16B16A16_SNORM;
+	case PixelFormat::RedGreen8BitUnknown: return DXGI_FORMAT_R8G8_UNORM;
+	case PixelFormat::RedGreenBlueAlpha8BitSignedUnknown: return DXGI_FORMAT_R8G8B8A8_SNORM;
+	case PixelFormat::RedGreenBlueAlpha8BitSRGB: return DXGI_FORMAT_R8G8B8A8_UNORM_SRGB;
+	case PixelFormat::BlueGreenRedAlpha8BitSRGB: return DXGI_FORMAT_B8G8R8A8_UNORM_SRGB;
+	case PixelFormat::RedGreenBlue10BitAlpha2BitUnknown: return DXGI_FORMAT_R10G10B10A2_UNORM;
+	case PixelFormat::RedGreen11BitBlue10BitFloat: return DXGI_FORMAT_R11G11B10_FLOAT;
+	case PixelFormat::Depth16BitUnknown: return DXGI_FORMAT_D16_UNORM;
+	case PixelFormat::Depth24BitStencil8Bit: return DXGI_FORMAT_D24_UNORM_S8_UINT;
+	case PixelFormat::BlockCompressed1Unknown: return DXGI_FORMAT_BC1_UNORM;
+	case PixelFormat::BlockCompressed1SRGB: return DXGI_FORMAT_BC1_UNORM_SRGB;
+	case PixelFormat::BlockCompressed3Unknown: return DXGI_FORMAT_BC3_UNORM;
+	case PixelFormat::BlockCompressed3SRGB: return DXGI_FORMAT_BC3_UNORM_SRGB;
+	case PixelFormat::BlockCompressed4Unknown: return DXGI_FORMAT_BC4_UNORM;
+	case PixelFormat::BlockCompressed5Unknown: return DXGI_FORMAT_BC5_UNORM;
+	case PixelFormat::BlockCompressed7Unknown: return DXGI_FORMAT_BC7_UNORM;
+	case PixelFormat::BlockCompressed7SRGB: return DXGI_FORMAT_BC7_UNORM_SRGB;
 	case PixelFormat::Unknown: return DXGI_FORMAT_UNKNOWN;
 	default:
 		throw NotSupportException(NotSupportType::Enum);
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "../Shared/Noncopyable.hpp"
+
+#include <future>
+#include <memory>
+#include <atomic>
+
+namespace CodeRed {
+
+	class GpuGraphicsPipeline;
+
+	/*
+	 * GpuAsyncGraphicsPipeline is the handle of pipeline that is compiled on the worker thread.
+	 * before the pipeline is ready, pipeline() returns the fallback pipeline(it can be nullptr),
+	 * so we can draw with the fallback pipeline or skip the draw call.
+	 * if the compilation failed, pipeline() still returns the fallback pipeline and wait() throws the exception.
+	 */
+	class GpuAsyncGraphicsPipeline final : public Noncopyable {
+	public:
+		explicit GpuAsyncGraphicsPipeline(
+			const std::shared_future<std::shared_ptr<GpuGraphicsPipeline>>& future,
+			const std::shared_ptr<GpuGraphicsPipeline>& fallback = nullptr) :
+			mFuture(future), mFallback(fallback) {}
+
+		~GpuAsyncGraphicsPipeline() = default;
+
+		auto ready() const -> bool
+		{
+			return mFuture.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}
+
+		// if the compilation failed, the exception is thrown here
+		auto wait() const -> std::shared_ptr<GpuGraphicsPipeline> { return mFuture.get(); }
+
+		// if the compilation failed, we return the fallback pipeline instead of throwing the exception
+		auto pipeline() const -> std::shared_ptr<GpuGraphicsPipeline>
+		{
+			if (mFailed || !ready()) return mFallback;
+
+			try {
+				return mFuture.get();
+			}
+			catch (...) {
+				// we only catch the exception once, the next calls return the fallback directly
+				mFailed = true;
+
+				return mFallback;
+			}
+		}
+
+		// the compilation is finished with exception, we can get it by wait()
+		auto failed() const -> bool
+		{
+			if (!ready()) return false;
+
+			pipeline();
+
+			return mFailed;
+		}
+
+		auto fallback() const noexcept -> std::shared_ptr<GpuGraphicsPipeline> { return mFallback; }
+	private:
+		std::shared_future<std::shared_ptr<GpuGraphicsPipeline>> mFuture;
+		std::shared_ptr<GpuGraphicsPipeline> mFallback;
+
+		mutable std::atomic<bool> mFailed = { false };
+	};
+	
+}
@@ -0,0 +1,55 @@
+#include "../Shared/Exception/ZeroException.hpp"
+
+#include "GpuCommandAllocatorPool.hpp"
+#include "GpuGraphicsCommandList.hpp"
+#include "GpuCommandAllocator.hpp"
+#include "GpuLogicalDevice.hpp"
+
+CodeRed::GpuCommandAllocatorPool::GpuCommandAllocatorPool(
+	const std::shared_ptr<GpuLogicalDevice>& device) :
+	mDevice(device)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mDevice == nullptr,
+		ZeroException<GpuLogicalDevice>({ "device" })
+	);
+}
+
+auto CodeRed::GpuCommandAllocatorPool::allocator() -> std::shared_ptr<GpuCommandAllocator>
+{
+	return threadAllocator().Allocator;
+}
+
+auto CodeRed::GpuCommandAllocatorPool::commandList() -> std::shared_ptr<GpuGraphicsCommandList>
+{
+	return threadAllocator().CommandList;
+}
+
+void CodeRed::GpuCommandAllocatorPool::reset()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	for (auto& allocator : mAllocators) allocator.second.Allocator->reset();
+}
+
+auto CodeRed::GpuCommandAllocatorPool::count() -> size_t
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	return mAllocators.size();
+}
+
+auto CodeRed::GpuCommandAllocatorPool::threadAllocator() -> ThreadAllocator&
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	auto& allocator = mAllocators[std::this_thread::get_id()];
+
+	// the references of unordered_map are not invalidated when we insert new allocators
+	if (allocator.Allocator == nullptr) {
+		allocator.Allocator = mDevice->createCommandAllocator();
+		allocator.CommandList = mDevice->createGraphicsCommandList(allocator.Allocator);
+	}
+
+	return allocator;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../Shared/Noncopyable.hpp"
+
+#include <unordered_map>
+#include <memory>
+#include <thread>
+#include <mutex>
+
+namespace CodeRed {
+
+	class GpuGraphicsCommandList;
+	class GpuCommandAllocator;
+	class GpuLogicalDevice;
+
+	/*
+	 * the command allocator is externally synchronized, so it can not be used by many threads at the same time.
+	 * GpuCommandAllocatorPool gives every thread its own allocator and command list,
+	 * so we can record command lists on many threads and submit them in the order we want.
+	 */
+	class GpuCommandAllocatorPool final : public Noncopyable {
+	public:
+		explicit GpuCommandAllocatorPool(
+			const std::shared_ptr<GpuLogicalDevice>& device);
+
+		~GpuCommandAllocatorPool() = default;
+
+		/*
+		 * get the allocator of current thread, create it if the thread does not have one
+		 */
+		auto allocator() -> std::shared_ptr<GpuCommandAllocator>;
+
+		/*
+		 * get the command list of current thread, it is allocated from the allocator of current thread
+		 */
+		auto commandList() -> std::shared_ptr<GpuGraphicsCommandList>;
+
+		/*
+		 * reset the allocators of all threads, the gpu should finish the lists allocated from them
+		 * and no thread is recording with them.
+		 */
+		void reset();
+
+		auto count() -> size_t;
+	private:
+		struct ThreadAllocator {
+			std::shared_ptr<GpuCommandAllocator> Allocator;
+			std::shared_ptr<GpuGraphicsCommandList> CommandList;
+		};
+
+		auto threadAllocator() -> ThreadAllocator&;
+	private:
+		std::shared_ptr<GpuLogicalDevice> mDevice;
+
+		std::unordered_map<std::thread::id, ThreadAllocator> mAllocators;
+
+		std::mutex mMutex;
+	};
+	
+}
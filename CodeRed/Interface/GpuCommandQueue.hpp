@@ -4,24 +4,45 @@
 
 #include <memory>
 #include <vector>
+#include <atomic>
 
 namespace CodeRed {
 
 	class GpuGraphicsCommandList;
 	class GpuLogicalDevice;
+	class GpuFence;
 	
 	class GpuCommandQueue : public Noncopyable {
 	protected:
 		explicit GpuCommandQueue(
 			const std::shared_ptr<GpuLogicalDevice>& device);
 		
-		~GpuCommandQueue() = default;
+		~GpuCommandQueue();
 	public:
 		virtual void execute(const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists) = 0;
 
+		/*
+		 * execute the lists and signal the fence with value after the lists are finished
+		 */
+		virtual void execute(
+			const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists,
+			const std::shared_ptr<GpuFence>& fence,
+			const size_t value) = 0;
+
 		virtual void waitIdle() = 0;
+
+		/*
+		 * the queue signals the submission fence with a new value after every submission
+		 * the device uses it to know when the objects destroyed can be freed
+		 */
+		auto submissionFence() const noexcept -> std::shared_ptr<GpuFence> { return mSubmissionFence; }
+
+		auto submissionValue() const noexcept -> size_t { return mSubmissionValue; }
 	protected:
 		std::shared_ptr<GpuLogicalDevice> mDevice;
+		std::shared_ptr<GpuFence> mSubmissionFence;
+
+		std::atomic<size_t> mSubmissionValue = { 0 };
 	};
 	
 }
\ No newline at end of file
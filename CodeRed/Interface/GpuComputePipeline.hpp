@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../Shared/Noncopyable.hpp"
+
+#include "GpuPipelineState/GpuShaderState.hpp"
+
+#include "GpuResourceLayout.hpp"
+
+#include <memory>
+
+namespace CodeRed {
+
+	class GpuLogicalDevice;
+	
+	class GpuComputePipeline : public Noncopyable {
+	protected:
+		explicit GpuComputePipeline(
+			const std::shared_ptr<GpuLogicalDevice>& device,
+			const std::shared_ptr<GpuResourceLayout>& resource_layout,
+			const std::shared_ptr<GpuShaderState>& compute_shader_state);
+
+		~GpuComputePipeline() = default;
+	public:
+		auto layout() const noexcept -> std::shared_ptr<GpuResourceLayout> { return mResourceLayout; }
+
+		auto computeShader() const noexcept -> std::shared_ptr<GpuShaderState> { return mComputeShaderState; }
+	protected:
+		std::shared_ptr<GpuShaderState> mComputeShaderState;
+		std::shared_ptr<GpuResourceLayout> mResourceLayout;
+
+		std::shared_ptr<GpuLogicalDevice> mDevice;
+	};
+	
+}
@@ -6,8 +6,10 @@
 #include "GpuResource/GpuBuffer.hpp"
 
 #include "GpuGraphicsCommandList.hpp"
+#include "GpuGraphicsBundle.hpp"
 #include "GpuCommandAllocator.hpp"
 #include "GpuGraphicsPipeline.hpp"
+#include "GpuComputePipeline.hpp"
 #include "GpuResourceLayout.hpp"
 #include "GpuDisplayAdapter.hpp"
 #include "GpuDescriptorHeap.hpp"
@@ -169,11 +171,32 @@ CodeRed::GpuFence::GpuFence(
 	CODE_RED_DEBUG_DEVICE_VALID(mDevice);
 }
 
+CodeRed::GpuGraphicsBundle::GpuGraphicsBundle(
+	const std::shared_ptr<GpuLogicalDevice>& device) :
+	mDevice(device)
+{
+	CODE_RED_DEBUG_DEVICE_VALID(mDevice);
+}
+
 CodeRed::GpuCommandQueue::GpuCommandQueue(
 	const std::shared_ptr<GpuLogicalDevice>& device) :
 	mDevice(device)
 {
 	CODE_RED_DEBUG_DEVICE_VALID(mDevice);
+
+	mSubmissionFence = mDevice->createFence();
+
+	mDevice->registerQueue(this);
+}
+
+CodeRed::GpuCommandQueue::~GpuCommandQueue()
+{
+	// the deferred objects may wait the submissions of queue
+	// so we wait them before the queue is removed from device
+	mSubmissionFence->wait(mSubmissionValue);
+
+	mDevice->unregisterQueue(this);
+	mDevice->releaseDeferredObjects();
 }
 
 CodeRed::GpuCommandAllocator::GpuCommandAllocator(
@@ -232,6 +255,18 @@ CodeRed::GpuTexture::GpuTexture(
 			{ "We only support MSAA Texture with MipLevels 1." })
 	);
 
+	// the width and height of compressed texture must be multiple of block size
+	// and it can not be render target or depth stencil
+	CODE_RED_DEBUG_THROW_IF(
+		PixelFormatSizeOf::isCompressed(std::get<TextureProperty>(mInfo.Property).Format) &&
+		(std::get<TextureProperty>(mInfo.Property).Width % PixelFormatSizeOf::blockSize(std::get<TextureProperty>(mInfo.Property).Format) != 0 ||
+		 std::get<TextureProperty>(mInfo.Property).Height % PixelFormatSizeOf::blockSize(std::get<TextureProperty>(mInfo.Property).Format) != 0 ||
+		 enumHas(mInfo.Usage, ResourceUsage::RenderTarget) ||
+		 enumHas(mInfo.Usage, ResourceUsage::DepthStencil)),
+		InvalidException<ResourceInfo>({ "info.Property" },
+			{ "the size of compressed texture must be multiple of 4 and it can not be render target or depth stencil." })
+	);
+
 	// The MSAA Texture should has ResourceUsage::RenderTarget or ResourceUsage::DepthStencil
 	CODE_RED_DEBUG_THROW_IF(
 		std::get<TextureProperty>(mInfo.Property).Sample != MultiSample::Count1 &&
@@ -259,6 +294,8 @@ CodeRed::GpuTexture::GpuTexture(
 			}
 		)
 	);
+
+	mLayouts = std::vector<ResourceLayout>(mipLevels() * arrays(), mInfo.Layout);
 }
 
 CodeRed::GpuSampler::GpuSampler(
@@ -293,6 +330,14 @@ CodeRed::GpuBuffer::GpuBuffer(
 		ZeroException<size_t>({ "info.Property.Size" })
 	);
 
+	//in DirectX12, the buffer in readback heap must stay in copy destination state
+	CODE_RED_DEBUG_THROW_IF(
+		mInfo.Heap == MemoryHeap::Readback &&
+		mInfo.Layout != ResourceLayout::CopyDestination,
+		InvalidException<ResourceInfo>({ "info.Layout" },
+			{ "the layout of buffer in MemoryHeap::Readback should be ResourceLayout::CopyDestination." })
+	);
+
 	//if we want to use the buffer as constant buffer,
 	//the size of buffer need more than 256bytes
 	//so we will check, warning and modify the size
@@ -368,6 +413,25 @@ CodeRed::GpuGraphicsPipeline::GpuGraphicsPipeline(
 	);
 }
 
+CodeRed::GpuComputePipeline::GpuComputePipeline(
+	const std::shared_ptr<GpuLogicalDevice>& device,
+	const std::shared_ptr<GpuResourceLayout>& resource_layout,
+	const std::shared_ptr<GpuShaderState>& compute_shader_state) :
+	mComputeShaderState(compute_shader_state),
+	mResourceLayout(resource_layout),
+	mDevice(device)
+{
+	CODE_RED_DEBUG_DEVICE_VALID(mDevice);
+
+	CODE_RED_DEBUG_PTR_VALID(mComputeShaderState, "compute_shader_state");
+	CODE_RED_DEBUG_PTR_VALID(mResourceLayout, "resource_layout");
+
+	CODE_RED_DEBUG_THROW_IF(
+		mComputeShaderState->type() != ShaderType::Compute,
+		InvalidException<GpuShaderState>({ "compute_shader_state" }, { "the shader type is not compute." })
+	);
+}
+
 CodeRed::GpuRenderPass::GpuRenderPass(
 	const std::shared_ptr<GpuLogicalDevice>& device,
 	const std::vector<Attachment>& colors, 
@@ -464,6 +528,13 @@ void CodeRed::GpuDescriptorHeap::bindResource(
 	}
 }
 
+void CodeRed::GpuDescriptorHeap::bindBuffer(
+	const std::shared_ptr<GpuBuffer>& buffer,
+	const size_t index)
+{
+	bindBuffer(GpuBufferView(buffer), index);
+}
+
 void CodeRed::GpuRenderPass::setClear(
 	const std::optional<ClearValue>& color,
 	const std::optional<ClearValue>& depth)
@@ -490,6 +561,43 @@ auto CodeRed::GpuRenderPass::compatible(const std::shared_ptr<GpuFrameBuffer>& f
 	return true;
 }
 
+void CodeRed::GpuGraphicsCommandList::setVertexBuffer(
+	const std::shared_ptr<GpuBuffer>& buffer)
+{
+	setVertexBuffer(GpuBufferView(buffer));
+}
+
+void CodeRed::GpuGraphicsCommandList::setVertexBuffers(
+	const std::vector<std::shared_ptr<GpuBuffer>>& buffers,
+	const size_t startSlot)
+{
+	std::vector<GpuBufferView> views;
+
+	for (const auto& buffer : buffers) views.push_back(GpuBufferView(buffer));
+
+	setVertexBuffers(views, startSlot);
+}
+
+void CodeRed::GpuGraphicsCommandList::setIndexBuffer(
+	const std::shared_ptr<GpuBuffer>& buffer,
+	const IndexType type)
+{
+	setIndexBuffer(GpuBufferView(buffer), type);
+}
+
+void CodeRed::GpuGraphicsBundle::setVertexBuffer(
+	const std::shared_ptr<GpuBuffer>& buffer)
+{
+	setVertexBuffer(GpuBufferView(buffer));
+}
+
+void CodeRed::GpuGraphicsBundle::setIndexBuffer(
+	const std::shared_ptr<GpuBuffer>& buffer,
+	const IndexType type)
+{
+	setIndexBuffer(GpuBufferView(buffer), type);
+}
+
 void CodeRed::GpuGraphicsCommandList::layoutTransition(
 	const std::shared_ptr<GpuTextureBuffer>& buffer,
 	const ResourceLayout layout)
@@ -511,6 +619,23 @@ void CodeRed::GpuGraphicsCommandList::layoutTransition(
 	layoutTransition(buffer, buffer->layout(), layout);
 }
 
+auto CodeRed::GpuBuffer::mappedRange(const size_t offset, const size_t size) const -> void*
+{
+	// only the buffer in MemoryHeap::Upload or MemoryHeap::Readback is mapped persistently
+	// and the range should be in the buffer
+	CODE_RED_DEBUG_THROW_IF(
+		mMappedMemory == nullptr,
+		InvalidException<GpuBuffer>({ "buffer" }, { "only the buffer in MemoryHeap::Upload or MemoryHeap::Readback can be mapped." })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		offset + size > GpuBuffer::size(),
+		InvalidException<size_t>({ "offset + size" }, { "the range is out of the buffer." })
+	);
+
+	return static_cast<Byte*>(mMappedMemory) + offset;
+}
+
 auto CodeRed::GpuTexture::width(const size_t mipSlice) const noexcept -> size_t
 {
 	auto result = std::get<TextureProperty>(mInfo.Property).Width;
@@ -549,8 +674,31 @@ auto CodeRed::GpuTexture::size(const size_t mipSlice) const noexcept -> size_t
 	// the size of texture only for one texture with one mip level
 	// so if the texture is array, we do not use depth
 	// if the texture is MSAA texture, we will calculate the sample count.
-	return width(mipSlice) * height(mipSlice) * depth(mipSlice) *
-		PixelFormatSizeOf::get(format()) * MultiSampleSizeOf::get(sample());
+	// if the texture is compressed, the size is the size of 4x4 blocks that cover it
+	return PixelFormatSizeOf::size(format(), width(mipSlice), height(mipSlice), depth(mipSlice)) *
+		MultiSampleSizeOf::get(sample());
+}
+
+void CodeRed::GpuTexture::setLayout(const ResourceLayout layout)
+{
+	std::fill(mLayouts.begin(), mLayouts.end(), layout);
+
+	mInfo.Layout = layout;
+}
+
+void CodeRed::GpuTexture::setLayout(
+	const ValueRange<size_t>& mipLevel,
+	const ValueRange<size_t>& array,
+	const ResourceLayout layout)
+{
+	for (auto arraySlice = array.Start; arraySlice < array.End; arraySlice++) {
+		for (auto mipSlice = mipLevel.Start; mipSlice < mipLevel.End; mipSlice++)
+			mLayouts[index(mipSlice, arraySlice)] = layout;
+	}
+
+	// if all sub-textures have same layout, it is the layout of whole texture
+	if (std::all_of(mLayouts.begin(), mLayouts.end(),
+		[layout](const ResourceLayout value) { return value == layout; })) mInfo.Layout = layout;
 }
 
 auto CodeRed::GpuFrameBuffer::fullViewPort(const size_t index) const noexcept -> ViewPort
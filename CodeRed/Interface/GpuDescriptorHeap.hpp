@@ -2,6 +2,8 @@
 
 #include "../Shared/Noncopyable.hpp"
 
+#include "GpuResource/GpuBufferView.hpp"
+
 #include <memory>
 
 namespace CodeRed {
@@ -35,9 +37,13 @@ namespace CodeRed {
 			const size_t index) = 0;
 
 		virtual void bindBuffer(
-			const std::shared_ptr<GpuBuffer>& buffer,
+			const GpuBufferView& view,
 			const size_t index) = 0;
 
+		virtual void bindBuffer(
+			const std::shared_ptr<GpuBuffer>& buffer,
+			const size_t index);
+
 		auto count() const noexcept -> size_t { return mCount; }
 		
 		auto layout() const noexcept -> std::shared_ptr<GpuResourceLayout> { return mResourceLayout; }
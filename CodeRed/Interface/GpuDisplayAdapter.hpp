@@ -11,10 +11,12 @@ namespace CodeRed {
 		explicit GpuDisplayAdapter(
 			const std::string& name,
 			const size_t device_id,
-			const size_t vendor_id) :
+			const size_t vendor_id,
+			const size_t driver_version = 0) :
 			mName(name),
 			mDeviceId(device_id),
-			mVendorId(vendor_id) {}
+			mVendorId(vendor_id),
+			mDriverVersion(driver_version) {}
 		
 		~GpuDisplayAdapter() = default;
 	public:
@@ -23,11 +25,14 @@ namespace CodeRed {
 		auto deviceId() const noexcept -> size_t { return mDeviceId; }
 
 		auto vendorId() const noexcept -> size_t { return mVendorId; }
+
+		auto driverVersion() const noexcept -> size_t { return mDriverVersion; }
 	protected:
 		std::string mName = "";
 
 		size_t mDeviceId = 0;
 		size_t mVendorId = 0;
+		size_t mDriverVersion = 0;
 	};
 	
 }
\ No newline at end of file
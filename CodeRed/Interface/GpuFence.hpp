@@ -8,15 +8,36 @@ namespace CodeRed {
 
 	class GpuLogicalDevice;
 	class GpuCommandQueue;
-	
+
+	/*
+	 * GpuFence is a timeline fence, it holds a value that only increases
+	 * the queue signals the fence with a value after it finished the commands submitted before,
+	 * and we can wait the value on cpu without waiting the whole queue.
+	 * the values we signal should be greater than the values signaled before.
+	 */
 	class GpuFence : public Noncopyable {
 	protected:
 		explicit GpuFence(
 			const std::shared_ptr<GpuLogicalDevice>& device);
 		
 		~GpuFence() = default;
+	public:
+		virtual void signal(
+			const std::shared_ptr<GpuCommandQueue>& queue,
+			const size_t value) = 0;
+
+		/*
+		 * wait until the value of fence is greater than or equal to value
+		 * timeout is in milliseconds, return false if the wait timed out
+		 */
+		virtual auto wait(
+			const size_t value,
+			const size_t timeout = SIZE_MAX)
+			-> bool = 0;
+
+		virtual auto completedValue() -> size_t = 0;
 	protected:
 		std::shared_ptr<GpuLogicalDevice> mDevice;
 	};
 	
-}
\ No newline at end of file
+}
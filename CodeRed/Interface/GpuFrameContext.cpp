@@ -0,0 +1,91 @@
+#include "../Shared/Exception/ZeroException.hpp"
+
+#include "GpuCommandAllocatorPool.hpp"
+#include "GpuGraphicsCommandList.hpp"
+#include "GpuCommandAllocator.hpp"
+#include "GpuLogicalDevice.hpp"
+#include "GpuCommandQueue.hpp"
+#include "GpuFrameContext.hpp"
+#include "GpuUploadRing.hpp"
+#include "GpuSwapChain.hpp"
+#include "GpuFence.hpp"
+
+CodeRed::GpuFrameContext::GpuFrameContext(
+	const std::shared_ptr<GpuLogicalDevice>& device,
+	const std::shared_ptr<GpuCommandQueue>& queue,
+	const std::shared_ptr<GpuSwapChain>& swap_chain,
+	const size_t upload_frame_size) :
+	mDevice(device),
+	mQueue(queue),
+	mSwapChain(swap_chain)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mDevice == nullptr,
+		ZeroException<GpuLogicalDevice>({ "device" })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		mQueue == nullptr,
+		ZeroException<GpuCommandQueue>({ "queue" })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		mSwapChain == nullptr,
+		ZeroException<GpuSwapChain>({ "swap_chain" })
+	);
+
+	mFrames.resize(mSwapChain->bufferCount());
+
+	for (auto& frame : mFrames) {
+		frame.Allocator = mDevice->createCommandAllocator();
+		frame.CommandList = mDevice->createGraphicsCommandList(frame.Allocator);
+		frame.AllocatorPool = std::make_shared<GpuCommandAllocatorPool>(mDevice);
+	}
+
+	mFence = mDevice->createFence();
+
+	// the regions of upload ring are recycled with the frames
+	if (upload_frame_size != 0)
+		mUploadRing = std::make_shared<GpuUploadRing>(mDevice, upload_frame_size, mFrames.size());
+}
+
+CodeRed::GpuFrameContext::~GpuFrameContext()
+{
+	// wait all frames in flight, the allocators and objects may be used by gpu
+	mFence->wait(mFenceValue);
+}
+
+void CodeRed::GpuFrameContext::beginFrame()
+{
+	auto& frame = mFrames[mFrameIndex];
+
+	// wait the frame that used the same resources, it is the frame N-back
+	mFence->wait(frame.FenceValue);
+
+	frame.Releases.clear();
+	frame.Allocator->reset();
+	frame.AllocatorPool->reset();
+
+	if (mUploadRing != nullptr) mUploadRing->beginFrame();
+}
+
+void CodeRed::GpuFrameContext::execute(const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists)
+{
+	if (mUploadRing != nullptr) mUploadRing->endFrame();
+
+	mQueue->execute(lists, mFence, ++mFenceValue);
+
+	mFrames[mFrameIndex].FenceValue = mFenceValue;
+}
+
+void CodeRed::GpuFrameContext::present()
+{
+	mSwapChain->present();
+
+	mFrameIndex = (mFrameIndex + 1) % mFrames.size();
+}
+
+void CodeRed::GpuFrameContext::release(const std::shared_ptr<void>& object)
+{
+	mFrames[mFrameIndex].Releases.push_back(object);
+}
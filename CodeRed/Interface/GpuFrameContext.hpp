@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../Shared/Noncopyable.hpp"
+#include "../Shared/Utility.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace CodeRed {
+
+	class GpuCommandAllocatorPool;
+	class GpuGraphicsCommandList;
+	class GpuCommandAllocator;
+	class GpuLogicalDevice;
+	class GpuCommandQueue;
+	class GpuUploadRing;
+	class GpuSwapChain;
+	class GpuFence;
+
+	/*
+	 * GpuFrameContext keeps N frames in flight, N is the buffer count of swap chain
+	 * every frame owns a command allocator, a command list, a region of upload ring and a list of objects to release.
+	 * when we begin a frame, we only wait the fence value of the frame that used the same resources (N frames before),
+	 * so the cpu can record the next frame when the gpu is still working on the current frame.
+	 */
+	class GpuFrameContext final : public Noncopyable {
+	public:
+		explicit GpuFrameContext(
+			const std::shared_ptr<GpuLogicalDevice>& device,
+			const std::shared_ptr<GpuCommandQueue>& queue,
+			const std::shared_ptr<GpuSwapChain>& swap_chain,
+			const size_t upload_frame_size = 0);
+
+		~GpuFrameContext();
+
+		void beginFrame();
+
+		void execute(const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists);
+
+		void present();
+
+		/*
+		 * keep the object alive until the gpu finished the current frame
+		 * we use it to destroy the resources that may be used by the frames in flight
+		 */
+		void release(const std::shared_ptr<void>& object);
+
+		auto allocator() const noexcept -> std::shared_ptr<GpuCommandAllocator> { return mFrames[mFrameIndex].Allocator; }
+
+		auto commandList() const noexcept -> std::shared_ptr<GpuGraphicsCommandList> { return mFrames[mFrameIndex].CommandList; }
+
+		/*
+		 * the allocators of worker threads for current frame, we use it to record command lists on many threads
+		 */
+		auto allocatorPool() const noexcept -> std::shared_ptr<GpuCommandAllocatorPool> { return mFrames[mFrameIndex].AllocatorPool; }
+
+		auto uploadRing() const noexcept -> std::shared_ptr<GpuUploadRing> { return mUploadRing; }
+
+		auto fence() const noexcept -> std::shared_ptr<GpuFence> { return mFence; }
+
+		auto fenceValue() const noexcept -> size_t { return mFenceValue; }
+
+		auto frameIndex() const noexcept -> size_t { return mFrameIndex; }
+
+		auto frameCount() const noexcept -> size_t { return mFrames.size(); }
+	private:
+		struct Frame {
+			std::shared_ptr<GpuCommandAllocator> Allocator;
+			std::shared_ptr<GpuGraphicsCommandList> CommandList;
+			std::shared_ptr<GpuCommandAllocatorPool> AllocatorPool;
+
+			std::vector<std::shared_ptr<void>> Releases;
+
+			// the fence value signaled by the last submission of frame
+			size_t FenceValue = 0;
+		};
+
+		std::shared_ptr<GpuLogicalDevice> mDevice;
+		std::shared_ptr<GpuCommandQueue> mQueue;
+		std::shared_ptr<GpuSwapChain> mSwapChain;
+		std::shared_ptr<GpuUploadRing> mUploadRing;
+		std::shared_ptr<GpuFence> mFence;
+
+		std::vector<Frame> mFrames;
+
+		size_t mFrameIndex = 0;
+		size_t mFenceValue = 0;
+	};
+	
+}
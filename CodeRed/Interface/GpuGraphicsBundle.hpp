@@ -0,0 +1,101 @@
+#pragma once
+
+#include "../Shared/Enum/IndexType.hpp"
+#include "../Shared/Constant32Bits.hpp"
+#include "../Shared/Noncopyable.hpp"
+#include "../Shared/ScissorRect.hpp"
+#include "../Shared/ViewPort.hpp"
+
+#include "GpuResource/GpuBufferView.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace CodeRed {
+
+	class GpuGraphicsPipeline;
+	class GpuResourceLayout;
+	class GpuDescriptorHeap;
+	class GpuLogicalDevice;
+	class GpuRenderPass;
+	class GpuBuffer;
+
+	/*
+	 * GpuGraphicsBundle is a group of draw commands that is recorded once and executed many times
+	 * it is secondary command buffer in Vulkan and bundle in DirectX12.
+	 * the bundle does not inherit the state of command list that executes it,
+	 * so we need set the pipeline, resource layout and descriptor heap in bundle again.
+	 * the descriptor heap should be same as the one set in command list (DirectX12).
+	 */
+	class GpuGraphicsBundle : public Noncopyable {
+	protected:
+		explicit GpuGraphicsBundle(
+			const std::shared_ptr<GpuLogicalDevice>& device);
+
+		~GpuGraphicsBundle() = default;
+	public:
+		/*
+		 * the bundle only can be executed in the render pass compatible with render_pass
+		 */
+		virtual void beginRecording(
+			const std::shared_ptr<GpuRenderPass>& render_pass) = 0;
+
+		virtual void endRecording() = 0;
+
+		virtual void setGraphicsPipeline(
+			const std::shared_ptr<GpuGraphicsPipeline>& pipeline) = 0;
+
+		virtual void setResourceLayout(
+			const std::shared_ptr<GpuResourceLayout>& layout) = 0;
+
+		virtual void setVertexBuffer(
+			const GpuBufferView& view) = 0;
+
+		virtual void setVertexBuffer(
+			const std::shared_ptr<GpuBuffer>& buffer);
+
+		virtual void setVertexBuffers(
+			const std::vector<GpuBufferView>& views,
+			const size_t startSlot = 0) = 0;
+
+		virtual void setIndexBuffer(
+			const GpuBufferView& view,
+			const IndexType type = IndexType::UInt32) = 0;
+
+		virtual void setIndexBuffer(
+			const std::shared_ptr<GpuBuffer>& buffer,
+			const IndexType type = IndexType::UInt32);
+
+		virtual void setDescriptorHeap(
+			const std::shared_ptr<GpuDescriptorHeap>& heap) = 0;
+
+		virtual void setConstant32Bits(
+			const std::vector<Value32Bit>& values) = 0;
+
+		/*
+		 * the view port and scissor rect are inherited from command list in DirectX12,
+		 * but we need set them in Vulkan, so we should set the same values as command list.
+		 */
+		virtual void setViewPort(
+			const ViewPort& view_port) = 0;
+
+		virtual void setScissorRect(
+			const ScissorRect& rect) = 0;
+
+		virtual void draw(
+			const size_t vertex_count,
+			const size_t instance_count = 1,
+			const size_t start_vertex_location = 0,
+			const size_t start_instance_location = 0) = 0;
+
+		virtual void drawIndexed(
+			const size_t index_count,
+			const size_t instance_count = 1,
+			const size_t start_index_location = 0,
+			const size_t base_vertex_location = 0,
+			const size_t start_instance_location = 0) = 0;
+	protected:
+		std::shared_ptr<GpuLogicalDevice> mDevice;
+	};
+	
+}
@@ -2,22 +2,31 @@
 
 #include "../Shared/Information/TextureBufferCopyInfo.hpp"
 #include "../Shared/Information/TextureResolveInfo.hpp"
+#include "../Shared/Information/TextureCopyRegion.hpp"
+#include "../Shared/Information/TextureBlitInfo.hpp"
+#include "../Shared/Information/BufferCopyRegion.hpp"
 #include "../Shared/Information/TextureCopyInfo.hpp"
 #include "../Shared/Enum/ResourceLayout.hpp"
+#include "../Shared/Enum/BlitFilter.hpp"
 #include "../Shared/Enum/IndexType.hpp"
+#include "../Shared/IndirectArguments.hpp"
 #include "../Shared/Constant32Bits.hpp"
 #include "../Shared/Noncopyable.hpp"
 #include "../Shared/ScissorRect.hpp"
 #include "../Shared/ViewPort.hpp"
 #include "../Shared/Extent.hpp"
 
+#include "GpuResource/GpuBufferView.hpp"
+
 #include <memory>
 #include <vector>
 
 namespace CodeRed {
 
 	class GpuCommandAllocator;
+	class GpuComputePipeline;
 	class GpuGraphicsPipeline;
+	class GpuGraphicsBundle;
 	class GpuResourceLayout;
 	class GpuDescriptorHeap;
 	class GpuLogicalDevice;	
@@ -25,6 +34,7 @@ namespace CodeRed {
 	class GpuRenderPass;
 
 	class GpuTextureBuffer;
+	class GpuTextureRef;
 	class GpuSampler;
 	class GpuTexture;
 	class GpuBuffer;
@@ -50,20 +60,38 @@ namespace CodeRed {
 		virtual void setGraphicsPipeline(
 			const std::shared_ptr<GpuGraphicsPipeline>& pipeline) = 0;
 		
+		virtual void setComputePipeline(
+			const std::shared_ptr<GpuComputePipeline>& pipeline) = 0;
+
+		/*
+		 * set the resource layout of graphics and compute pipeline
+		 * the descriptor heap and constant32Bits will be bound to both of them
+		 */
 		virtual void setResourceLayout(
 			const std::shared_ptr<GpuResourceLayout>& layout) = 0;
 
 		virtual void setVertexBuffer(
-			const std::shared_ptr<GpuBuffer>& buffer) = 0;
+			const GpuBufferView& view) = 0;
+
+		virtual void setVertexBuffer(
+			const std::shared_ptr<GpuBuffer>& buffer);
 
 		virtual void setVertexBuffers(
-			const std::vector<std::shared_ptr<GpuBuffer>>& buffers,
+			const std::vector<GpuBufferView>& views,
 			const size_t startSlot = 0) = 0;
 
+		virtual void setVertexBuffers(
+			const std::vector<std::shared_ptr<GpuBuffer>>& buffers,
+			const size_t startSlot = 0);
+
 		virtual void setIndexBuffer(
-			const std::shared_ptr<GpuBuffer>& buffer,
+			const GpuBufferView& view,
 			const IndexType type = IndexType::UInt32) = 0;
 
+		virtual void setIndexBuffer(
+			const std::shared_ptr<GpuBuffer>& buffer,
+			const IndexType type = IndexType::UInt32);
+
 		virtual void setDescriptorHeap(
 			const std::shared_ptr<GpuDescriptorHeap>& heap) = 0;
 
@@ -94,6 +122,23 @@ namespace CodeRed {
 			const std::shared_ptr<GpuTexture>& texture,
 			const ResourceLayout layout);
 
+		/*
+		 * translate the sub-textures that texture ref covers(the range of mip levels and arrays) to layout
+		 * the other sub-textures keep their layouts, so we can use a mip level or a face as render target
+		 * while the other mip levels or faces are read by shader
+		 */
+		virtual void layoutTransition(
+			const std::shared_ptr<GpuTextureRef>& texture,
+			const ResourceLayout layout) = 0;
+
+		/*
+		 * the layouts of sub-textures are not changed, but the commands after the barrier wait for the commands before it
+		 * we need it when we write a texture after we read or write it in same layout(for example, the compute ping-pong)
+		 * in DirectX12 mode, it is a uav barrier if the sub-textures are in GeneralReadWrite layout
+		 */
+		virtual void memoryBarrier(
+			const std::shared_ptr<GpuTextureRef>& texture) = 0;
+
 		virtual void layoutTransition(
 			const std::shared_ptr<GpuBuffer>& buffer,
 			const ResourceLayout old_layout,
@@ -142,6 +187,65 @@ namespace CodeRed {
 			const size_t width,
 			const size_t height,
 			const size_t depth = 1) = 0;
+
+		/*
+		 * copy many regions with one command, it is faster than copying them one by one
+		 * the regions should not overlap in destination
+		 */
+		virtual void copyBuffer(
+			const std::shared_ptr<GpuBuffer>& source,
+			const std::shared_ptr<GpuBuffer>& destination,
+			const std::vector<BufferCopyRegion>& regions) = 0;
+
+		virtual void copyTexture(
+			const std::shared_ptr<GpuTexture>& source,
+			const std::shared_ptr<GpuTexture>& destination,
+			const std::vector<TextureCopyRegion>& regions) = 0;
+
+		/*
+		 * the DestinationIndex of regions should be 0, the Destination location is the position in texture buffer
+		 */
+		virtual void copyTextureToBuffer(
+			const std::shared_ptr<GpuTexture>& source,
+			const std::shared_ptr<GpuTextureBuffer>& destination,
+			const std::vector<TextureCopyRegion>& regions) = 0;
+
+		/*
+		 * the SourceIndex of regions should be 0, the Source location is the position in texture buffer
+		 * so we can pack many images(atlas or mip levels) into one texture buffer and upload them with one command
+		 */
+		virtual void copyBufferToTexture(
+			const std::shared_ptr<GpuTextureBuffer>& source,
+			const std::shared_ptr<GpuTexture>& destination,
+			const std::vector<TextureCopyRegion>& regions) = 0;
+
+		/*
+		 * copy the region of source to the region of destination with scaling and format conversion
+		 * the source should be CopySource layout and the destination should be CopyDestination layout
+		 * the regions should be in the sub-textures, they are not clipped
+		 * in Vulkan mode, we use vkCmdBlitImage, so the formats should support blit(not compressed or integer),
+		 * the depth and stencil are always blitted with nearest filter
+		 * in DirectX12 mode, we draw the region with built-in pipeline, it only supports texture 2D,
+		 * the destination should be created with ResourceUsage::RenderTarget,
+		 * and we need set the pipeline, resource layout, descriptor heap, view port and scissor rect again after it
+		 * it should be called outside the render pass
+		 */
+		virtual void blitTexture(
+			const TextureBlitInfo& source,
+			const TextureBlitInfo& destination,
+			const BlitFilter filter = BlitFilter::Linear) = 0;
+
+		/*
+		 * generate the mip level 1 to mipLevels - 1 of texture from the mip level 0 with linear filter
+		 * the layout of texture is same as the layout before we generate the mip levels
+		 * in Vulkan mode, we use vkCmdBlitImage(nearest filter if the format does not support linear filter or has depth or stencil)
+		 * in DirectX12 mode, we draw the mip levels with built-in pipeline,
+		 * so the texture should be created with ResourceUsage::RenderTarget,
+		 * and we need set the pipeline, resource layout, descriptor heap, view port and scissor rect again after it
+		 * it should be called outside the render pass
+		 */
+		virtual void generateMipmaps(
+			const std::shared_ptr<GpuTexture>& texture) = 0;
 		
 		virtual void draw(
 			const size_t vertex_count,
@@ -155,6 +259,58 @@ namespace CodeRed {
 			const size_t start_index_location = 0,
 			const size_t base_vertex_location = 0,
 			const size_t start_instance_location = 0) = 0;
+
+		/*
+		 * draw with the arguments in buffer, the arguments are DrawIndirectArguments
+		 * the buffer should be created with ResourceUsage::IndirectBuffer
+		 */
+		virtual void drawIndirect(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const size_t draw_count = 1,
+			const size_t argument_offset = 0) = 0;
+
+		/*
+		 * draw with the arguments in buffer, the arguments are DrawIndexedIndirectArguments
+		 * the buffer should be created with ResourceUsage::IndirectBuffer
+		 */
+		virtual void drawIndexedIndirect(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const size_t draw_count = 1,
+			const size_t argument_offset = 0) = 0;
+
+		/*
+		 * the count of draws is read from count buffer (UInt32) and clamped to max_draw_count
+		 * in Vulkan mode, it requires VK_KHR_draw_indirect_count
+		 */
+		virtual void drawIndirectCount(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const std::shared_ptr<GpuBuffer>& count_buffer,
+			const size_t max_draw_count,
+			const size_t argument_offset = 0,
+			const size_t count_offset = 0) = 0;
+
+		virtual void drawIndexedIndirectCount(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const std::shared_ptr<GpuBuffer>& count_buffer,
+			const size_t max_draw_count,
+			const size_t argument_offset = 0,
+			const size_t count_offset = 0) = 0;
+
+		/*
+		 * dispatch the compute pipeline with x * y * z thread groups
+		 * it should be called outside the render pass
+		 */
+		virtual void dispatch(
+			const size_t x,
+			const size_t y = 1,
+			const size_t z = 1) = 0;
+
+		/*
+		 * execute the bundle in current render pass
+		 * in Vulkan, the render pass can not mix bundles and the draw commands of list
+		 */
+		virtual void executeBundle(
+			const std::shared_ptr<GpuGraphicsBundle>& bundle) = 0;
 	protected:
 		std::shared_ptr<GpuLogicalDevice> mDevice;
 		std::shared_ptr<GpuCommandAllocator> mAllocator;
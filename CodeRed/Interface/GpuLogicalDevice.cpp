@@ -0,0 +1,236 @@
+#include "../Shared/Exception/FailedException.hpp"
+#include "../Shared/Hash.hpp"
+
+#include "GpuDisplayAdapter.hpp"
+#include "GpuLogicalDevice.hpp"
+#include "GpuCommandQueue.hpp"
+#include "GpuFence.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <cstring>
+
+namespace CodeRed {
+
+	/*
+	 * the header of pipeline cache blob, the data of backend follows it
+	 * if the magic, version, api, adapter or checksum does not match, we reject the blob
+	 */
+	struct PipelineCacheHeader {
+		UInt32 Magic = 0;
+		UInt32 Version = 0;
+		UInt32 API = 0;
+		UInt32 VendorId = 0;
+		UInt32 DeviceId = 0;
+		UInt32 Reserved = 0;
+		UInt64 DriverVersion = 0;
+		UInt64 DataSize = 0;
+		UInt64 Checksum = 0;
+	};
+
+	// "CRPC" in little endian
+	static constexpr UInt32 PipelineCacheMagic = 0x43505243;
+	static constexpr UInt32 PipelineCacheVersion = 1;
+
+	static auto makePipelineCacheHeader(
+		const APIVersion version,
+		const std::shared_ptr<GpuDisplayAdapter>& adapter)
+		-> PipelineCacheHeader
+	{
+		PipelineCacheHeader header;
+
+		header.Magic = PipelineCacheMagic;
+		header.Version = PipelineCacheVersion;
+		header.API = static_cast<UInt32>(version);
+		header.VendorId = static_cast<UInt32>(adapter->vendorId());
+		header.DeviceId = static_cast<UInt32>(adapter->deviceId());
+		header.DriverVersion = static_cast<UInt64>(adapter->driverVersion());
+
+		return header;
+	}
+	
+}
+
+auto CodeRed::GpuLogicalDevice::pipelineCacheBlob() -> std::vector<Byte>
+{
+	const auto data = pipelineCacheData();
+
+	auto header = makePipelineCacheHeader(mAPIVersion, mDisplayAdapter);
+
+	header.DataSize = static_cast<UInt64>(data.size());
+	header.Checksum = Hash::bytes(data.data(), data.size());
+
+	std::vector<Byte> blob(sizeof(PipelineCacheHeader) + data.size());
+
+	std::memcpy(blob.data(), &header, sizeof(PipelineCacheHeader));
+
+	if (!data.empty()) std::memcpy(blob.data() + sizeof(PipelineCacheHeader), data.data(), data.size());
+
+	return blob;
+}
+
+auto CodeRed::GpuLogicalDevice::loadPipelineCacheBlob(const std::vector<Byte>& blob) -> bool
+{
+	if (blob.size() < sizeof(PipelineCacheHeader)) return false;
+
+	PipelineCacheHeader header;
+
+	std::memcpy(&header, blob.data(), sizeof(PipelineCacheHeader));
+
+	// the cache is created by other adapter or driver, the backend may crash with it
+	// so we reject it before we give it to the backend
+	const auto expected = makePipelineCacheHeader(mAPIVersion, mDisplayAdapter);
+
+	if (header.Magic != expected.Magic ||
+		header.Version != expected.Version ||
+		header.API != expected.API ||
+		header.VendorId != expected.VendorId ||
+		header.DeviceId != expected.DeviceId ||
+		header.DriverVersion != expected.DriverVersion)
+		return false;
+
+	if (header.DataSize != blob.size() - sizeof(PipelineCacheHeader)) return false;
+
+	const std::vector<Byte> data(blob.begin() + sizeof(PipelineCacheHeader), blob.end());
+
+	if (header.Checksum != Hash::bytes(data.data(), data.size())) return false;
+
+	return setPipelineCacheData(data);
+}
+
+auto CodeRed::GpuLogicalDevice::loadPipelineCache(const std::string& file_name) -> bool
+{
+	std::ifstream file(file_name, std::ios::binary | std::ios::ate);
+
+	// if there is no cache file, we start with a cold cache
+	if (!file.is_open()) return false;
+
+	const auto size = static_cast<size_t>(file.tellg());
+
+	std::vector<Byte> blob(size);
+
+	file.seekg(0, std::ios::beg);
+	file.read(reinterpret_cast<char*>(blob.data()), static_cast<std::streamsize>(size));
+
+	if (!file) return false;
+
+	return loadPipelineCacheBlob(blob);
+}
+
+void CodeRed::GpuLogicalDevice::savePipelineCache(const std::string& file_name)
+{
+	const auto blob = pipelineCacheBlob();
+
+	std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+
+	CODE_RED_TRY_EXECUTE(
+		!file.is_open(),
+		throw FailedException(DebugType::Create,
+			{ file_name },
+			{ "can not open the file to save pipeline cache." })
+	);
+
+	file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+}
+
+void CodeRed::GpuLogicalDevice::deferDestruction(const std::function<void()>& destruction)
+{
+	DeferredDestruction deferred;
+
+	{
+		std::lock_guard<std::mutex> lock(mDeferredMutex);
+
+		// the object may be used by the command lists that are recorded but not executed
+		// so we wait the next submission of every queue instead of the submissions in flight
+		for (const auto& queue : mQueues)
+			deferred.Submissions.push_back({ queue, queue->submissionValue() + 1 });
+
+		if (!deferred.Submissions.empty()) {
+			deferred.Destruction = destruction;
+
+			mDeferredDestructions.push_back(deferred);
+
+			return;
+		}
+	}
+
+	destruction();
+}
+
+void CodeRed::GpuLogicalDevice::releaseDeferredObjects()
+{
+	std::vector<std::function<void()>> destructions;
+
+	{
+		std::lock_guard<std::mutex> lock(mDeferredMutex);
+
+		if (mDeferredDestructions.empty()) return;
+
+		// query the completed values of queues only once
+		std::vector<std::pair<GpuCommandQueue*, size_t>> completed;
+
+		for (const auto& queue : mQueues)
+			completed.push_back({ queue, queue->submissionFence()->completedValue() });
+
+		const auto finished = [&](const DeferredDestruction& deferred)
+		{
+			for (const auto& submission : deferred.Submissions) {
+				const auto it = std::find_if(completed.begin(), completed.end(),
+					[&](const std::pair<GpuCommandQueue*, size_t>& value) { return value.first == submission.first; });
+
+				if (it != completed.end() && it->second < submission.second) return false;
+			}
+
+			return true;
+		};
+
+		const auto it = std::stable_partition(
+			mDeferredDestructions.begin(), mDeferredDestructions.end(),
+			[&](const DeferredDestruction& deferred) { return !finished(deferred); });
+
+		for (auto deferred = it; deferred != mDeferredDestructions.end(); ++deferred)
+			destructions.push_back(deferred->Destruction);
+
+		mDeferredDestructions.erase(it, mDeferredDestructions.end());
+	}
+
+	// destroy the objects out of lock, the destructions may use the device
+	for (const auto& destruction : destructions) destruction();
+}
+
+void CodeRed::GpuLogicalDevice::registerQueue(GpuCommandQueue* queue)
+{
+	std::lock_guard<std::mutex> lock(mDeferredMutex);
+
+	mQueues.push_back(queue);
+}
+
+void CodeRed::GpuLogicalDevice::unregisterQueue(GpuCommandQueue* queue)
+{
+	std::lock_guard<std::mutex> lock(mDeferredMutex);
+
+	mQueues.erase(std::remove(mQueues.begin(), mQueues.end(), queue), mQueues.end());
+
+	// the submissions of queue are finished when we remove it
+	// so the deferred objects do not need to wait it
+	for (auto& deferred : mDeferredDestructions) {
+		auto& submissions = deferred.Submissions;
+
+		submissions.erase(std::remove_if(submissions.begin(), submissions.end(),
+			[&](const std::pair<GpuCommandQueue*, size_t>& submission) { return submission.first == queue; }),
+			submissions.end());
+	}
+}
+
+void CodeRed::GpuLogicalDevice::releaseAllDeferredObjects()
+{
+	std::vector<DeferredDestruction> destructions;
+
+	{
+		std::lock_guard<std::mutex> lock(mDeferredMutex);
+
+		destructions.swap(mDeferredDestructions);
+	}
+
+	for (const auto& deferred : destructions) deferred.Destruction();
+}
\ No newline at end of file
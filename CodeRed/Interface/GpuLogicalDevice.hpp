@@ -9,10 +9,14 @@
 #include "../Shared/LayoutElement.hpp"
 #include "../Shared/Noncopyable.hpp"
 #include "../Shared/Attachment.hpp"
+#include "../Shared/Utility.hpp"
 
+#include <functional>
 #include <optional>
+#include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
 
 namespace CodeRed {
 
@@ -20,6 +24,7 @@ namespace CodeRed {
 	class GpuInputAssemblyState;
 	class GpuDepthStencilState;
 	class GpuGraphicsPipeline;
+	class GpuComputePipeline;
 	class GpuPipelineFactory;
 	class GpuResourceLayout;
 	class GpuDescriptorHeap;
@@ -27,6 +32,7 @@ namespace CodeRed {
 	class GpuBlendState;
 	
 	class GpuGraphicsCommandList;
+	class GpuGraphicsBundle;
 	class GpuCommandAllocator;
 	class GpuCommandQueue;
 	
@@ -65,6 +71,9 @@ namespace CodeRed {
 			const std::shared_ptr<GpuCommandAllocator> &allocator)
 			-> std::shared_ptr<GpuGraphicsCommandList> = 0;
 
+		virtual auto createGraphicsBundle()
+			-> std::shared_ptr<GpuGraphicsBundle> = 0;
+
 		virtual auto createCommandQueue()
 			-> std::shared_ptr<GpuCommandQueue> = 0;
 
@@ -82,6 +91,11 @@ namespace CodeRed {
 			const std::shared_ptr<GpuRasterizationState>& rasterization_state)
 			-> std::shared_ptr<GpuGraphicsPipeline> = 0;
 
+		virtual auto createComputePipeline(
+			const std::shared_ptr<GpuResourceLayout>& resource_layout,
+			const std::shared_ptr<GpuShaderState>& compute_shader_state)
+			-> std::shared_ptr<GpuComputePipeline> = 0;
+
 		virtual auto createResourceLayout(
 			const std::vector<ResourceLayoutElement>& elements = {},
 			const std::vector<SamplerLayoutElement>& samplers = {},
@@ -128,11 +142,75 @@ namespace CodeRed {
 		virtual auto createPipelineFactory()
 			-> std::shared_ptr<GpuPipelineFactory> = 0;
 
+		/*
+		 * check if the format can be used with the usage on this device
+		 * ResourceUsage::VertexBuffer means the format of input layout element,
+		 * ResourceUsage::RenderTarget and ResourceUsage::DepthStencil mean the texture that can be used as attachment,
+		 * the other usages mean the texture that can be sampled
+		 */
+		virtual auto isFormatSupported(
+			const PixelFormat format,
+			const ResourceUsage usage = ResourceUsage::None)
+			-> bool = 0;
+
+		/*
+		 * the pipeline cache blob starts with a header that records the api, vendor id,
+		 * device id and driver version of the adapter, the blob is rejected if they do not match.
+		 * so we can load a stale or broken cache file safely, we only lose the warm start.
+		 * the cache should be loaded before we create the pipelines.
+		 */
+		auto pipelineCacheBlob() -> std::vector<Byte>;
+
+		auto loadPipelineCacheBlob(const std::vector<Byte>& blob) -> bool;
+
+		auto loadPipelineCache(const std::string& file_name) -> bool;
+
+		void savePipelineCache(const std::string& file_name);
+
+		/*
+		 * defer the destruction until the queues finished their next submissions after it
+		 * the buffers, textures, descriptor heaps and pipelines destroy their native objects with it,
+		 * so we can release them without waiting the queue, even if the command lists using them are not executed.
+		 * if there is no queue, we destroy it now.
+		 */
+		void deferDestruction(const std::function<void()>& destruction);
+
+		/*
+		 * destroy the deferred objects whose submissions are finished, the queues call it when we submit lists
+		 */
+		void releaseDeferredObjects();
+		
 		auto apiVersion() const noexcept -> APIVersion { return mAPIVersion; }
+	protected:
+		friend class GpuCommandQueue;
+
+		void registerQueue(GpuCommandQueue* queue);
+
+		void unregisterQueue(GpuCommandQueue* queue);
+
+		// destroy all deferred objects, the backend should call it before it destroys the native device
+		void releaseAllDeferredObjects();
+
+		// the data of backend pipeline cache without our header
+		virtual auto pipelineCacheData() -> std::vector<Byte> = 0;
+
+		// return false if the backend rejects the data
+		virtual auto setPipelineCacheData(const std::vector<Byte>& data) -> bool = 0;
 	protected:
 		std::shared_ptr<GpuDisplayAdapter> mDisplayAdapter;
 
 		APIVersion mAPIVersion = APIVersion::Unknown;
+	private:
+		struct DeferredDestruction {
+			// the queues and the submission values the destruction waits
+			std::vector<std::pair<GpuCommandQueue*, size_t>> Submissions;
+			std::function<void()> Destruction;
+		};
+
+		std::vector<DeferredDestruction> mDeferredDestructions;
+		std::vector<GpuCommandQueue*> mQueues;
+
+		std::mutex mDeferredMutex;
 	};
 	
 }
\ No newline at end of file
@@ -2,6 +2,7 @@
 
 #include "GpuPipelineState.hpp"
 #include "../../Shared/Enum/PrimitiveTopology.hpp"
+#include "../../Shared/PixelFormatSizeOf.hpp"
 #include "../../Shared/LayoutElement.hpp"
 
 #include <algorithm>
@@ -24,6 +25,28 @@ namespace CodeRed {
 		{
 			for (const auto& element : mElements)
 				mSlotCount = std::max(mSlotCount, element.Slot + 1);
+
+			mOffsets = std::vector<size_t>(mElements.size());
+			mStrides = std::vector<size_t>(mSlotCount, 0);
+			mRates = std::vector<InputRate>(mSlotCount, InputRate::PerVertex);
+			mStepRates = std::vector<size_t>(mSlotCount, 1);
+
+			auto slotEnds = std::vector<size_t>(mSlotCount, 0);
+			
+			for (size_t index = 0; index < mElements.size(); index++) {
+				const auto& element = mElements[index];
+
+				mOffsets[index] = element.Offset == InputLayoutElement::AppendOffset ? slotEnds[element.Slot] : element.Offset;
+
+				slotEnds[element.Slot] = std::max(slotEnds[element.Slot], mOffsets[index] + PixelFormatSizeOf::get(element.Format));
+
+				mStrides[element.Slot] = std::max(mStrides[element.Slot], element.Stride);
+				mRates[element.Slot] = element.Rate;
+				mStepRates[element.Slot] = element.StepRate;
+			}
+
+			for (size_t index = 0; index < mSlotCount; index++)
+				if (mStrides[index] == 0) mStrides[index] = slotEnds[index];
 		}
 
 		~GpuInputAssemblyState() = default;
@@ -35,9 +58,23 @@ namespace CodeRed {
 		auto elements() const noexcept -> std::vector<InputLayoutElement> { return mElements; }
 
 		auto primitiveTopology() const noexcept -> PrimitiveTopology { return mPrimitiveTopology; }
+
+		auto offset(const size_t index) const -> size_t { return mOffsets[index]; }
+
+		auto stride(const size_t slot) const -> size_t { return mStrides[slot]; }
+
+		auto rate(const size_t slot) const -> InputRate { return mRates[slot]; }
+
+		auto stepRate(const size_t slot) const -> size_t { return mStepRates[slot]; }
 	protected:
 		std::vector<InputLayoutElement> mElements = {};
 
+		// the offset of elements, the stride, rate and step rate of slots
+		std::vector<size_t> mOffsets = {};
+		std::vector<size_t> mStrides = {};
+		std::vector<InputRate> mRates = {};
+		std::vector<size_t> mStepRates = {};
+
 		size_t mSlotCount = 1;
 		
 		PrimitiveTopology mPrimitiveTopology = PrimitiveTopology::TriangleList;
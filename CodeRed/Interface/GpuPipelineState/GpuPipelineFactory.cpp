@@ -0,0 +1,315 @@
+#include "../../Shared/Exception/ZeroException.hpp"
+#include "../../Shared/Hash.hpp"
+
+#include "../GpuAsyncGraphicsPipeline.hpp"
+#include "../GpuLogicalDevice.hpp"
+
+#include "GpuPipelineFactory.hpp"
+
+#include <algorithm>
+
+#undef max
+
+CodeRed::GpuPipelineFactory::GpuPipelineFactory(
+	const std::shared_ptr<GpuLogicalDevice>& device) :
+	mDevice(device),
+	mCompileThreadCount(std::max(static_cast<size_t>(std::thread::hardware_concurrency() / 2), static_cast<size_t>(1)))
+{
+}
+
+CodeRed::GpuPipelineFactory::~GpuPipelineFactory()
+{
+	// the compiling tasks use the caches of factory, so we need finish them first
+	mCompileThreads.reset();
+}
+
+auto CodeRed::GpuPipelineFactory::createGraphicsPipeline(
+	const std::shared_ptr<GpuRenderPass>& render_pass,
+	const std::shared_ptr<GpuResourceLayout>& resource_layout,
+	const std::shared_ptr<GpuInputAssemblyState>& input_assembly_state,
+	const std::shared_ptr<GpuShaderState>& vertex_shader_state,
+	const std::shared_ptr<GpuShaderState>& pixel_shader_state,
+	const std::shared_ptr<GpuDepthStencilState>& depth_stencil_state,
+	const std::shared_ptr<GpuBlendState>& blend_state,
+	const std::shared_ptr<GpuRasterizationState>& rasterization_state)
+	-> std::shared_ptr<GpuGraphicsPipeline>
+{
+	const auto key = graphicsPipelineKey(
+		render_pass,
+		resource_layout,
+		input_assembly_state,
+		vertex_shader_state,
+		pixel_shader_state,
+		depth_stencil_state,
+		blend_state,
+		rasterization_state);
+
+	return findOrCreate(mGraphicsPipelines, key, [&]()
+		{
+			return mDevice->createGraphicsPipeline(
+				render_pass,
+				resource_layout,
+				input_assembly_state,
+				vertex_shader_state,
+				pixel_shader_state,
+				depth_stencil_state,
+				blend_state,
+				rasterization_state);
+		});
+}
+
+auto CodeRed::GpuPipelineFactory::createGraphicsPipelineAsync(
+	const std::shared_ptr<GpuRenderPass>& render_pass,
+	const std::shared_ptr<GpuResourceLayout>& resource_layout,
+	const std::shared_ptr<GpuInputAssemblyState>& input_assembly_state,
+	const std::shared_ptr<GpuShaderState>& vertex_shader_state,
+	const std::shared_ptr<GpuShaderState>& pixel_shader_state,
+	const std::shared_ptr<GpuDepthStencilState>& depth_stencil_state,
+	const std::shared_ptr<GpuBlendState>& blend_state,
+	const std::shared_ptr<GpuRasterizationState>& rasterization_state,
+	const std::shared_ptr<GpuGraphicsPipeline>& fallback)
+	-> std::shared_ptr<GpuAsyncGraphicsPipeline>
+{
+	const auto key = graphicsPipelineKey(
+		render_pass,
+		resource_layout,
+		input_assembly_state,
+		vertex_shader_state,
+		pixel_shader_state,
+		depth_stencil_state,
+		blend_state,
+		rasterization_state);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// the pipeline is compiled, we return a ready handle
+	if (const auto it = mGraphicsPipelines.find(key); it != mGraphicsPipelines.end()) {
+		std::promise<std::shared_ptr<GpuGraphicsPipeline>> promise;
+
+		promise.set_value(it->second);
+
+		return std::make_shared<GpuAsyncGraphicsPipeline>(promise.get_future().share(), fallback);
+	}
+
+	// the pipeline is compiling, we share the same future
+	if (const auto it = mCompilingPipelines.find(key); it != mCompilingPipelines.end())
+		return std::make_shared<GpuAsyncGraphicsPipeline>(it->second, fallback);
+
+	if (mCompileThreads == nullptr) mCompileThreads = std::make_unique<ThreadPool>(mCompileThreadCount);
+
+	// the task creates the pipeline with createGraphicsPipeline, so the pipeline is cached when it is finished
+	// the exception of compilation is kept in the future
+	const auto task = std::make_shared<std::packaged_task<std::shared_ptr<GpuGraphicsPipeline>()>>(
+		[=]()
+		{
+			return createGraphicsPipeline(
+				render_pass,
+				resource_layout,
+				input_assembly_state,
+				vertex_shader_state,
+				pixel_shader_state,
+				depth_stencil_state,
+				blend_state,
+				rasterization_state);
+		});
+
+	const auto future = task->get_future().share();
+
+	mCompilingPipelines.insert({ key, future });
+
+	mCompileThreads->push([this, task, key]()
+		{
+			(*task)();
+
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			mCompilingPipelines.erase(key);
+		});
+
+	return std::make_shared<GpuAsyncGraphicsPipeline>(future, fallback);
+}
+
+void CodeRed::GpuPipelineFactory::setCompileThreadCount(const size_t count)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		count == 0,
+		ZeroException<size_t>({ "count" })
+	);
+
+	std::unique_ptr<ThreadPool> compileThreads;
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mCompileThreadCount = count;
+
+		// the new threads are created when we compile the next pipeline
+		compileThreads = std::move(mCompileThreads);
+	}
+
+	// the old threads finish their tasks before they exit, the tasks need the lock
+	// so we can not destroy them with the lock
+	compileThreads.reset();
+}
+
+auto CodeRed::GpuPipelineFactory::pendingCompileCount() -> size_t
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	return mCompilingPipelines.size();
+}
+
+void CodeRed::GpuPipelineFactory::clearCache()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mInputAssemblyStates.clear();
+	mRasterizationStates.clear();
+	mDepthStencilStates.clear();
+	mShaderStates.clear();
+	mBlendStates.clear();
+
+	mGraphicsPipelines.clear();
+}
+
+auto CodeRed::GpuPipelineFactory::graphicsPipelineKey(
+	const std::shared_ptr<GpuRenderPass>& render_pass,
+	const std::shared_ptr<GpuResourceLayout>& resource_layout,
+	const std::shared_ptr<GpuInputAssemblyState>& input_assembly_state,
+	const std::shared_ptr<GpuShaderState>& vertex_shader_state,
+	const std::shared_ptr<GpuShaderState>& pixel_shader_state,
+	const std::shared_ptr<GpuDepthStencilState>& depth_stencil_state,
+	const std::shared_ptr<GpuBlendState>& blend_state,
+	const std::shared_ptr<GpuRasterizationState>& rasterization_state)
+	-> GraphicsPipelineKey
+{
+	// the identical state objects are shared by factory, so we can use their addresses as key
+	// the cached pipeline holds the state objects, so the addresses can not be reused
+	return {
+		render_pass.get(),
+		resource_layout.get(),
+		input_assembly_state.get(),
+		vertex_shader_state.get(),
+		pixel_shader_state.get(),
+		depth_stencil_state.get(),
+		blend_state.get(),
+		rasterization_state.get()
+	};
+}
+
+auto CodeRed::GpuPipelineFactory::StateDescriptionHash::operator()(const StateDescription& description) const noexcept -> size_t
+{
+	return static_cast<size_t>(Hash::bytes(description.data(), description.size()));
+}
+
+void CodeRed::GpuPipelineFactory::describe(StateDescription& description, const std::string& value)
+{
+	describe(description, value.size());
+
+	description.insert(description.end(), value.begin(), value.end());
+}
+
+auto CodeRed::GpuPipelineFactory::inputAssemblyStateKey(
+	const std::vector<InputLayoutElement>& elements,
+	const PrimitiveTopology primitive_topology)
+	-> StateDescription
+{
+	StateDescription description;
+
+	describe(description, primitive_topology);
+	describe(description, elements.size());
+
+	for (const auto& element : elements) {
+		describe(description, element.Name);
+		describe(description, element.Format);
+		describe(description, element.Slot);
+		describe(description, element.Rate);
+		describe(description, element.StepRate);
+		describe(description, element.Offset);
+		describe(description, element.Stride);
+	}
+
+	return description;
+}
+
+auto CodeRed::GpuPipelineFactory::rasterizationStateKey(
+	const FrontFace front_face,
+	const CullMode cull_mode,
+	const FillMode fill_mode,
+	const bool depth_clamp)
+	-> StateDescription
+{
+	StateDescription description;
+
+	describe(description, front_face);
+	describe(description, cull_mode);
+	describe(description, fill_mode);
+	describe(description, depth_clamp);
+
+	return description;
+}
+
+auto CodeRed::GpuPipelineFactory::depthStencilStateKey(
+	const bool depth_enable,
+	const bool depth_write_enable,
+	const bool stencil_enable,
+	const CompareOperator depth_operator,
+	const StencilOperatorInfo& front,
+	const StencilOperatorInfo& back)
+	-> StateDescription
+{
+	StateDescription description;
+
+	describe(description, depth_enable);
+	describe(description, depth_write_enable);
+	describe(description, stencil_enable);
+	describe(description, depth_operator);
+
+	for (const auto& info : { front, back }) {
+		describe(description, info.CompareOperator);
+		describe(description, info.FailOperator);
+		describe(description, info.PassOperator);
+		describe(description, info.DepthFailOperator);
+	}
+
+	return description;
+}
+
+auto CodeRed::GpuPipelineFactory::shaderStateKey(
+	const ShaderType type,
+	const std::vector<Byte>& code,
+	const std::string& name)
+	-> StateDescription
+{
+	StateDescription description;
+
+	describe(description, type);
+	describe(description, name);
+	describe(description, code.size());
+
+	description.insert(description.end(), code.begin(), code.end());
+
+	return description;
+}
+
+auto CodeRed::GpuPipelineFactory::blendStateKey(
+	const std::vector<BlendProperty>& properties)
+	-> StateDescription
+{
+	StateDescription description;
+
+	describe(description, properties.size());
+
+	for (const auto& property : properties) {
+		describe(description, property.ColorOperator);
+		describe(description, property.AlphaOperator);
+		describe(description, property.DestinationAlpha);
+		describe(description, property.Destination);
+		describe(description, property.SourceAlpha);
+		describe(description, property.Source);
+		describe(description, property.ColorMask);
+		describe(description, property.Enable);
+	}
+
+	return description;
+}
\ No newline at end of file
@@ -4,6 +4,8 @@
 #include "../../Shared/LayoutElement.hpp"
 #include "../../Shared/BlendProperty.hpp"
 #include "../../Shared/Noncopyable.hpp"
+#include "../../Shared/ThreadPool.hpp"
+#include "../../Shared/Utility.hpp"
 
 #include "../../Shared/Enum/PrimitiveTopology.hpp"
 #include "../../Shared/Enum/ShaderType.hpp"
@@ -11,26 +13,45 @@
 #include "../../Shared/Enum/CullMode.hpp"
 #include "../../Shared/Enum/FillMode.hpp"
 
+#include <unordered_map>
+#include <type_traits>
+#include <future>
+#include <string>
 #include <vector>
 #include <memory>
+#include <mutex>
+#include <array>
+#include <map>
 
 namespace CodeRed {
 
 
+	class GpuAsyncGraphicsPipeline;
 	class GpuLogicalDevice;
+	class GpuGraphicsPipeline;
+	class GpuResourceLayout;
+	class GpuRenderPass;
 	class GpuInputAssemblyState;
 	class GpuRasterizationState;
 	class GpuDepthStencilState;
 	class GpuShaderState;
 	class GpuBlendState;
 	
+	/*
+	 * GpuPipelineFactory caches the state objects and pipelines it creates.
+	 * the state objects are keyed by their description(and shader code), we use the hash of description
+	 * to find them and compare the description when we find one, so the identical requests return the same object.
+	 * the pipelines are keyed by the state objects they use, so we should create the pipelines
+	 * with the factory if we want to share them.
+	 * the pipelines can be compiled on the worker threads of factory, the threads are created when we need them.
+	 */
 	class GpuPipelineFactory : public Noncopyable {
 	protected:
 		explicit GpuPipelineFactory(
-			const std::shared_ptr<GpuLogicalDevice> &device) :
-			mDevice(device) {}
+			const std::shared_ptr<GpuLogicalDevice> &device);
 
-		virtual ~GpuPipelineFactory() = default;
+		// the pipelines in compiling queue are finished before the factory is destroyed
+		virtual ~GpuPipelineFactory();
 	public:
 		virtual auto createInputAssemblyState(
 			const std::vector<InputLayoutElement>& elements,
@@ -65,8 +86,156 @@ namespace CodeRed {
 
 		virtual auto createBlendState(const size_t numRenderTargets)
 			-> std::shared_ptr<GpuBlendState> = 0;
+
+		auto createGraphicsPipeline(
+			const std::shared_ptr<GpuRenderPass>& render_pass,
+			const std::shared_ptr<GpuResourceLayout>& resource_layout,
+			const std::shared_ptr<GpuInputAssemblyState>& input_assembly_state,
+			const std::shared_ptr<GpuShaderState>& vertex_shader_state,
+			const std::shared_ptr<GpuShaderState>& pixel_shader_state,
+			const std::shared_ptr<GpuDepthStencilState>& depth_stencil_state,
+			const std::shared_ptr<GpuBlendState>& blend_state,
+			const std::shared_ptr<GpuRasterizationState>& rasterization_state)
+			-> std::shared_ptr<GpuGraphicsPipeline>;
+
+		auto createGraphicsPipelineAsync(
+			const std::shared_ptr<GpuRenderPass>& render_pass,
+			const std::shared_ptr<GpuResourceLayout>& resource_layout,
+			const std::shared_ptr<GpuInputAssemblyState>& input_assembly_state,
+			const std::shared_ptr<GpuShaderState>& vertex_shader_state,
+			const std::shared_ptr<GpuShaderState>& pixel_shader_state,
+			const std::shared_ptr<GpuDepthStencilState>& depth_stencil_state,
+			const std::shared_ptr<GpuBlendState>& blend_state,
+			const std::shared_ptr<GpuRasterizationState>& rasterization_state,
+			const std::shared_ptr<GpuGraphicsPipeline>& fallback = nullptr)
+			-> std::shared_ptr<GpuAsyncGraphicsPipeline>;
+
+		// release the cached objects, the objects in use are still valid
+		void clearCache();
+
+		// the max number of threads to compile pipelines, the default is half of hardware threads
+		void setCompileThreadCount(const size_t count);
+
+		auto compileThreadCount() const noexcept -> size_t { return mCompileThreadCount; }
+
+		// the number of pipelines are compiling or waiting to compile
+		auto pendingCompileCount() -> size_t;
+	protected:
+		using GraphicsPipelineKey = std::array<const void*, 8>;
+		using GraphicsPipelineFuture = std::shared_future<std::shared_ptr<GpuGraphicsPipeline>>;
+
+		// the bytes of description, the map compares them when the hashes are same
+		// so two different descriptions with same hash do not share the state object
+		using StateDescription = std::vector<Byte>;
+
+		struct StateDescriptionHash {
+			auto operator()(const StateDescription& description) const noexcept -> size_t;
+		};
+
+		template<typename T>
+		static void describe(StateDescription& description, const T& value);
+
+		static void describe(StateDescription& description, const std::string& value);
+
+		template<typename Map, typename Creator>
+		auto findOrCreate(
+			Map& cache,
+			const typename Map::key_type& key,
+			const Creator& creator)
+			-> typename Map::mapped_type;
+		
+		static auto graphicsPipelineKey(
+			const std::shared_ptr<GpuRenderPass>& render_pass,
+			const std::shared_ptr<GpuResourceLayout>& resource_layout,
+			const std::shared_ptr<GpuInputAssemblyState>& input_assembly_state,
+			const std::shared_ptr<GpuShaderState>& vertex_shader_state,
+			const std::shared_ptr<GpuShaderState>& pixel_shader_state,
+			const std::shared_ptr<GpuDepthStencilState>& depth_stencil_state,
+			const std::shared_ptr<GpuBlendState>& blend_state,
+			const std::shared_ptr<GpuRasterizationState>& rasterization_state)
+			-> GraphicsPipelineKey;
+		
+		static auto inputAssemblyStateKey(
+			const std::vector<InputLayoutElement>& elements,
+			const PrimitiveTopology primitive_topology)
+			-> StateDescription;
+
+		static auto rasterizationStateKey(
+			const FrontFace front_face,
+			const CullMode cull_mode,
+			const FillMode fill_mode,
+			const bool depth_clamp)
+			-> StateDescription;
+
+		static auto depthStencilStateKey(
+			const bool depth_enable,
+			const bool depth_write_enable,
+			const bool stencil_enable,
+			const CompareOperator depth_operator,
+			const StencilOperatorInfo& front,
+			const StencilOperatorInfo& back)
+			-> StateDescription;
+
+		static auto shaderStateKey(
+			const ShaderType type,
+			const std::vector<Byte>& code,
+			const std::string& name)
+			-> StateDescription;
+
+		static auto blendStateKey(
+			const std::vector<BlendProperty>& properties)
+			-> StateDescription;
 	protected:
 		std::shared_ptr<GpuLogicalDevice> mDevice;
+
+		std::unordered_map<StateDescription, std::shared_ptr<GpuInputAssemblyState>, StateDescriptionHash> mInputAssemblyStates;
+		std::unordered_map<StateDescription, std::shared_ptr<GpuRasterizationState>, StateDescriptionHash> mRasterizationStates;
+		std::unordered_map<StateDescription, std::shared_ptr<GpuDepthStencilState>, StateDescriptionHash> mDepthStencilStates;
+		std::unordered_map<StateDescription, std::shared_ptr<GpuShaderState>, StateDescriptionHash> mShaderStates;
+		std::unordered_map<StateDescription, std::shared_ptr<GpuBlendState>, StateDescriptionHash> mBlendStates;
+
+		std::map<GraphicsPipelineKey, std::shared_ptr<GpuGraphicsPipeline>> mGraphicsPipelines;
+		std::map<GraphicsPipelineKey, GraphicsPipelineFuture> mCompilingPipelines;
+
+		std::unique_ptr<ThreadPool> mCompileThreads;
+
+		size_t mCompileThreadCount = 1;
+		
+		std::mutex mMutex;
 	};
+
+	template <typename T>
+	void GpuPipelineFactory::describe(StateDescription& description, const T& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "the value must be trivially copyable.");
+
+		const auto bytes = reinterpret_cast<const Byte*>(&value);
+
+		description.insert(description.end(), bytes, bytes + sizeof(T));
+	}
+
+	template <typename Map, typename Creator>
+	auto GpuPipelineFactory::findOrCreate(
+		Map& cache,
+		const typename Map::key_type& key,
+		const Creator& creator)
+		-> typename Map::mapped_type
+	{
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+
+			const auto it = cache.find(key);
+
+			if (it != cache.end()) return it->second;
+		}
+
+		// we do not hold the lock when we create the object, so the pipelines can be created in parallel
+		const typename Map::mapped_type object = creator();
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		// if other thread created the same object at the same time, we use the first one
+		return cache.insert({ key, object }).first->second;
+	}
 	
 }
\ No newline at end of file
@@ -0,0 +1,547 @@
+#include "../Shared/Exception/InvalidException.hpp"
+#include "../Shared/Exception/ZeroException.hpp"
+
+#include "GpuResource/GpuTexture.hpp"
+
+#include "GpuGraphicsCommandList.hpp"
+#include "GpuLogicalDevice.hpp"
+#include "GpuRenderGraph.hpp"
+#include "GpuFrameBuffer.hpp"
+#include "GpuRenderPass.hpp"
+#include "GpuTextureRef.hpp"
+
+#include <algorithm>
+
+auto CodeRed::GpuRenderGraph::Builder::read(const Handle texture, const ResourceLayout layout) -> Builder&
+{
+	CODE_RED_DEBUG_THROW_IF(
+		texture >= mGraph->mResources.size(),
+		InvalidException<Handle>({ "texture" })
+	);
+
+	// the transient texture is undefined before it is written
+	CODE_RED_DEBUG_THROW_IF(
+		!mGraph->mResources[texture].Imported && !mGraph->mResources[texture].Written,
+		InvalidException<Handle>({ "texture" },
+			{ "The transient texture should be written by the passes before it is read." })
+	);
+
+	mGraph->mPasses[mPass].Reads.push_back({ texture, layout, AttachmentLoad::Load });
+
+	return *this;
+}
+
+auto CodeRed::GpuRenderGraph::Builder::write(const Handle texture, const ResourceLayout layout) -> Builder&
+{
+	CODE_RED_DEBUG_THROW_IF(
+		texture >= mGraph->mResources.size(),
+		InvalidException<Handle>({ "texture" })
+	);
+
+	mGraph->mPasses[mPass].Writes.push_back({ texture, layout, AttachmentLoad::Load });
+	mGraph->mResources[texture].Written = true;
+
+	return *this;
+}
+
+auto CodeRed::GpuRenderGraph::Builder::renderTarget(const Handle texture, const AttachmentLoad load) -> Builder&
+{
+	CODE_RED_DEBUG_THROW_IF(
+		texture >= mGraph->mResources.size(),
+		InvalidException<Handle>({ "texture" })
+	);
+
+	auto& resource = mGraph->mResources[texture];
+
+	if (!resource.Imported) resource.Info.Usage = resource.Info.Usage | ResourceUsage::RenderTarget;
+
+	mGraph->mPasses[mPass].RenderTargets.push_back({ texture, ResourceLayout::RenderTarget, load });
+	resource.Written = true;
+
+	return *this;
+}
+
+auto CodeRed::GpuRenderGraph::Builder::depthStencil(const Handle texture, const AttachmentLoad load) -> Builder&
+{
+	CODE_RED_DEBUG_THROW_IF(
+		texture >= mGraph->mResources.size(),
+		InvalidException<Handle>({ "texture" })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		mGraph->mPasses[mPass].DepthStencil.has_value(),
+		InvalidException<Handle>({ "texture" },
+			{ "The pass can only have one depth stencil." })
+	);
+
+	auto& resource = mGraph->mResources[texture];
+
+	if (!resource.Imported) resource.Info.Usage = resource.Info.Usage | ResourceUsage::DepthStencil;
+
+	mGraph->mPasses[mPass].DepthStencil = Access{ texture, ResourceLayout::DepthStencil, load };
+	resource.Written = true;
+
+	return *this;
+}
+
+auto CodeRed::GpuRenderGraph::Builder::sideEffect() -> Builder&
+{
+	mGraph->mPasses[mPass].SideEffect = true;
+
+	return *this;
+}
+
+auto CodeRed::GpuRenderGraph::Context::texture(const Handle texture) const -> std::shared_ptr<GpuTexture>
+{
+	return mGraph->mResources[texture].Texture;
+}
+
+CodeRed::GpuRenderGraph::GpuRenderGraph(
+	const std::shared_ptr<GpuLogicalDevice>& device) :
+	mDevice(device)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mDevice == nullptr,
+		ZeroException<GpuLogicalDevice>({ "device" })
+	);
+}
+
+auto CodeRed::GpuRenderGraph::createTexture(
+	const std::string& name,
+	const ResourceInfo& info) -> Handle
+{
+	CODE_RED_DEBUG_THROW_IF(
+		!std::holds_alternative<TextureProperty>(info.Property),
+		InvalidException<ResourceInfo>({ "info" },
+			{ "The transient resource should be texture." })
+	);
+
+	Resource resource;
+
+	resource.Name = name;
+	resource.Info = info;
+
+	mResources.push_back(resource);
+
+	return mResources.size() - 1;
+}
+
+auto CodeRed::GpuRenderGraph::importTexture(
+	const std::string& name,
+	const std::shared_ptr<GpuTexture>& texture,
+	const std::optional<ResourceLayout>& final_layout) -> Handle
+{
+	CODE_RED_DEBUG_THROW_IF(
+		texture == nullptr,
+		ZeroException<GpuTexture>({ "texture" })
+	);
+
+	Resource resource;
+
+	resource.Name = name;
+	resource.Info = texture->info();
+	resource.Texture = texture;
+	resource.FinalLayout = final_layout;
+	resource.Imported = true;
+
+	mResources.push_back(resource);
+
+	return mResources.size() - 1;
+}
+
+void CodeRed::GpuRenderGraph::addPass(
+	const std::string& name,
+	const Setup& setup,
+	const Execute& execute)
+{
+	Pass pass;
+
+	pass.Name = name;
+	pass.Function = execute;
+
+	mPasses.push_back(pass);
+
+	Builder builder(this, mPasses.size() - 1);
+
+	if (setup) setup(builder);
+}
+
+void CodeRed::GpuRenderGraph::execute(const std::shared_ptr<GpuGraphicsCommandList>& list)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		list == nullptr,
+		ZeroException<GpuGraphicsCommandList>({ "list" })
+	);
+
+	mStatistics = Statistics();
+
+	// we do not know the accesses of imported textures outside the graph
+	for (auto& resource : mResources) resource.Last = LastAccess();
+	
+	cull();
+	allocate();
+
+	for (auto& pass : mPasses) {
+		if (pass.Culled) continue;
+
+		for (const auto& access : pass.Reads) transition(list, access.Texture, access.Layout, false);
+		for (const auto& access : pass.Writes) transition(list, access.Texture, access.Layout, true);
+		for (const auto& access : pass.RenderTargets) transition(list, access.Texture, access.Layout, true);
+
+		if (pass.DepthStencil.has_value()) transition(list, pass.DepthStencil->Texture, pass.DepthStencil->Layout, true);
+
+		Context context(this, list);
+
+		// the attachments are translated before, so the layouts of render pass are not changed
+		if (!pass.RenderTargets.empty() || pass.DepthStencil.has_value()) {
+			const auto target = this->target(pass);
+
+			context.mRenderPass = target.RenderPass;
+			context.mFrameBuffer = target.FrameBuffer;
+
+			list->beginRenderPass(context.mRenderPass, context.mFrameBuffer);
+		}
+
+		if (pass.Function) pass.Function(context);
+
+		if (context.mRenderPass != nullptr) list->endRenderPass();
+
+		mStatistics.Passes++;
+	}
+
+	for (size_t index = 0; index < mResources.size(); index++) {
+		CODE_RED_TRY_EXECUTE(
+			mResources[index].Imported && mResources[index].FinalLayout.has_value(),
+			transition(list, index, mResources[index].FinalLayout.value(), false)
+		);
+	}
+
+	evict();
+}
+
+void CodeRed::GpuRenderGraph::reset()
+{
+	mResources.clear();
+	mPasses.clear();
+}
+
+void CodeRed::GpuRenderGraph::clear()
+{
+	reset();
+
+	mPhysicals.clear();
+	mReferences.clear();
+	mTargets.clear();
+}
+
+auto CodeRed::GpuRenderGraph::compatible(const ResourceInfo& left, const ResourceInfo& right) -> bool
+{
+	const auto& leftProperty = std::get<TextureProperty>(left.Property);
+	const auto& rightProperty = std::get<TextureProperty>(right.Property);
+
+	// the clear value is not compared, we set the clear value of transient texture to the render pass of every pass
+	// in DirectX12 mode, the clear value of texture is only an optimization of clear operation
+	return
+		leftProperty.Width == rightProperty.Width &&
+		leftProperty.Height == rightProperty.Height &&
+		leftProperty.Depth == rightProperty.Depth &&
+		leftProperty.MipLevels == rightProperty.MipLevels &&
+		leftProperty.Format == rightProperty.Format &&
+		leftProperty.Sample == rightProperty.Sample &&
+		leftProperty.Dimension == rightProperty.Dimension &&
+		left.Usage == right.Usage &&
+		left.Type == right.Type &&
+		left.Heap == right.Heap;
+}
+
+void CodeRed::GpuRenderGraph::cull()
+{
+	// the ref count of pass is the number of textures it writes
+	// the ref count of texture is the number of passes read it, the imported textures are used by outside
+	for (auto& resource : mResources) resource.RefCount = resource.Imported ? 1 : 0;
+
+	for (auto& pass : mPasses) {
+		pass.RefCount = pass.Writes.size() + pass.RenderTargets.size() + (pass.DepthStencil.has_value() ? 1 : 0);
+		pass.Culled = false;
+
+		for (const auto& access : pass.Reads) mResources[access.Texture].RefCount++;
+	}
+
+	std::vector<Handle> unreferenced;
+
+	const auto cullPass = [&](Pass& pass)
+	{
+		pass.Culled = true;
+
+		for (const auto& access : pass.Reads) {
+			if (--mResources[access.Texture].RefCount == 0)
+				unreferenced.push_back(access.Texture);
+		}
+	};
+
+	for (Handle index = 0; index < mResources.size(); index++) {
+		if (mResources[index].RefCount == 0) unreferenced.push_back(index);
+	}
+
+	for (auto& pass : mPasses) {
+		if (pass.RefCount == 0 && !pass.SideEffect) cullPass(pass);
+	}
+
+	// if a texture is not used, the passes that write it are not needed too
+	while (!unreferenced.empty()) {
+		const auto texture = unreferenced.back();
+
+		unreferenced.pop_back();
+
+		for (auto& pass : mPasses) {
+			if (pass.Culled || pass.SideEffect) continue;
+
+			size_t count = 0;
+
+			for (const auto& access : pass.Writes) count += access.Texture == texture ? 1 : 0;
+			for (const auto& access : pass.RenderTargets) count += access.Texture == texture ? 1 : 0;
+
+			if (pass.DepthStencil.has_value() && pass.DepthStencil->Texture == texture) count++;
+
+			if (count == 0) continue;
+
+			pass.RefCount -= count;
+
+			if (pass.RefCount == 0) cullPass(pass);
+		}
+	}
+
+	for (const auto& pass : mPasses) {
+		if (pass.Culled) mStatistics.CulledPasses++;
+	}
+}
+
+void CodeRed::GpuRenderGraph::allocate()
+{
+	for (auto& resource : mResources) resource.Used = false;
+	for (auto& physical : mPhysicals) physical.Used = false;
+
+	// find the lifetimes of textures, the lifetime is from the first pass to the last pass that use it
+	for (size_t index = 0; index < mPasses.size(); index++) {
+		const auto& pass = mPasses[index];
+
+		if (pass.Culled) continue;
+
+		const auto use = [&](const Access& access)
+		{
+			auto& resource = mResources[access.Texture];
+
+			if (!resource.Used) resource.FirstPass = index;
+
+			resource.LastPass = index;
+			resource.Used = true;
+		};
+
+		for (const auto& access : pass.Reads) use(access);
+		for (const auto& access : pass.Writes) use(access);
+		for (const auto& access : pass.RenderTargets) use(access);
+
+		if (pass.DepthStencil.has_value()) use(pass.DepthStencil.value());
+	}
+
+	std::vector<Handle> transients;
+
+	for (Handle index = 0; index < mResources.size(); index++) {
+		if (!mResources[index].Imported && mResources[index].Used) transients.push_back(index);
+	}
+
+	std::sort(transients.begin(), transients.end(), [&](const Handle left, const Handle right)
+		{
+			return mResources[left].FirstPass < mResources[right].FirstPass;
+		});
+
+	// we assign the textures in the order of their first pass, a physical texture can be reused
+	// if its last texture is finished before the first pass of new texture
+	for (const auto index : transients) {
+		auto& resource = mResources[index];
+
+		size_t physical = 0;
+
+		for (; physical < mPhysicals.size(); physical++) {
+			const auto& candidate = mPhysicals[physical];
+
+			if (compatible(candidate.Info, resource.Info) &&
+				(!candidate.Used || candidate.LastPass < resource.FirstPass)) break;
+		}
+
+		if (physical == mPhysicals.size()) {
+			Physical newPhysical;
+
+			newPhysical.Info = resource.Info;
+			newPhysical.Texture = mDevice->createTexture(resource.Info);
+			newPhysical.Reference = newPhysical.Texture->reference();
+
+			mPhysicals.push_back(newPhysical);
+		}
+
+		mPhysicals[physical].LastPass = resource.LastPass;
+		mPhysicals[physical].Used = true;
+
+		resource.Physical = physical;
+		resource.Texture = mPhysicals[physical].Texture;
+
+		mStatistics.TransientTextures++;
+		mStatistics.TransientMemory += resource.Texture->physicalSize();
+	}
+
+	for (const auto& physical : mPhysicals) {
+		if (!physical.Used) continue;
+
+		mStatistics.PhysicalTextures++;
+		mStatistics.AliasedMemory += physical.Texture->physicalSize();
+	}
+}
+
+void CodeRed::GpuRenderGraph::transition(
+	const std::shared_ptr<GpuGraphicsCommandList>& list,
+	const Handle texture,
+	const ResourceLayout layout,
+	const bool write)
+{
+	const auto& resource = mResources[texture].Texture;
+
+	// the physical texture may be used by other transient textures before, so we use its last access
+	auto& last = mResources[texture].Imported ? mResources[texture].Last : mPhysicals[mResources[texture].Physical].Last;
+	
+	auto changed = false;
+
+	for (size_t arraySlice = 0; arraySlice < resource->arrays(); arraySlice++) {
+		for (size_t mipSlice = 0; mipSlice < resource->mipLevels(); mipSlice++)
+			changed = changed || resource->layout(mipSlice, arraySlice) != layout;
+	}
+
+	// translate the texture if some sub-textures are not in the layout, the transition is also a barrier
+	// if the layout is not changed, we still need a barrier when the last access or this access writes the texture
+	if (changed) {
+		list->layoutTransition(reference(texture), layout);
+
+		mStatistics.Transitions++;
+	}
+	else if (last.Valid && (last.Write || write)) {
+		list->memoryBarrier(reference(texture));
+
+		mStatistics.Barriers++;
+	}
+
+	last.Valid = true;
+	last.Write = write;
+}
+
+void CodeRed::GpuRenderGraph::evict()
+{
+	// the gpu may still use them in the commands we recorded before
+	// so we defer the destruction until the queues finish the submitted commands
+	for (auto it = mReferences.begin(); it != mReferences.end();) {
+		if (it->second.Used) { it->second.Used = false; ++it; continue; }
+
+		mDevice->deferDestruction([reference = it->second.Value]() {});
+
+		it = mReferences.erase(it);
+	}
+
+	for (auto it = mTargets.begin(); it != mTargets.end();) {
+		if (it->second.Used) { it->second.Used = false; ++it; continue; }
+
+		mDevice->deferDestruction([target = it->second]() {});
+
+		it = mTargets.erase(it);
+	}
+}
+
+auto CodeRed::GpuRenderGraph::reference(const Handle texture) -> std::shared_ptr<GpuTextureRef>
+{
+	const auto& resource = mResources[texture];
+
+	if (!resource.Imported) return mPhysicals[resource.Physical].Reference;
+
+	auto& reference = mReferences[resource.Texture.get()];
+
+	if (reference.Value == nullptr) reference.Value = resource.Texture->reference();
+
+	reference.Used = true;
+
+	return reference.Value;
+}
+
+auto CodeRed::GpuRenderGraph::target(const Pass& pass) -> Target
+{
+	// the key of render pass and frame buffer is the textures and load operators of attachments
+	std::vector<size_t> key = { pass.RenderTargets.size() };
+
+	for (const auto& access : pass.RenderTargets) {
+		key.push_back(reinterpret_cast<size_t>(mResources[access.Texture].Texture.get()));
+		key.push_back(static_cast<size_t>(access.Load));
+	}
+
+	if (pass.DepthStencil.has_value()) {
+		key.push_back(reinterpret_cast<size_t>(mResources[pass.DepthStencil->Texture].Texture.get()));
+		key.push_back(static_cast<size_t>(pass.DepthStencil->Load));
+	}
+
+	// the transient textures that share one texture can have different clear values
+	// so we use the clear values of them instead of the texture and set them for every pass
+	const auto clearValue = [&](const Handle texture)
+	{
+		return std::get<TextureProperty>(mResources[texture].Info.Property).ClearValue;
+	};
+
+	std::vector<ClearValue> clears;
+	std::optional<ClearValue> depthClear;
+
+	for (const auto& access : pass.RenderTargets) clears.push_back(clearValue(access.Texture));
+
+	if (pass.DepthStencil.has_value()) depthClear = clearValue(pass.DepthStencil->Texture);
+	
+	const auto it = mTargets.find(key);
+
+	if (it != mTargets.end()) {
+		it->second.RenderPass->setClear(clears, depthClear);
+		it->second.Used = true;
+
+		return it->second;
+	}
+
+	std::vector<std::shared_ptr<GpuTextureRef>> renderTargets;
+	std::vector<Attachment> colors;
+
+	std::shared_ptr<GpuTextureRef> depthStencil;
+	std::optional<Attachment> depth;
+
+	// the initial and final layouts are same, the graph translates the attachments itself
+	for (const auto& access : pass.RenderTargets) {
+		const auto& texture = mResources[access.Texture].Texture;
+
+		renderTargets.push_back(reference(access.Texture));
+		colors.push_back(Attachment::RenderTargetMultiSample(
+			texture->format(), texture->sample(),
+			ResourceLayout::RenderTarget,
+			ResourceLayout::RenderTarget,
+			access.Load, AttachmentStore::Store));
+	}
+
+	if (pass.DepthStencil.has_value()) {
+		const auto& texture = mResources[pass.DepthStencil->Texture].Texture;
+
+		depthStencil = reference(pass.DepthStencil->Texture);
+		depth = Attachment::DepthStencilMultiSample(
+			texture->format(), texture->sample(),
+			ResourceLayout::DepthStencil,
+			ResourceLayout::DepthStencil,
+			pass.DepthStencil->Load, AttachmentStore::Store,
+			pass.DepthStencil->Load, AttachmentStore::Store);
+	}
+
+	Target target;
+
+	target.RenderPass = mDevice->createRenderPass(colors, depth);
+	target.RenderPass->setClear(clears, depthClear);
+	target.FrameBuffer = mDevice->createFrameBuffer(renderTargets, depthStencil);
+	target.Used = true;
+
+	return mTargets[key] = target;
+}
\ No newline at end of file
@@ -0,0 +1,272 @@
+#pragma once
+
+#include "../Shared/Information/ResourceInfo.hpp"
+#include "../Shared/Enum/AttachmentLoad.hpp"
+#include "../Shared/Noncopyable.hpp"
+#include "../Shared/Utility.hpp"
+
+#include <functional>
+#include <optional>
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+
+namespace CodeRed {
+
+	class GpuGraphicsCommandList;
+	class GpuLogicalDevice;
+	class GpuFrameBuffer;
+	class GpuRenderPass;
+	class GpuTextureRef;
+	class GpuTexture;
+
+	/*
+	 * GpuRenderGraph records a frame as a list of passes, every pass declares the textures it reads and writes.
+	 * when we execute the graph, we cull the passes whose outputs are never used, translate the textures before
+	 * the passes only if their layouts are changed, and create the render passes and frame buffers of passes.
+	 * the transient textures are created by graph, if two transient textures have same information(except the
+	 * clear value) and their lifetimes are not overlapped, they will share one texture(and its memory).
+	 * if a texture is written before or after another access in same layout, we add a memory barrier between them.
+	 * the passes are executed in the order we add them, a pass can only read the textures written by passes before it.
+	 */
+	class GpuRenderGraph final : public Noncopyable {
+	public:
+		using Handle = size_t;
+
+		class Builder;
+		class Context;
+
+		using Setup = std::function<void(Builder& builder)>;
+		using Execute = std::function<void(const Context& context)>;
+
+		struct Statistics {
+			size_t Passes = 0;
+			size_t CulledPasses = 0;
+			size_t Transitions = 0;
+			size_t Barriers = 0;
+
+			size_t TransientTextures = 0;
+			size_t PhysicalTextures = 0;
+
+			// the peak memory of transient textures if every transient texture owns its memory
+			size_t TransientMemory = 0;
+			// the peak memory of transient textures with aliasing
+			size_t AliasedMemory = 0;
+		};
+
+		/*
+		 * the builder of pass, we use it to declare the textures the pass reads and writes in setup
+		 */
+		class Builder final {
+		public:
+			auto read(const Handle texture, const ResourceLayout layout = ResourceLayout::GeneralRead) -> Builder&;
+
+			auto write(const Handle texture, const ResourceLayout layout = ResourceLayout::GeneralReadWrite) -> Builder&;
+
+			auto renderTarget(const Handle texture, const AttachmentLoad load = AttachmentLoad::Clear) -> Builder&;
+
+			auto depthStencil(const Handle texture, const AttachmentLoad load = AttachmentLoad::Clear) -> Builder&;
+
+			/*
+			 * the pass has side effect(for example, copy to a read back buffer), it will not be culled
+			 */
+			auto sideEffect() -> Builder&;
+		private:
+			friend class GpuRenderGraph;
+
+			Builder(GpuRenderGraph* graph, const size_t pass) : mGraph(graph), mPass(pass) {}
+
+			GpuRenderGraph* mGraph;
+			size_t mPass;
+		};
+
+		/*
+		 * the context of pass when it is executed, if the pass has render targets or depth stencil,
+		 * the render pass is began before the execute and ended after the execute
+		 */
+		class Context final {
+		public:
+			auto texture(const Handle texture) const -> std::shared_ptr<GpuTexture>;
+
+			auto commandList() const noexcept -> std::shared_ptr<GpuGraphicsCommandList> { return mCommandList; }
+
+			auto renderPass() const noexcept -> std::shared_ptr<GpuRenderPass> { return mRenderPass; }
+
+			auto frameBuffer() const noexcept -> std::shared_ptr<GpuFrameBuffer> { return mFrameBuffer; }
+		private:
+			friend class GpuRenderGraph;
+
+			Context(
+				const GpuRenderGraph* graph,
+				const std::shared_ptr<GpuGraphicsCommandList>& list) :
+				mGraph(graph), mCommandList(list) {}
+
+			const GpuRenderGraph* mGraph;
+
+			std::shared_ptr<GpuGraphicsCommandList> mCommandList;
+			std::shared_ptr<GpuRenderPass> mRenderPass;
+			std::shared_ptr<GpuFrameBuffer> mFrameBuffer;
+		};
+	public:
+		explicit GpuRenderGraph(
+			const std::shared_ptr<GpuLogicalDevice>& device);
+
+		~GpuRenderGraph() = default;
+
+		/*
+		 * create a transient texture, it is created by graph and only valid when the graph is executed
+		 * the render target and depth stencil usage will be added if the passes use it as attachment
+		 */
+		auto createTexture(
+			const std::string& name,
+			const ResourceInfo& info) -> Handle;
+
+		/*
+		 * import a texture that is not owned by graph(for example the back buffer of swap chain)
+		 * if the final layout has value, we will translate the texture to it at the end of graph
+		 */
+		auto importTexture(
+			const std::string& name,
+			const std::shared_ptr<GpuTexture>& texture,
+			const std::optional<ResourceLayout>& final_layout = std::nullopt) -> Handle;
+
+		void addPass(
+			const std::string& name,
+			const Setup& setup,
+			const Execute& execute);
+
+		/*
+		 * record the passes to command list, the command list should be recording
+		 */
+		void execute(const std::shared_ptr<GpuGraphicsCommandList>& list);
+
+		/*
+		 * remove the passes and textures, so we can build the graph of next frame
+		 * the transient textures, render passes and frame buffers are kept to reuse
+		 */
+		void reset();
+
+		/*
+		 * release the transient textures, render passes and frame buffers we kept
+		 * we need to make sure the gpu does not use them(for example, when we resize the swap chain)
+		 */
+		void clear();
+
+		auto statistics() const noexcept -> Statistics { return mStatistics; }
+	private:
+		struct Access {
+			Handle Texture = 0;
+			ResourceLayout Layout = ResourceLayout::GeneralRead;
+			AttachmentLoad Load = AttachmentLoad::Load;
+		};
+
+		// the last access of texture, we use it to find the hazards that layout transitions do not cover
+		struct LastAccess {
+			bool Valid = false;
+			bool Write = false;
+		};
+
+		struct Pass {
+			std::string Name;
+			Execute Function;
+
+			std::vector<Access> Reads;
+			std::vector<Access> Writes;
+
+			std::vector<Access> RenderTargets;
+			std::optional<Access> DepthStencil;
+
+			size_t RefCount = 0;
+
+			bool SideEffect = false;
+			bool Culled = false;
+		};
+
+		struct Resource {
+			std::string Name;
+			ResourceInfo Info;
+
+			std::shared_ptr<GpuTexture> Texture;
+			std::optional<ResourceLayout> FinalLayout;
+
+			// the last access of imported texture in current graph
+			LastAccess Last;
+
+			size_t RefCount = 0;
+			size_t Physical = 0;
+
+			// the first and last pass that use the texture
+			size_t FirstPass = 0;
+			size_t LastPass = 0;
+
+			bool Imported = false;
+			bool Written = false;
+			bool Used = false;
+		};
+
+		struct Physical {
+			ResourceInfo Info;
+
+			std::shared_ptr<GpuTexture> Texture;
+			std::shared_ptr<GpuTextureRef> Reference;
+
+			// the last access of texture, it is kept between graphs
+			// because the texture is aliased and reused by other transient textures
+			LastAccess Last;
+
+			// the last pass that use the texture in current graph
+			size_t LastPass = 0;
+
+			bool Used = false;
+		};
+
+		struct Target {
+			std::shared_ptr<GpuRenderPass> RenderPass;
+			std::shared_ptr<GpuFrameBuffer> FrameBuffer;
+
+			bool Used = false;
+		};
+
+		struct Reference {
+			std::shared_ptr<GpuTextureRef> Value;
+
+			bool Used = false;
+		};
+
+		static auto compatible(const ResourceInfo& left, const ResourceInfo& right) -> bool;
+
+		void cull();
+
+		void allocate();
+
+		void transition(
+			const std::shared_ptr<GpuGraphicsCommandList>& list,
+			const Handle texture,
+			const ResourceLayout layout,
+			const bool write);
+
+		// release the references and targets that are not used in current graph
+		void evict();
+
+		auto reference(const Handle texture) -> std::shared_ptr<GpuTextureRef>;
+
+		auto target(const Pass& pass) -> Target;
+	private:
+		std::shared_ptr<GpuLogicalDevice> mDevice;
+
+		std::vector<Resource> mResources;
+		std::vector<Pass> mPasses;
+
+		std::vector<Physical> mPhysicals;
+
+		// the references of imported textures and the render passes(frame buffers) of passes
+		// we key the render passes with the textures and load operators of attachments
+		// the entries hold the textures, so the addresses of keys are not reused until we evict them
+		std::map<GpuTexture*, Reference> mReferences;
+		std::map<std::vector<size_t>, Target> mTargets;
+
+		Statistics mStatistics;
+	};
+
+}
\ No newline at end of file
@@ -21,6 +21,19 @@ namespace CodeRed {
 		virtual auto mapMemory() const -> void* = 0;
 
 		virtual void unmapMemory() const = 0;
+
+		/*
+		 * the buffer in MemoryHeap::Upload or MemoryHeap::Readback is mapped when it was created and keeps the pointer for its whole life
+		 * mappedRange returns the pointer of [offset, offset + size) without mapping the memory again
+		 * if the memory is not host coherent, use flush after writing and invalidate before reading
+		 */
+		auto mappedRange(const size_t offset, const size_t size) const -> void*;
+
+		virtual void flush(const size_t offset, const size_t size) const = 0;
+
+		virtual void invalidate(const size_t offset, const size_t size) const = 0;
+	protected:
+		void* mMappedMemory = nullptr;
 	};
 	
 }
\ No newline at end of file
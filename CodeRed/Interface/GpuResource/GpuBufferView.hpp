@@ -0,0 +1,49 @@
+#pragma once
+
+#include "GpuBuffer.hpp"
+
+namespace CodeRed {
+
+	/*
+	 * GpuBufferView is a range of buffer, [Offset, Offset + Size)
+	 * we can bind a view as vertex, index or constant buffer,
+	 * so we can pack many meshes or constant blocks into one buffer.
+	 * the Stride is only used by DirectX12 vertex buffer view and group buffer view
+	 */
+	struct GpuBufferView {
+		std::shared_ptr<GpuBuffer> Buffer;
+
+		size_t Offset = 0;
+		size_t Size = 0;
+		size_t Stride = 0;
+
+		GpuBufferView() = default;
+
+		GpuBufferView(
+			const std::shared_ptr<GpuBuffer>& buffer) :
+			Buffer(buffer),
+			Offset(0),
+			Size(buffer->size()),
+			Stride(buffer->stride()) {}
+
+		GpuBufferView(
+			const std::shared_ptr<GpuBuffer>& buffer,
+			const size_t offset,
+			const size_t size) :
+			Buffer(buffer),
+			Offset(offset),
+			Size(size),
+			Stride(buffer->stride()) {}
+
+		GpuBufferView(
+			const std::shared_ptr<GpuBuffer>& buffer,
+			const size_t offset,
+			const size_t size,
+			const size_t stride) :
+			Buffer(buffer),
+			Offset(offset),
+			Size(size),
+			Stride(stride) {}
+	};
+
+}
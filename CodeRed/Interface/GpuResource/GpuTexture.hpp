@@ -3,8 +3,12 @@
 #include "../../Shared/Exception/NotSupportException.hpp"
 #include "../../Shared/Information/TextureRefInfo.hpp"
 
+#include "../../Shared/ValueRange.hpp"
+
 #include "GpuResource.hpp"
 
+#include <vector>
+
 namespace CodeRed {
 
 	class GpuTextureRef;
@@ -51,9 +55,30 @@ namespace CodeRed {
 		auto physicalSize() const -> size_t { return mPhysicalSize; }
 
 		auto alignment() const -> size_t { return mAlignment; }
+
+		using GpuResource::layout;
+
+		/*
+		 * the layout of sub-texture, the layout() is the layout of whole texture
+		 * if the sub-textures have different layouts, the layout() is the last layout that all sub-textures had
+		 */
+		auto layout(const size_t mipSlice, const size_t arraySlice) const -> ResourceLayout { return mLayouts[index(mipSlice, arraySlice)]; }
+	protected:
+		friend class DirectX12GraphicsCommandList;
+		friend class VulkanGraphicsCommandList;
+
+		void setLayout(const ResourceLayout layout);
+
+		void setLayout(
+			const ValueRange<size_t>& mipLevel,
+			const ValueRange<size_t>& array,
+			const ResourceLayout layout);
 	protected:
 		size_t mPhysicalSize = 0;
 		size_t mAlignment = 0;
+
+		// the layouts of sub-textures, the index is same as index(mipSlice, arraySlice)
+		std::vector<ResourceLayout> mLayouts;
 	};
 
 }
\ No newline at end of file
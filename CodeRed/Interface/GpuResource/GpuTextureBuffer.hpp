@@ -51,6 +51,15 @@ namespace CodeRed {
 		virtual void write(const Extent3D<size_t>& extent, const void* data) = 0;
 		
 		virtual void write(const void* data) = 0;
+
+		/*
+		 * the persistently mapped memory of texture buffer, the rows of it are tightly packed
+		 * in Vulkan mode, the texture buffer is a buffer in upload heap, so we can write it directly and flush it
+		 * in DirectX12 mode, the texture buffer is a texture with unknown layout, so it is nullptr and we need use write
+		 */
+		auto mappedMemory() const noexcept -> void* { return mMappedMemory; }
+
+		virtual void flush() const = 0;
 	protected:
 		friend class DirectX12GraphicsCommandList;
 		friend class VulkanGraphicsCommandList;
@@ -63,6 +72,8 @@ namespace CodeRed {
 
 		size_t mPhysicalSize = 0;
 		size_t mAlignment = 0;
+
+		void* mMappedMemory = nullptr;
 	};
 	
 }
\ No newline at end of file
@@ -0,0 +1,114 @@
+#include "../Shared/Exception/FailedException.hpp"
+#include "../Shared/Exception/ZeroException.hpp"
+
+#include "GpuResource/GpuBuffer.hpp"
+#include "GpuLogicalDevice.hpp"
+#include "GpuUploadRing.hpp"
+
+static auto alignUp(const size_t value, const size_t alignment) -> size_t
+{
+	return alignment <= 1 ? value : (value + alignment - 1) / alignment * alignment;
+}
+
+CodeRed::GpuUploadRing::GpuUploadRing(
+	const std::shared_ptr<GpuLogicalDevice>& device,
+	const size_t frame_size,
+	const size_t frame_count) :
+	mDevice(device),
+	mFrameSize(alignUp(frame_size, mConstantAlignment)),
+	mFrameCount(frame_count)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mDevice == nullptr,
+		ZeroException<GpuLogicalDevice>({ "device" })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		mFrameSize == 0 || mFrameCount == 0,
+		ZeroException<size_t>({ "frame_size or frame_count" })
+	);
+
+	// the ring is used as vertex, index and constant buffer at the same time
+	// and the buffer in upload heap is mapped persistently
+	mBuffer = mDevice->createBuffer(
+		ResourceInfo(
+			BufferProperty(1, mFrameSize * mFrameCount),
+			ResourceLayout::GeneralRead,
+			ResourceUsage::VertexBuffer | ResourceUsage::IndexBuffer | ResourceUsage::ConstantBuffer,
+			ResourceType::Buffer,
+			MemoryHeap::Upload)
+	);
+
+	// the first beginFrame will use the region of frame 0
+	mFrameIndex = mFrameCount - 1;
+	mCurrentOffset = mFrameIndex * mFrameSize;
+}
+
+void CodeRed::GpuUploadRing::beginFrame()
+{
+	mFrameIndex = (mFrameIndex + 1) % mFrameCount;
+	mCurrentOffset = mFrameIndex * mFrameSize;
+}
+
+void CodeRed::GpuUploadRing::endFrame()
+{
+	// flush the range we wrote in this frame, it only works for non-coherent memory
+	mBuffer->flush(mFrameIndex * mFrameSize, usedSize());
+}
+
+auto CodeRed::GpuUploadRing::allocate(
+	const size_t size,
+	const size_t alignment)
+	-> GpuUploadRingSlice
+{
+	const auto offset = alignUp(mCurrentOffset, alignment);
+
+	CODE_RED_TRY_EXECUTE(
+		offset + size > (mFrameIndex + 1) * mFrameSize,
+		throw FailedException(DebugType::Create,
+			{ "GpuUploadRingSlice" },
+			{ "the region of current frame in upload ring is full." })
+	);
+
+	mCurrentOffset = offset + size;
+
+	GpuUploadRingSlice slice;
+
+	slice.Buffer = mBuffer;
+	slice.Offset = offset;
+	slice.Size = size;
+	slice.Stride = size;
+	slice.Memory = mBuffer->mappedRange(offset, size);
+
+	return slice;
+}
+
+auto CodeRed::GpuUploadRing::allocateConstant(const size_t size) -> GpuUploadRingSlice
+{
+	// the size of constant buffer view must be multiple of 256 bytes in DirectX12
+	return allocate(alignUp(size, mConstantAlignment), mConstantAlignment);
+}
+
+auto CodeRed::GpuUploadRing::allocateVertex(
+	const size_t stride,
+	const size_t count)
+	-> GpuUploadRingSlice
+{
+	auto slice = allocate(stride * count, mVertexAlignment);
+
+	slice.Stride = stride;
+
+	return slice;
+}
+
+auto CodeRed::GpuUploadRing::allocateIndex(
+	const size_t stride,
+	const size_t count)
+	-> GpuUploadRingSlice
+{
+	auto slice = allocate(stride * count, mVertexAlignment);
+
+	slice.Stride = stride;
+
+	return slice;
+}
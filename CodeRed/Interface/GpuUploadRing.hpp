@@ -0,0 +1,84 @@
+#pragma once
+
+#include "../Shared/Noncopyable.hpp"
+#include "../Shared/Utility.hpp"
+
+#include "GpuResource/GpuBufferView.hpp"
+
+#include <memory>
+
+namespace CodeRed {
+
+	class GpuLogicalDevice;
+
+	/*
+	 * a range of the upload ring, it is only valid in the frame that allocated it
+	 * Memory is the mapped memory of the range, we can write data to it directly
+	 */
+	struct GpuUploadRingSlice : GpuBufferView {
+		void* Memory = nullptr;
+
+		GpuUploadRingSlice() = default;
+	};
+
+	/*
+	 * GpuUploadRing is a large buffer in upload heap that is sliced into per-frame regions
+	 * we allocate the transient constants and geometry from the region of current frame with bump pointer.
+	 * the region of a frame is recycled when we begin the frame again,
+	 * so we need make sure the gpu has finished the frame before we call beginFrame.
+	 */
+	class GpuUploadRing final : public Noncopyable {
+	public:
+		explicit GpuUploadRing(
+			const std::shared_ptr<GpuLogicalDevice>& device,
+			const size_t frame_size,
+			const size_t frame_count = 2);
+
+		~GpuUploadRing() = default;
+
+		void beginFrame();
+
+		void endFrame();
+
+		auto allocate(
+			const size_t size,
+			const size_t alignment)
+			-> GpuUploadRingSlice;
+
+		auto allocateConstant(const size_t size) -> GpuUploadRingSlice;
+
+		auto allocateVertex(
+			const size_t stride,
+			const size_t count)
+			-> GpuUploadRingSlice;
+
+		auto allocateIndex(
+			const size_t stride,
+			const size_t count)
+			-> GpuUploadRingSlice;
+
+		auto buffer() const noexcept -> std::shared_ptr<GpuBuffer> { return mBuffer; }
+
+		auto frameSize() const noexcept -> size_t { return mFrameSize; }
+
+		auto frameCount() const noexcept -> size_t { return mFrameCount; }
+
+		auto frameIndex() const noexcept -> size_t { return mFrameIndex; }
+
+		auto usedSize() const noexcept -> size_t { return mCurrentOffset - mFrameIndex * mFrameSize; }
+	private:
+		// the alignment of constant buffer view in DirectX12 and the max alignment of uniform buffer in Vulkan
+		static constexpr size_t mConstantAlignment = 256;
+		static constexpr size_t mVertexAlignment = 16;
+
+		std::shared_ptr<GpuLogicalDevice> mDevice;
+		std::shared_ptr<GpuBuffer> mBuffer;
+
+		size_t mFrameSize = 0;
+		size_t mFrameCount = 0;
+		size_t mFrameIndex = 0;
+
+		size_t mCurrentOffset = 0;
+	};
+
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "../Utility.hpp"
+
+namespace CodeRed {
+
+	enum class BlitFilter : UInt32 {
+		Point,
+		Linear
+	};
+
+}
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "../Utility.hpp"
+
+namespace CodeRed {
+
+	enum class InputRate : UInt32 {
+		PerVertex,
+		PerInstance
+	};
+
+}
\ No newline at end of file
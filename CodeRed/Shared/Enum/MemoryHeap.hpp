@@ -7,7 +7,8 @@ namespace CodeRed {
 	enum class MemoryHeap : UInt32
 	{
 		Default,
-		Upload
+		Upload,
+		Readback
 	};
 	
 }
\ No newline at end of file
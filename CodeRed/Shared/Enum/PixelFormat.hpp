@@ -4,6 +4,11 @@
 
 namespace CodeRed {
 
+	/*
+	 * Unknown in the name of format means unsigned normalized integer(UNORM)
+	 * SignedUnknown means signed normalized integer(SNORM)
+	 * BlockCompressed formats are BC1-BC7, they are compressed in 4x4 blocks
+	 */
 	enum class PixelFormat : UInt32
 	{
 		Unknown,
@@ -14,7 +19,31 @@ namespace CodeRed {
 		RedGreen32BitFloat,
 		Depth32BitFloat,
 		Red8BitUnknown,
-		Red32BitFloat
+		Red32BitFloat,
+		Red16BitFloat,
+		RedGreen16BitFloat,
+		RedGreenBlueAlpha16BitFloat,
+		Red16BitUnknown,
+		RedGreen16BitUnknown,
+		RedGreenBlueAlpha16BitUnknown,
+		RedGreen16BitSignedUnknown,
+		RedGreenBlueAlpha16BitSignedUnknown,
+		RedGreen8BitUnknown,
+		RedGreenBlueAlpha8BitSignedUnknown,
+		RedGreenBlueAlpha8BitSRGB,
+		BlueGreenRedAlpha8BitSRGB,
+		RedGreenBlue10BitAlpha2BitUnknown,
+		RedGreen11BitBlue10BitFloat,
+		Depth16BitUnknown,
+		Depth24BitStencil8Bit,
+		BlockCompressed1Unknown,
+		BlockCompressed1SRGB,
+		BlockCompressed3Unknown,
+		BlockCompressed3SRGB,
+		BlockCompressed4Unknown,
+		BlockCompressed5Unknown,
+		BlockCompressed7Unknown,
+		BlockCompressed7SRGB
 	};
 	
 }
\ No newline at end of file
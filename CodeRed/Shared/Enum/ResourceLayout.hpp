@@ -7,6 +7,7 @@ namespace CodeRed {
 	enum class ResourceLayout : UInt32
 	{
 		GeneralRead,
+		GeneralReadWrite,
 		RenderTarget,
 		DepthStencil,
 		CopyDestination,
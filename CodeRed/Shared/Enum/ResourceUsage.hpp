@@ -11,7 +11,8 @@ namespace CodeRed {
 		IndexBuffer = 1 << 1,
 		ConstantBuffer = 1 << 2,
 		RenderTarget = 1 << 3,
-		DepthStencil = 1 << 4
+		DepthStencil = 1 << 4,
+		IndirectBuffer = 1 << 5
 	};
 
 	inline ResourceUsage operator | (const ResourceUsage& left, const ResourceUsage &right) {
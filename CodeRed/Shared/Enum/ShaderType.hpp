@@ -7,7 +7,8 @@ namespace CodeRed {
 	enum class ShaderType : UInt32
 	{
 		Vertex,
-		Pixel
+		Pixel,
+		Compute
 	};
 
 }
\ No newline at end of file
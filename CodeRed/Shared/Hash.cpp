@@ -0,0 +1,21 @@
+#include "Hash.hpp"
+
+auto CodeRed::Hash::bytes(const void* data, const size_t size, const UInt64 hash) -> UInt64
+{
+	const auto memory = static_cast<const Byte*>(data);
+
+	auto result = hash;
+
+	for (size_t index = 0; index < size; index++) {
+		result ^= memory[index];
+		result *= 1099511628211ull;
+	}
+
+	return result;
+}
+
+auto CodeRed::Hash::string(const std::string& value, const UInt64 hash) -> UInt64
+{
+	// hash the size too, so "ab" + "c" and "a" + "bc" are different
+	return bytes(value.data(), value.size(), Hash::value(value.size(), hash));
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Utility.hpp"
+
+#include <type_traits>
+#include <string>
+
+namespace CodeRed {
+
+	/*
+	 * Hash is the FNV-1a hash of bytes, the result is stable between runs,
+	 * so we can use it as the key of data that is saved to disk.
+	 */
+	class Hash {
+	public:
+		Hash() = delete;
+
+		static constexpr UInt64 Seed = 14695981039346656037ull;
+
+		static auto bytes(const void* data, const size_t size, const UInt64 hash = Seed) -> UInt64;
+
+		static auto string(const std::string& value, const UInt64 hash = Seed) -> UInt64;
+
+		template<typename T>
+		static auto value(const T& value, const UInt64 hash = Seed) -> UInt64
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "the value must be trivially copyable.");
+
+			return bytes(&value, sizeof(T), hash);
+		}
+	};
+	
+}
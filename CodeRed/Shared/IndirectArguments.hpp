@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Utility.hpp"
+
+namespace CodeRed {
+
+	/*
+	 * the arguments of drawIndirect in argument buffer
+	 * it has same layout as VkDrawIndirectCommand and D3D12_DRAW_ARGUMENTS
+	 */
+	struct DrawIndirectArguments {
+		UInt32 VertexCount = 0;
+		UInt32 InstanceCount = 1;
+		UInt32 StartVertexLocation = 0;
+		UInt32 StartInstanceLocation = 0;
+	};
+
+	/*
+	 * the arguments of drawIndexedIndirect in argument buffer
+	 * it has same layout as VkDrawIndexedIndirectCommand and D3D12_DRAW_INDEXED_ARGUMENTS
+	 */
+	struct DrawIndexedIndirectArguments {
+		UInt32 IndexCount = 0;
+		UInt32 InstanceCount = 1;
+		UInt32 StartIndexLocation = 0;
+		Int32 BaseVertexLocation = 0;
+		UInt32 StartInstanceLocation = 0;
+	};
+	
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CodeRed {
+
+	/*
+	 * a region we copy from source buffer to destination buffer
+	 * [SourceOffset, SourceOffset + Size) -> [DestinationOffset, DestinationOffset + Size)
+	 */
+	struct BufferCopyRegion {
+		size_t SourceOffset = 0;
+		size_t DestinationOffset = 0;
+		size_t Size = 0;
+
+		BufferCopyRegion() = default;
+
+		BufferCopyRegion(
+			const size_t size,
+			const size_t sourceOffset = 0,
+			const size_t destinationOffset = 0) :
+			SourceOffset(sourceOffset), DestinationOffset(destinationOffset), Size(size) {}
+	};
+	
+}
@@ -60,7 +60,7 @@ namespace CodeRed {
 			Width(width),
 			Height(height),
 			Depth(depth),
-			Size(width * height * (dimension == Dimension::Dimension3D ? depth : 1) * PixelFormatSizeOf::get(format) * MultiSampleSizeOf::get(sample)),
+			Size(PixelFormatSizeOf::size(format, width, height, dimension == Dimension::Dimension3D ? depth : 1) * MultiSampleSizeOf::get(sample)),
 			MipLevels(mipLevels),
 			Format(format),
 			Sample(sample),
@@ -136,6 +136,23 @@ namespace CodeRed {
 			);
 		}
 
+		/*
+		 * the buffer in readback heap is only used as the destination of copy
+		 * so it is created with ResourceLayout::CopyDestination and should not be translated
+		 */
+		static auto ReadbackBuffer(
+			const size_t stride,
+			const size_t count) -> ResourceInfo
+		{
+			return ResourceInfo(
+				BufferProperty(stride, count),
+				ResourceLayout::CopyDestination,
+				ResourceUsage::None,
+				ResourceType::Buffer,
+				MemoryHeap::Readback
+			);
+		}
+
 		static auto GroupBuffer(
 			const size_t stride,
 			const size_t count,
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "../Extent.hpp"
+
+#include <memory>
+
+namespace CodeRed {
+
+	class GpuTexture;
+
+	/*
+	 * a region of sub-texture(MipSlice, ArraySlice) we blit from or to
+	 * the region is [Left, Right) * [Top, Bottom) * [Front, Back) in the mip level
+	 */
+	struct TextureBlitInfo {
+		std::shared_ptr<GpuTexture> Texture = nullptr;
+		size_t MipSlice = 0;
+		size_t ArraySlice = 0;
+		Extent3D<size_t> Region;
+
+		TextureBlitInfo() = default;
+
+		TextureBlitInfo(
+			const std::shared_ptr<GpuTexture>& texture,
+			const Extent3D<size_t>& region) :
+			TextureBlitInfo(texture, 0, 0, region) {}
+
+		TextureBlitInfo(
+			const std::shared_ptr<GpuTexture>& texture,
+			const size_t mipSlice,
+			const size_t arraySlice,
+			const Extent3D<size_t>& region) :
+			Texture(texture), MipSlice(mipSlice), ArraySlice(arraySlice), Region(region) {}
+	};
+	
+}
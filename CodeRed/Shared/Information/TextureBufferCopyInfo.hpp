@@ -5,14 +5,28 @@
 namespace CodeRed {
 
 	class GpuTextureBuffer;
-	
+
+	/*
+	 * the Location is the start position in texture buffer we copy from or to
+	 * so we can pack many images into one texture buffer and copy them with different locations
+	 */
 	struct TextureBufferCopyInfo {
 		std::shared_ptr<GpuTextureBuffer> Buffer = nullptr;
+		size_t LocationX = 0;
+		size_t LocationY = 0;
+		size_t LocationZ = 0;
 
 		TextureBufferCopyInfo() = default;
 
 		TextureBufferCopyInfo(const std::shared_ptr<GpuTextureBuffer>& buffer) :
-			Buffer(buffer) {}
+			TextureBufferCopyInfo(buffer, 0, 0, 0) {}
+
+		TextureBufferCopyInfo(
+			const std::shared_ptr<GpuTextureBuffer>& buffer,
+			const size_t locationX,
+			const size_t locationY,
+			const size_t locationZ) :
+			Buffer(buffer), LocationX(locationX), LocationY(locationY), LocationZ(locationZ) {}
 	};
 	
 }
\ No newline at end of file
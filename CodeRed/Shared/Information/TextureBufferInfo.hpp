@@ -27,7 +27,7 @@ namespace CodeRed {
 			const size_t depth,
 			const PixelFormat format,
 			const CodeRed::Dimension dimension) :
-			Width(width), Height(height), Depth(depth), Size(PixelFormatSizeOf::get(format) * width * height * depth),
+			Width(width), Height(height), Depth(depth), Size(PixelFormatSizeOf::size(format, width, height, depth)),
 			Format(format), Dimension(dimension) {}
 
 		static auto Texture1D(const size_t width, const PixelFormat format) -> TextureBufferInfo
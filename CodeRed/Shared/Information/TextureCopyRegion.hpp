@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+namespace CodeRed {
+
+	/*
+	 * a region we copy between textures or texture buffers
+	 * the Index is the sub-texture(resource index) of texture, it should be 0 for texture buffer
+	 * the Location is the start position we copy from or to
+	 * the Width, Height and Depth are the size of region in pixels
+	 */
+	struct TextureCopyRegion {
+		size_t SourceIndex = 0;
+		size_t SourceX = 0;
+		size_t SourceY = 0;
+		size_t SourceZ = 0;
+
+		size_t DestinationIndex = 0;
+		size_t DestinationX = 0;
+		size_t DestinationY = 0;
+		size_t DestinationZ = 0;
+
+		size_t Width = 0;
+		size_t Height = 0;
+		size_t Depth = 1;
+
+		TextureCopyRegion() = default;
+
+		TextureCopyRegion(
+			const size_t sourceIndex,
+			const size_t sourceX,
+			const size_t sourceY,
+			const size_t sourceZ,
+			const size_t destinationIndex,
+			const size_t destinationX,
+			const size_t destinationY,
+			const size_t destinationZ,
+			const size_t width,
+			const size_t height,
+			const size_t depth = 1) :
+			SourceIndex(sourceIndex), SourceX(sourceX), SourceY(sourceY), SourceZ(sourceZ),
+			DestinationIndex(destinationIndex), DestinationX(destinationX), DestinationY(destinationY), DestinationZ(destinationZ),
+			Width(width), Height(height), Depth(depth) {}
+	};
+	
+}
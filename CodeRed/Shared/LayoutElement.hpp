@@ -2,6 +2,7 @@
 
 #include "Enum/ShaderVisibility.hpp"
 #include "Enum/ResourceType.hpp"
+#include "Enum/InputRate.hpp"
 #include "Enum/PixelFormat.hpp"
 #include "Utility.hpp"
 
@@ -13,20 +14,28 @@ namespace CodeRed {
 
 	class GpuSampler;
 	
+	/*
+	 * if ReadWrite is true, the group buffer can be written by shader(RWStructuredBuffer in HLSL)
+	 * in DirectX12, it is bound as unordered access view(register u) instead of shader resource view(register t)
+	 * in Vulkan, the storage buffer is always read-write
+	 */
 	struct ResourceLayoutElement {
 		ShaderVisibility Visibility = ShaderVisibility::All;
 		ResourceType Type = ResourceType::Buffer;
 		size_t Binding = 0;
 		size_t Space = 0;
 
+		bool ReadWrite = false;
+		
 		ResourceLayoutElement() = default;
 
 		explicit ResourceLayoutElement(
 			const ResourceType type,
 			const UInt32 binding = 0,
 			const UInt32 space = 0,
-			const ShaderVisibility visibility = ShaderVisibility::All
-		) : Visibility(visibility), Type(type), Binding(binding), Space(space) {}
+			const ShaderVisibility visibility = ShaderVisibility::All,
+			const bool read_write = false
+		) : Visibility(visibility), Type(type), Binding(binding), Space(space), ReadWrite(read_write) {}
 	};
 
 	struct SamplerLayoutElement {
@@ -46,17 +55,35 @@ namespace CodeRed {
 		) : Visibility(visibility), Binding(binding), Space(space), Sampler(sampler) {}
 	};
 
+	/*
+	 * Rate and StepRate are the properties of slot, the elements in same slot should have same values.
+	 * if Rate is PerInstance, the element advances once every StepRate instances.
+	 * Offset is the offset of element in vertex, if it is AppendOffset, it follows the previous element in same slot.
+	 * Stride is the stride of slot, if it is 0, it is the end of the last element in same slot.
+	 */
 	struct InputLayoutElement {
+		static constexpr size_t AppendOffset = SIZE_MAX;
+		
 		PixelFormat Format = PixelFormat::Unknown;
 		std::string Name = "";
 		size_t Slot = 0;
 
+		InputRate Rate = InputRate::PerVertex;
+		size_t StepRate = 1;
+
+		size_t Offset = AppendOffset;
+		size_t Stride = 0;
+		
 		InputLayoutElement() = default;
 		
 		explicit InputLayoutElement(
 			const std::string &name,
 			const PixelFormat format,
-			const size_t slot = 0
-		) : Format(format), Name(name), Slot(slot) {}
+			const size_t slot = 0,
+			const InputRate rate = InputRate::PerVertex,
+			const size_t step_rate = 1,
+			const size_t offset = AppendOffset,
+			const size_t stride = 0
+		) : Format(format), Name(name), Slot(slot), Rate(rate), StepRate(step_rate), Offset(offset), Stride(stride) {}
 	};
 }
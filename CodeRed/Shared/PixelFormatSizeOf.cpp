@@ -19,6 +19,55 @@ auto CodeRed::PixelFormatSizeOf::get(const PixelFormat pixel_format) -> size_t {
 		return 1;
 	case PixelFormat::Red32BitFloat:
 		return 4;
+	case PixelFormat::Red16BitFloat:
+		return 2;
+	case PixelFormat::RedGreen16BitFloat:
+		return 4;
+	case PixelFormat::RedGreenBlueAlpha16BitFloat:
+		return 8;
+	case PixelFormat::Red16BitUnknown:
+		return 2;
+	case PixelFormat::RedGreen16BitUnknown:
+		return 4;
+	case PixelFormat::RedGreenBlueAlpha16BitUnknown:
+		return 8;
+	case PixelFormat::RedGreen16BitSignedUnknown:
+		return 4;
+	case PixelFormat::RedGreenBlueAlpha16BitSignedUnknown:
+		return 8;
+	case PixelFormat::RedGreen8BitUnknown:
+		return 2;
+	case PixelFormat::RedGreenBlueAlpha8BitSignedUnknown:
+		return 4;
+	case PixelFormat::RedGreenBlueAlpha8BitSRGB:
+		return 4;
+	case PixelFormat::BlueGreenRedAlpha8BitSRGB:
+		return 4;
+	case PixelFormat::RedGreenBlue10BitAlpha2BitUnknown:
+		return 4;
+	case PixelFormat::RedGreen11BitBlue10BitFloat:
+		return 4;
+	case PixelFormat::Depth16BitUnknown:
+		return 2;
+	case PixelFormat::Depth24BitStencil8Bit:
+		//the texture buffer only holds the depth aspect(24bit depth in 32bit), the stencil is not copied
+		return 4;
+	case PixelFormat::BlockCompressed1Unknown:
+		return 8;
+	case PixelFormat::BlockCompressed1SRGB:
+		return 8;
+	case PixelFormat::BlockCompressed3Unknown:
+		return 16;
+	case PixelFormat::BlockCompressed3SRGB:
+		return 16;
+	case PixelFormat::BlockCompressed4Unknown:
+		return 8;
+	case PixelFormat::BlockCompressed5Unknown:
+		return 16;
+	case PixelFormat::BlockCompressed7Unknown:
+		return 16;
+	case PixelFormat::BlockCompressed7SRGB:
+		return 16;
 	case PixelFormat::Unknown:
 		throw NotSupportException(NotSupportType::Enum);
 	default:
@@ -30,6 +79,58 @@ bool CodeRed::PixelFormatSizeOf::isDepthOnly(const PixelFormat pixelFormat)
 {
 	switch (pixelFormat) {
 	case PixelFormat::Depth32BitFloat: return true;
+	case PixelFormat::Depth16BitUnknown: return true;
+	default: return false;
+	}
+}
+
+bool CodeRed::PixelFormatSizeOf::isCompressed(const PixelFormat pixel_format)
+{
+	switch (pixel_format) {
+	case PixelFormat::BlockCompressed1Unknown:
+	case PixelFormat::BlockCompressed1SRGB:
+	case PixelFormat::BlockCompressed3Unknown:
+	case PixelFormat::BlockCompressed3SRGB:
+	case PixelFormat::BlockCompressed4Unknown:
+	case PixelFormat::BlockCompressed5Unknown:
+	case PixelFormat::BlockCompressed7Unknown:
+	case PixelFormat::BlockCompressed7SRGB:
+		return true;
 	default: return false;
 	}
 }
+
+auto CodeRed::PixelFormatSizeOf::blockSize(const PixelFormat pixel_format) -> size_t
+{
+	return isCompressed(pixel_format) ? 4 : 1;
+}
+
+auto CodeRed::PixelFormatSizeOf::rowPitch(const PixelFormat pixel_format, const size_t width) -> size_t
+{
+	const auto block = blockSize(pixel_format);
+	
+	return (width + block - 1) / block * get(pixel_format);
+}
+
+auto CodeRed::PixelFormatSizeOf::rowCount(const PixelFormat pixel_format, const size_t height) -> size_t
+{
+	const auto block = blockSize(pixel_format);
+	
+	return (height + block - 1) / block;
+}
+
+auto CodeRed::PixelFormatSizeOf::blockAlign(const PixelFormat pixel_format, const size_t value) -> size_t
+{
+	const auto block = blockSize(pixel_format);
+
+	return (value + block - 1) / block * block;
+}
+
+auto CodeRed::PixelFormatSizeOf::size(
+	const PixelFormat pixel_format, 
+	const size_t width,
+	const size_t height,
+	const size_t depth) -> size_t
+{
+	return rowPitch(pixel_format, width) * rowCount(pixel_format, height) * depth;
+}
@@ -8,9 +8,32 @@ namespace CodeRed {
 	public:
 		PixelFormatSizeOf() = delete;
 		
+		/*
+		 * get the size of pixel, if the format is compressed, it is the size of 4x4 block
+		 */
 		static auto get(const PixelFormat pixel_format) -> size_t;
 
 		static bool isDepthOnly(const PixelFormat pixelFormat);
+
+		static bool isCompressed(const PixelFormat pixel_format);
+
+		// the width and height of block, it is 1 if the format is not compressed
+		static auto blockSize(const PixelFormat pixel_format) -> size_t;
+
+		// the size of a row of pixels(or a row of blocks)
+		static auto rowPitch(const PixelFormat pixel_format, const size_t width) -> size_t;
+
+		// the number of rows of pixels(or rows of blocks)
+		static auto rowCount(const PixelFormat pixel_format, const size_t height) -> size_t;
+
+		// align the width or height to the multiple of block size
+		static auto blockAlign(const PixelFormat pixel_format, const size_t value) -> size_t;
+
+		static auto size(
+			const PixelFormat pixel_format,
+			const size_t width,
+			const size_t height,
+			const size_t depth = 1) -> size_t;
 	};
 	
 }
\ No newline at end of file
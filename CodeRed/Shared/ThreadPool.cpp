@@ -0,0 +1,71 @@
+#include "Exception/ZeroException.hpp"
+#include "ThreadPool.hpp"
+
+CodeRed::ThreadPool::ThreadPool(const size_t thread_count)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		thread_count == 0,
+		ZeroException<size_t>({ "thread_count" })
+	);
+
+	for (size_t index = 0; index < thread_count; index++)
+		mThreads.push_back(std::thread([this]() { work(); }));
+}
+
+CodeRed::ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mStop = true;
+	}
+
+	mCondition.notify_all();
+
+	for (auto& thread : mThreads) thread.join();
+}
+
+void CodeRed::ThreadPool::push(const std::function<void()>& task)
+{
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mTasks.push_back(task);
+	}
+
+	mCondition.notify_one();
+}
+
+auto CodeRed::ThreadPool::pending() -> size_t
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	return mTasks.size() + mRunningCount;
+}
+
+void CodeRed::ThreadPool::work()
+{
+	while (true) {
+		std::function<void()> task;
+
+		{
+			std::unique_lock<std::mutex> lock(mMutex);
+
+			mCondition.wait(lock, [this]() { return mStop || !mTasks.empty(); });
+
+			// we only exit when the queue is empty, so the tasks pushed before stop are finished
+			if (mTasks.empty()) return;
+
+			task = std::move(mTasks.front());
+
+			mTasks.pop_front();
+			mRunningCount++;
+		}
+
+		task();
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		mRunningCount--;
+	}
+}
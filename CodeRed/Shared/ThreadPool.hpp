@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Noncopyable.hpp"
+
+#include <condition_variable>
+#include <functional>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <deque>
+
+namespace CodeRed {
+
+	/*
+	 * ThreadPool runs the tasks on a fixed number of worker threads.
+	 * when we destroy the pool, we will finish all tasks in the queue before we join the threads.
+	 */
+	class ThreadPool final : public Noncopyable {
+	public:
+		explicit ThreadPool(const size_t thread_count);
+
+		~ThreadPool();
+
+		// the task should not throw exceptions, we can use std::packaged_task to keep them
+		void push(const std::function<void()>& task);
+
+		// the number of tasks in the queue and the tasks are running
+		auto pending() -> size_t;
+
+		auto threadCount() const noexcept -> size_t { return mThreads.size(); }
+	private:
+		void work();
+	private:
+		std::vector<std::thread> mThreads;
+		std::deque<std::function<void()>> mTasks;
+
+		std::condition_variable mCondition;
+		std::mutex mMutex;
+
+		size_t mRunningCount = 0;
+
+		bool mStop = false;
+	};
+	
+}
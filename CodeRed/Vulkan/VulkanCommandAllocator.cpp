@@ -33,6 +33,6 @@ CodeRed::VulkanCommandAllocator::~VulkanCommandAllocator()
 void CodeRed::VulkanCommandAllocator::reset()
 {
 	std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device()
-		.resetCommandPool(mCommandPool, vk::CommandPoolResetFlagBits::eReleaseResources);
+		.resetCommandPool(mCommandPool, vk::CommandPoolResetFlags(0));
 }
 #endif
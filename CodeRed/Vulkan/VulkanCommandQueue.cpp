@@ -1,6 +1,7 @@
 #include "VulkanGraphicsCommandList.hpp"
 #include "VulkanLogicalDevice.hpp"
 #include "VulkanCommandQueue.hpp"
+#include "VulkanFence.hpp"
 
 #include "../Shared/DebugReport.hpp"
 
@@ -54,11 +55,75 @@ void CodeRed::VulkanCommandQueue::execute(
 		.setCommandBufferCount(static_cast<uint32_t>(vkLists.size()))
 		.setPCommandBuffers(vkLists.data());
 
-	mQueue.submit(info, nullptr);
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		// the submission fence is signaled with the lists, so we do not need other submit
+		std::static_pointer_cast<VulkanFence>(mSubmissionFence)->submit(mQueue, info, mSubmissionValue + 1);
+
+		mSubmissionValue++;
+	}
+
+	mDevice->releaseDeferredObjects();
+}
+
+void CodeRed::VulkanCommandQueue::execute(
+	const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists,
+	const std::shared_ptr<GpuFence>& fence,
+	const size_t value)
+{
+	CODE_RED_DEBUG_WARNING_IF(
+		lists.empty(),
+		"the lists we commit to queue is empty."
+	);
+
+	std::vector<vk::CommandBuffer> vkLists;
+
+	for (auto& list : lists) {
+		vkLists.push_back(
+			std::static_pointer_cast<VulkanGraphicsCommandList>(list)->commandList()
+		);
+	}
+
+	vk::SubmitInfo info = {};
+
+	info
+		.setPNext(nullptr)
+		.setWaitSemaphoreCount(0)
+		.setSignalSemaphoreCount(0)
+		.setPWaitSemaphores(nullptr)
+		.setPSignalSemaphores(nullptr)
+		.setPWaitDstStageMask(nullptr)
+		.setCommandBufferCount(static_cast<uint32_t>(vkLists.size()))
+		.setPCommandBuffers(vkLists.data());
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		// the fence will submit the lists with the semaphore or fence it signals
+		std::static_pointer_cast<VulkanFence>(fence)->submit(mQueue, info, value);
+
+		vk::SubmitInfo signalInfo = {};
+
+		signalInfo
+			.setPNext(nullptr)
+			.setWaitSemaphoreCount(0)
+			.setSignalSemaphoreCount(0)
+			.setCommandBufferCount(0);
+
+		// the submission fence is signaled after the lists, it is used by deferred destruction
+		std::static_pointer_cast<VulkanFence>(mSubmissionFence)->submit(mQueue, signalInfo, mSubmissionValue + 1);
+
+		mSubmissionValue++;
+	}
+
+	mDevice->releaseDeferredObjects();
 }
 
 void CodeRed::VulkanCommandQueue::waitIdle()
 {
+	std::lock_guard<std::mutex> lock(mMutex);
+	
 	mQueue.waitIdle();
 }
 
@@ -5,6 +5,8 @@
 
 #ifdef __ENABLE__VULKAN__
 
+#include <mutex>
+
 namespace CodeRed {
 
 	class VulkanCommandQueue final : public GpuCommandQueue {
@@ -16,12 +18,23 @@ namespace CodeRed {
 
 		void execute(const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists) override;
 
+		void execute(
+			const std::vector<std::shared_ptr<GpuGraphicsCommandList>>& lists,
+			const std::shared_ptr<GpuFence>& fence,
+			const size_t value) override;
+
 		void waitIdle() override;
 		
 		auto queue() const noexcept -> vk::Queue { return mQueue; }
+	private:
+		friend class VulkanSwapChain;
+		friend class VulkanFence;
 	private:
 		vk::Queue mQueue;
 
+		// vk::Queue is externally synchronized, the threads submit to the queue with this lock
+		std::mutex mMutex;
+
 		size_t mQueueIndex = SIZE_MAX;
 	};
 	
@@ -0,0 +1,45 @@
+#include "VulkanComputePipeline.hpp"
+#include "VulkanResourceLayout.hpp"
+#include "VulkanLogicalDevice.hpp"
+
+#include "VulkanPipelineState/VulkanShaderState.hpp"
+
+#ifdef __ENABLE__VULKAN__
+
+using namespace CodeRed::Vulkan;
+
+CodeRed::VulkanComputePipeline::VulkanComputePipeline(
+	const std::shared_ptr<GpuLogicalDevice>& device,
+	const std::shared_ptr<GpuResourceLayout>& resource_layout,
+	const std::shared_ptr<GpuShaderState>& compute_shader_state) :
+	GpuComputePipeline(
+		device,
+		resource_layout,
+		compute_shader_state
+	)
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+	vk::ComputePipelineCreateInfo info = {};
+
+	info
+		.setPNext(nullptr)
+		.setFlags(vk::PipelineCreateFlags(0))
+		.setStage(std::static_pointer_cast<VulkanShaderState>(mComputeShaderState)->stage())
+		.setLayout(std::static_pointer_cast<VulkanResourceLayout>(mResourceLayout)->layout())
+		.setBasePipelineHandle(nullptr)
+		.setBasePipelineIndex(0);
+
+	std::shared_lock<std::shared_mutex> lock(vkDevice->mPipelineCacheMutex);
+	
+	mComputePipeline = vkDevice->device().createComputePipeline(vkDevice->pipelineCache(), info);
+}
+
+CodeRed::VulkanComputePipeline::~VulkanComputePipeline()
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
+
+	mDevice->deferDestruction([vkDevice, pipeline = mComputePipeline]() { vkDevice.destroyPipeline(pipeline); });
+}
+
+#endif
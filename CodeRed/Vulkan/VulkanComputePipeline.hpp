@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../Interface/GpuComputePipeline.hpp"
+#include "VulkanUtility.hpp"
+
+#ifdef __ENABLE__VULKAN__
+
+namespace CodeRed {
+
+	class VulkanComputePipeline final : public GpuComputePipeline {
+	public:
+		explicit VulkanComputePipeline(
+			const std::shared_ptr<GpuLogicalDevice>& device,
+			const std::shared_ptr<GpuResourceLayout>& resource_layout,
+			const std::shared_ptr<GpuShaderState>& compute_shader_state);
+
+		~VulkanComputePipeline();
+
+		auto pipeline() const noexcept -> vk::Pipeline { return mComputePipeline; }
+	private:
+		vk::Pipeline mComputePipeline;
+	};
+	
+}
+
+#endif
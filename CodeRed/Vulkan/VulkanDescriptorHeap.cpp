@@ -80,12 +80,16 @@ CodeRed::VulkanDescriptorHeap::~VulkanDescriptorHeap()
 {
 	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
 
-	vkDevice.freeDescriptorSets(mDescriptorPool, mDescriptorSets);
+	// the descriptor sets may be bound by the submissions in flight
+	mDevice->deferDestruction([vkDevice, pool = mDescriptorPool, sets = mDescriptorSets, imageViews = mImageView]()
+		{
+			vkDevice.freeDescriptorSets(pool, sets);
 
-	for (auto& imageView : mImageView)
-		if (imageView) vkDevice.destroyImageView(imageView);
-	
-	vkDevice.destroyDescriptorPool(mDescriptorPool);
+			for (auto& imageView : imageViews)
+				if (imageView) vkDevice.destroyImageView(imageView);
+
+			vkDevice.destroyDescriptorPool(pool);
+		});
 }
 
 void CodeRed::VulkanDescriptorHeap::bindTexture(
@@ -136,7 +140,7 @@ void CodeRed::VulkanDescriptorHeap::bindTexture(
 }
 
 void CodeRed::VulkanDescriptorHeap::bindBuffer(
-	const std::shared_ptr<GpuBuffer>& buffer,
+	const GpuBufferView& view,
 	const size_t index)
 {
 	CODE_RED_DEBUG_THROW_IF(
@@ -145,23 +149,28 @@ void CodeRed::VulkanDescriptorHeap::bindBuffer(
 	);
 
 	CODE_RED_DEBUG_THROW_IF(
-		mResourceLayout->mElements[index].Type != buffer->type() || 
+		mResourceLayout->mElements[index].Type != view.Buffer->type() || 
 		mResourceLayout->mElements[index].Type == ResourceType::Texture,
 		InvalidException<ResourceType>({ "element(index).Type" })
 	);
 
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset + view.Size > view.Buffer->size(),
+		InvalidException<GpuBufferView>({ "view" }, { "the range of view is out of the buffer." })
+	);
+
 	vk::DescriptorBufferInfo bufferInfo = {};
 	vk::WriteDescriptorSet write = {};
 
 	bufferInfo
-		.setOffset(0)
-		.setRange(buffer->size())
-		.setBuffer(std::static_pointer_cast<VulkanBuffer>(buffer)->buffer());
+		.setOffset(view.Offset)
+		.setRange(view.Size)
+		.setBuffer(std::static_pointer_cast<VulkanBuffer>(view.Buffer)->buffer());
 
 	write
 		.setPNext(nullptr)
 		.setDescriptorCount(1)
-		.setDescriptorType(enumConvert(buffer->type()))
+		.setDescriptorType(enumConvert(view.Buffer->type()))
 		.setDstArrayElement(0)
 		.setDstBinding(static_cast<uint32_t>(mResourceLayout->mElements[index].Binding))
 		.setDstSet(mDescriptorSets[mResourceLayout->mElements[index].Space])
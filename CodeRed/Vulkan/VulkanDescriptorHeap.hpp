@@ -23,8 +23,8 @@ namespace CodeRed {
 			const std::shared_ptr<GpuTexture>& texture,
 			const size_t index) override;
 
-		void bindBuffer( 
-			const std::shared_ptr<GpuBuffer>& buffer,
+		void bindBuffer(
+			const GpuBufferView& view,
 			const size_t index) override;
 
 		auto descriptorSets() const noexcept -> std::vector<vk::DescriptorSet> { return mDescriptorSets; }
@@ -8,8 +8,9 @@ CodeRed::VulkanDisplayAdapter::VulkanDisplayAdapter(
 	const vk::PhysicalDevice& device,
 	const std::string& name,
 	const size_t device_id,
-	const size_t vendor_id) :
-	GpuDisplayAdapter(name, device_id, vendor_id), mPhysicalDevice(device)
+	const size_t vendor_id,
+	const size_t driver_version) :
+	GpuDisplayAdapter(name, device_id, vendor_id, driver_version), mPhysicalDevice(device)
 {
 
 }
@@ -13,7 +13,8 @@ namespace CodeRed {
 			const vk::PhysicalDevice& device,
 			const std::string& name,
 			const size_t device_id,
-			const size_t vendor_id);
+			const size_t vendor_id,
+			const size_t driver_version);
 
 		~VulkanDisplayAdapter() = default;
 
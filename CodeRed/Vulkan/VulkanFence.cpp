@@ -1,28 +1,236 @@
+#include "../Shared/Exception/InvalidException.hpp"
+#include "../Shared/Exception/FailedException.hpp"
+
 #include "VulkanLogicalDevice.hpp"
+#include "VulkanCommandQueue.hpp"
 #include "VulkanFence.hpp"
 
 #ifdef __ENABLE__VULKAN__
 
 using namespace CodeRed::Vulkan;
 
+static auto timeoutOf(const size_t timeout) -> uint64_t
+{
+	// the timeout of vulkan is in nanoseconds
+	return timeout >= UINT64_MAX / 1000000 ? UINT64_MAX : static_cast<uint64_t>(timeout) * 1000000;
+}
+
 CodeRed::VulkanFence::VulkanFence(const std::shared_ptr<GpuLogicalDevice>& device) :
 	GpuFence(device)
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+#ifdef VK_KHR_timeline_semaphore
+	if (vkDevice->mTimelineSemaphore == true) {
+		vk::SemaphoreTypeCreateInfoKHR typeInfo = {};
+		vk::SemaphoreCreateInfo info = {};
+
+		typeInfo
+			.setPNext(nullptr)
+			.setSemaphoreType(vk::SemaphoreTypeKHR::eTimeline)
+			.setInitialValue(0);
+
+		info
+			.setPNext(&typeInfo)
+			.setFlags(vk::SemaphoreCreateFlags(0));
+
+		mSemaphore = vkDevice->device().createSemaphore(info);
+	}
+#endif
+}
+
+CodeRed::VulkanFence::~VulkanFence()
 {
 	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
-	
-	vk::FenceCreateInfo info = {};
+
+	// the fences can not be destroyed when the queue is using them
+	for (const auto& pending : mPendingFences) {
+		vkDevice.waitForFences(pending.second, true, UINT64_MAX);
+		vkDevice.destroyFence(pending.second);
+	}
+
+	for (const auto& fence : mFreeFences) vkDevice.destroyFence(fence);
+
+	if (mSemaphore) vkDevice.destroySemaphore(mSemaphore);
+}
+
+void CodeRed::VulkanFence::signal(
+	const std::shared_ptr<GpuCommandQueue>& queue,
+	const size_t value)
+{
+	vk::SubmitInfo info = {};
 
 	info
 		.setPNext(nullptr)
-		.setFlags(vk::FenceCreateFlags(0));
+		.setWaitSemaphoreCount(0)
+		.setSignalSemaphoreCount(0)
+		.setCommandBufferCount(0);
 
-	mFence = vkDevice.createFence(info);
+	const auto vkQueue = std::static_pointer_cast<VulkanCommandQueue>(queue);
+
+	std::lock_guard<std::mutex> lock(vkQueue->mMutex);
+	
+	submit(vkQueue->queue(), info, value);
 }
 
-CodeRed::VulkanFence::~VulkanFence()
+auto CodeRed::VulkanFence::wait(
+	const size_t value, 
+	const size_t timeout)
+	-> bool
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+#ifdef VK_KHR_timeline_semaphore
+	if (mSemaphore) {
+		const auto waitValue = static_cast<uint64_t>(value);
+		
+		vk::SemaphoreWaitInfoKHR info = {};
+
+		info
+			.setPNext(nullptr)
+			.setFlags(vk::SemaphoreWaitFlagsKHR(0))
+			.setSemaphoreCount(1)
+			.setPSemaphores(&mSemaphore)
+			.setPValues(&waitValue);
+
+		return vkDevice->device().waitSemaphoresKHR(
+			info, timeoutOf(timeout), vkDevice->mDynamicLoader) == vk::Result::eSuccess;
+	}
+#endif
+
+	vk::Fence fence = nullptr;
+
+	{
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		updateCompletedValue();
+
+		if (mCompletedValue >= value) return true;
+
+		// find the first fence that signals a value greater than or equal to value
+		for (const auto& pending : mPendingFences) {
+			if (pending.first >= value) { fence = pending.second; break; }
+		}
+	}
+
+	CODE_RED_DEBUG_THROW_IF(
+		!fence,
+		InvalidException<size_t>({ "value" }, { "the value is never signaled, we will wait forever." })
+	);
+
+	if (!fence) return false;
+	
+	const auto result = vkDevice->device().waitForFences(fence, true, timeoutOf(timeout));
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	updateCompletedValue();
+
+	return result == vk::Result::eSuccess;
+}
+
+auto CodeRed::VulkanFence::completedValue() -> size_t
 {
-	std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device()
-		.destroyFence(mFence);
+#ifdef VK_KHR_timeline_semaphore
+	if (mSemaphore) {
+		const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+		return static_cast<size_t>(vkDevice->device().getSemaphoreCounterValueKHR(
+			mSemaphore, vkDevice->mDynamicLoader));
+	}
+#endif
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	updateCompletedValue();
+
+	return mCompletedValue;
+}
+
+void CodeRed::VulkanFence::submit(
+	const vk::Queue& queue,
+	const vk::SubmitInfo& info,
+	const size_t value)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	CODE_RED_DEBUG_THROW_IF(
+		value <= mSignaledValue,
+		InvalidException<size_t>({ "value" }, { "the value should be greater than the value signaled before." })
+	);
+
+	mSignaledValue = value;
+
+#ifdef VK_KHR_timeline_semaphore
+	if (mSemaphore) {
+		const auto signalValue = static_cast<uint64_t>(value);
+
+		vk::TimelineSemaphoreSubmitInfoKHR timelineInfo = {};
+
+		timelineInfo
+			.setPNext(info.pNext)
+			.setWaitSemaphoreValueCount(0)
+			.setSignalSemaphoreValueCount(1)
+			.setPSignalSemaphoreValues(&signalValue);
+
+		auto submitInfo = info;
+
+		submitInfo
+			.setPNext(&timelineInfo)
+			.setSignalSemaphoreCount(1)
+			.setPSignalSemaphores(&mSemaphore);
+
+		queue.submit(submitInfo, nullptr);
+
+		return;
+	}
+#endif
+
+	// reclaim the finished fences, so the fences are reused even if no one waits for the values
+	updateCompletedValue();
+	
+	const auto fence = allocateFence();
+
+	queue.submit(info, fence);
+
+	mPendingFences.push_back({ value, fence });
+}
+
+void CodeRed::VulkanFence::updateCompletedValue()
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
+
+	// the queue finishes the submissions in order, so we only need to check the front
+	while (!mPendingFences.empty() && 
+		vkDevice.getFenceStatus(mPendingFences.front().second) == vk::Result::eSuccess) {
+
+		mCompletedValue = mPendingFences.front().first;
+		mFreeFences.push_back(mPendingFences.front().second);
+		mPendingFences.pop_front();
+	}
+}
+
+auto CodeRed::VulkanFence::allocateFence() -> vk::Fence
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
+	
+	if (!mFreeFences.empty()) {
+		const auto fence = mFreeFences.back();
+
+		mFreeFences.pop_back();
+
+		vkDevice.resetFences(fence);
+
+		return fence;
+	}
+
+	vk::FenceCreateInfo info = {};
+
+	info
+		.setPNext(nullptr)
+		.setFlags(vk::FenceCreateFlags(0));
+
+	return vkDevice.createFence(info);
 }
 
 #endif
@@ -5,8 +5,16 @@
 
 #ifdef __ENABLE__VULKAN__
 
+#include <mutex>
+#include <deque>
+
 namespace CodeRed {
 
+	/*
+	 * VulkanFence uses timeline semaphore if the device supports VK_KHR_timeline_semaphore.
+	 * if it is not supported, we use binary fences to simulate the timeline,
+	 * every signal uses a vk::Fence and we record the value it signals.
+	 */
 	class VulkanFence final : public GpuFence {
 	public:
 		explicit VulkanFence(
@@ -14,11 +22,45 @@ namespace CodeRed {
 
 		~VulkanFence();
 
-		auto fence() const noexcept -> vk::Fence { return mFence; }
+		void signal(
+			const std::shared_ptr<GpuCommandQueue>& queue,
+			const size_t value) override;
+
+		auto wait(
+			const size_t value,
+			const size_t timeout = SIZE_MAX)
+			-> bool override;
+
+		auto completedValue() -> size_t override;
+
+		auto semaphore() const noexcept -> vk::Semaphore { return mSemaphore; }
+
+		auto timeline() const noexcept -> bool { return static_cast<bool>(mSemaphore); }
 	private:
-		vk::Fence mFence;
+		void submit(
+			const vk::Queue& queue,
+			const vk::SubmitInfo& info,
+			const size_t value);
+
+		void updateCompletedValue();
+
+		auto allocateFence() -> vk::Fence;
+		
+		friend class VulkanCommandQueue;
+	private:
+		// the semaphore is null if timeline semaphore is not supported
+		vk::Semaphore mSemaphore;
+
+		// the fences are not finished, (value, fence)
+		std::deque<std::pair<size_t, vk::Fence>> mPendingFences;
+		std::vector<vk::Fence> mFreeFences;
+
+		size_t mCompletedValue = 0;
+		size_t mSignaledValue = 0;
+
+		std::mutex mMutex;
 	};
 	
 }
 
-#endif
\ No newline at end of file
+#endif
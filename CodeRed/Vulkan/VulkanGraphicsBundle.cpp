@@ -0,0 +1,257 @@
+#include "../Shared/Exception/InvalidException.hpp"
+#include "../Shared/Exception/FailedException.hpp"
+#include "../Shared/DebugReport.hpp"
+
+#include "VulkanResource/VulkanBuffer.hpp"
+
+#include "VulkanGraphicsPipeline.hpp"
+#include "VulkanGraphicsBundle.hpp"
+#include "VulkanResourceLayout.hpp"
+#include "VulkanDescriptorHeap.hpp"
+#include "VulkanLogicalDevice.hpp"
+#include "VulkanRenderPass.hpp"
+
+#undef min
+
+#ifdef __ENABLE__VULKAN__
+
+using namespace CodeRed::Vulkan;
+
+CodeRed::VulkanGraphicsBundle::VulkanGraphicsBundle(
+	const std::shared_ptr<GpuLogicalDevice>& device) :
+	GpuGraphicsBundle(device)
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+	vk::CommandPoolCreateInfo poolInfo = {};
+	vk::CommandBufferAllocateInfo info = {};
+
+	poolInfo
+		.setPNext(nullptr)
+		.setFlags(vk::CommandPoolCreateFlagBits::eResetCommandBuffer)
+		.setQueueFamilyIndex(static_cast<uint32_t>(vkDevice->queueFamilyIndex()));
+
+	mCommandPool = vkDevice->device().createCommandPool(poolInfo);
+	
+	info
+		.setPNext(nullptr)
+		.setCommandPool(mCommandPool)
+		.setLevel(vk::CommandBufferLevel::eSecondary)
+		.setCommandBufferCount(1);
+
+	mCommandBuffer = vkDevice->device().allocateCommandBuffers(info)[0];
+}
+
+CodeRed::VulkanGraphicsBundle::~VulkanGraphicsBundle()
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
+
+	vkDevice.freeCommandBuffers(mCommandPool, mCommandBuffer);
+	vkDevice.destroyCommandPool(mCommandPool);
+}
+
+void CodeRed::VulkanGraphicsBundle::beginRecording(
+	const std::shared_ptr<GpuRenderPass>& render_pass)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		render_pass == nullptr,
+		InvalidException<GpuRenderPass>({ "render_pass" })
+	);
+	
+	mCommandBuffer.reset(vk::CommandBufferResetFlags(0));
+
+	mResourceLayout.reset();
+
+	vk::CommandBufferInheritanceInfo inheritanceInfo = {};
+	vk::CommandBufferBeginInfo info = {};
+
+	inheritanceInfo
+		.setPNext(nullptr)
+		.setRenderPass(std::static_pointer_cast<VulkanRenderPass>(render_pass)->renderPass())
+		.setSubpass(0)
+		.setFramebuffer(nullptr)
+		.setOcclusionQueryEnable(false);
+
+	// the bundle may be executed by the command lists of frames in flight at the same time
+	info
+		.setPNext(nullptr)
+		.setFlags(
+			vk::CommandBufferUsageFlagBits::eRenderPassContinue |
+			vk::CommandBufferUsageFlagBits::eSimultaneousUse)
+		.setPInheritanceInfo(&inheritanceInfo);
+
+	mCommandBuffer.begin(info);
+}
+
+void CodeRed::VulkanGraphicsBundle::endRecording()
+{
+	mCommandBuffer.end();
+}
+
+void CodeRed::VulkanGraphicsBundle::setGraphicsPipeline(
+	const std::shared_ptr<GpuGraphicsPipeline>& pipeline)
+{
+	mCommandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
+		std::static_pointer_cast<VulkanGraphicsPipeline>(pipeline)->pipeline());
+}
+
+void CodeRed::VulkanGraphicsBundle::setResourceLayout(
+	const std::shared_ptr<GpuResourceLayout>& layout)
+{
+	mResourceLayout = std::static_pointer_cast<VulkanResourceLayout>(layout);
+}
+
+void CodeRed::VulkanGraphicsBundle::setVertexBuffer(
+	const GpuBufferView& view)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset + view.Size > view.Buffer->size(),
+		InvalidException<GpuBufferView>({ "view" }, { "the range of view is out of the buffer." })
+	);
+	
+	const auto vkBuffer = std::static_pointer_cast<VulkanBuffer>(view.Buffer);
+
+	mCommandBuffer.bindVertexBuffers(0, vkBuffer->buffer(), { static_cast<vk::DeviceSize>(view.Offset) });
+}
+
+void CodeRed::VulkanGraphicsBundle::setVertexBuffers(
+	const std::vector<GpuBufferView>& views,
+	const size_t startSlot)
+{
+	auto vkBuffers = std::vector<vk::Buffer>(views.size());
+	auto offsets = std::vector<vk::DeviceSize>(views.size(), 0);
+
+	for (size_t index = 0; index < vkBuffers.size(); index++) {
+		vkBuffers[index] = std::static_pointer_cast<VulkanBuffer>(views[index].Buffer)->buffer();
+		offsets[index] = static_cast<vk::DeviceSize>(views[index].Offset);
+	}
+
+	mCommandBuffer.bindVertexBuffers(
+		static_cast<uint32_t>(startSlot),
+		vkBuffers, offsets);
+}
+
+void CodeRed::VulkanGraphicsBundle::setIndexBuffer(
+	const GpuBufferView& view,
+	const IndexType type)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset + view.Size > view.Buffer->size(),
+		InvalidException<GpuBufferView>({ "view" }, { "the range of view is out of the buffer." })
+	);
+	
+	const auto vkBuffer = std::static_pointer_cast<VulkanBuffer>(view.Buffer);
+
+	mCommandBuffer.bindIndexBuffer(vkBuffer->buffer(), view.Offset, enumConvert(type));
+}
+
+void CodeRed::VulkanGraphicsBundle::setDescriptorHeap(
+	const std::shared_ptr<GpuDescriptorHeap>& heap)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mResourceLayout == nullptr,
+		InvalidException<GpuResourceLayout>({ "resource layout" })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		heap->layout() != mResourceLayout,
+		FailedException(DebugType::Set,
+			{ "GpuDescriptorHeap", "Graphics Bundle" },
+			{ "current resource layout is not the one that create the heap." });
+	);
+
+	const auto vkHeap = std::static_pointer_cast<VulkanDescriptorHeap>(heap);
+
+	CODE_RED_TRY_EXECUTE(
+		heap->count() != 0,
+		mCommandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+			mResourceLayout->layout(), 0, vkHeap->descriptorSets(), {})
+	);
+}
+
+void CodeRed::VulkanGraphicsBundle::setConstant32Bits(
+	const std::vector<Value32Bit>& values)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mResourceLayout == nullptr,
+		FailedException(DebugType::Set,
+			{ "Constant32Bits", "Graphics Bundle" },
+			{ "please set the resource layout, before set constant32Bits." })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		mResourceLayout->constant32Bits().has_value() == false,
+		FailedException(DebugType::Set,
+			{ "Constant32Bits", "Graphics Bundle" },
+			{ "please enable the Constant32Bits in GpuResourceLayout." })
+	);
+
+	const auto constant32Bits = mResourceLayout->constant32Bits();
+
+	mCommandBuffer.pushConstants(
+		mResourceLayout->layout(),
+		enumConvert(constant32Bits->Visibility),
+		0,
+		static_cast<uint32_t>(std::min(values.size(), constant32Bits->Count) * sizeof(UInt32)),
+		values.data()
+	);
+}
+
+void CodeRed::VulkanGraphicsBundle::setViewPort(const ViewPort& view_port)
+{
+	// the secondary command buffer does not inherit the dynamic states, so we need set it again
+	// we flip the view port as VulkanGraphicsCommandList does
+	mCommandBuffer.setViewport(
+		0, vk::Viewport(
+			view_port.X,
+			view_port.Height - view_port.Y,
+			view_port.Width,
+			-view_port.Height,
+			view_port.MinDepth,
+			view_port.MaxDepth
+		)
+	);
+}
+
+void CodeRed::VulkanGraphicsBundle::setScissorRect(const ScissorRect& rect)
+{
+	mCommandBuffer.setScissor(0, vk::Rect2D(
+		vk::Offset2D(
+			static_cast<int32_t>(rect.Left),
+			static_cast<int32_t>(rect.Top)),
+		vk::Extent2D(
+			static_cast<int32_t>(rect.Right),
+			static_cast<int32_t>(rect.Bottom))
+	));
+}
+
+void CodeRed::VulkanGraphicsBundle::draw(
+	const size_t vertex_count,
+	const size_t instance_count,
+	const size_t start_vertex_location,
+	const size_t start_instance_location)
+{
+	mCommandBuffer.draw(
+		static_cast<uint32_t>(vertex_count),
+		static_cast<uint32_t>(instance_count),
+		static_cast<uint32_t>(start_vertex_location),
+		static_cast<uint32_t>(start_instance_location));
+}
+
+void CodeRed::VulkanGraphicsBundle::drawIndexed(
+	const size_t index_count,
+	const size_t instance_count,
+	const size_t start_index_location,
+	const size_t base_vertex_location,
+	const size_t start_instance_location)
+{
+	mCommandBuffer.drawIndexed(
+		static_cast<uint32_t>(index_count),
+		static_cast<uint32_t>(instance_count),
+		static_cast<uint32_t>(start_index_location),
+		static_cast<uint32_t>(base_vertex_location),
+		static_cast<uint32_t>(start_instance_location)
+	);
+}
+
+#endif
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "../Interface/GpuGraphicsBundle.hpp"
+#include "VulkanUtility.hpp"
+
+#ifdef __ENABLE__VULKAN__
+
+namespace CodeRed {
+
+	class VulkanResourceLayout;
+
+	/*
+	 * VulkanGraphicsBundle is a secondary command buffer that continues the render pass
+	 * it owns the command pool, so it can be recorded on any thread and kept for many frames.
+	 */
+	class VulkanGraphicsBundle final : public GpuGraphicsBundle {
+	public:
+		explicit VulkanGraphicsBundle(
+			const std::shared_ptr<GpuLogicalDevice>& device);
+
+		~VulkanGraphicsBundle();
+
+		void beginRecording(
+			const std::shared_ptr<GpuRenderPass>& render_pass) override;
+
+		void endRecording() override;
+
+		void setGraphicsPipeline(
+			const std::shared_ptr<GpuGraphicsPipeline>& pipeline) override;
+
+		void setResourceLayout(
+			const std::shared_ptr<GpuResourceLayout>& layout) override;
+
+		void setVertexBuffer(
+			const GpuBufferView& view) override;
+
+		void setVertexBuffers(
+			const std::vector<GpuBufferView>& views,
+			const size_t startSlot) override;
+
+		void setIndexBuffer(
+			const GpuBufferView& view,
+			const IndexType type) override;
+
+		void setDescriptorHeap(
+			const std::shared_ptr<GpuDescriptorHeap>& heap) override;
+
+		void setConstant32Bits(
+			const std::vector<Value32Bit>& values) override;
+
+		void setViewPort(
+			const ViewPort& view_port) override;
+
+		void setScissorRect(
+			const ScissorRect& rect) override;
+
+		void draw(
+			const size_t vertex_count,
+			const size_t instance_count = 1,
+			const size_t start_vertex_location = 0,
+			const size_t start_instance_location = 0) override;
+
+		void drawIndexed(
+			const size_t index_count,
+			const size_t instance_count,
+			const size_t start_index_location,
+			const size_t base_vertex_location,
+			const size_t start_instance_location) override;
+
+		auto commandList() const noexcept -> vk::CommandBuffer { return mCommandBuffer; }
+	private:
+		vk::CommandPool mCommandPool;
+		vk::CommandBuffer mCommandBuffer;
+
+		std::shared_ptr<VulkanResourceLayout> mResourceLayout;
+	};
+	
+}
+
+#endif
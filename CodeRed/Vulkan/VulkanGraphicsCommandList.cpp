@@ -1,3 +1,4 @@
+#include "../Shared/Exception/NotSupportException.hpp"
 #include "../Shared/Exception/InvalidException.hpp"
 #include "../Shared/Exception/FailedException.hpp"
 
@@ -6,7 +7,9 @@
 #include "VulkanResource/VulkanBuffer.hpp"
 
 #include "VulkanGraphicsCommandList.hpp"
+#include "VulkanGraphicsBundle.hpp"
 #include "VulkanGraphicsPipeline.hpp"
+#include "VulkanComputePipeline.hpp"
 #include "VulkanCommandAllocator.hpp"
 #include "VulkanResourceLayout.hpp"
 #include "VulkanDescriptorHeap.hpp"
@@ -15,7 +18,10 @@
 #include "VulkanRenderPass.hpp"
 #include "VulkanTextureRef.hpp"
 
+#include <algorithm>
+
 #undef min
+#undef max
 
 #ifdef __ENABLE__VULKAN__
 
@@ -50,9 +56,19 @@ CodeRed::VulkanGraphicsCommandList::~VulkanGraphicsCommandList()
 
 void CodeRed::VulkanGraphicsCommandList::beginRecording()
 {
-	mCommandBuffer.reset(vk::CommandBufferResetFlagBits::eReleaseResources);
+	// we keep the memory of command buffer, because we will record it again in the next frame
+	mCommandBuffer.reset(vk::CommandBufferResetFlags(0));
 	
 	mResourceLayout.reset();
+
+	mImageBarriers.clear();
+	mBufferBarriers.clear();
+	mSrcStageMask = vk::PipelineStageFlags();
+	mDstStageMask = vk::PipelineStageFlags();
+
+	resetBoundState();
+
+	mStateStatistics = StateStatistics();
 	
 	const vk::CommandBufferBeginInfo info = {};
 	
@@ -61,6 +77,9 @@ void CodeRed::VulkanGraphicsCommandList::beginRecording()
 
 void CodeRed::VulkanGraphicsCommandList::endRecording()
 {
+	// the layout transitions at the end of list(for example, render target to present)
+	flushBarriers();
+	
 	mCommandBuffer.end();
 }
 
@@ -89,6 +108,57 @@ void CodeRed::VulkanGraphicsCommandList::beginRenderPass(
 	tryLayoutTransition(mFrameBuffer->depthStencil(), mRenderPass->depth(), false);
 	// end layout transition
 
+	// the render pass is began when we record the first draw or bundle,
+	// because we need know the contents of render pass is inline or secondary command buffers
+	mRenderPassContents.reset();
+}
+
+void CodeRed::VulkanGraphicsCommandList::endRenderPass()
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mFrameBuffer == nullptr ||
+		mRenderPass == nullptr,
+		Exception("please begin a render pass before end a render pass.")
+	);
+
+	// if there are no draw commands, we also need begin the render pass to clear the attachments
+	applyRenderPass(vk::SubpassContents::eInline);
+	
+	mCommandBuffer.endRenderPass();
+	
+	for (size_t index = 0; index < mFrameBuffer->size(); index++)
+		tryLayoutTransition(mFrameBuffer->renderTarget(index), mRenderPass->color(index), true);
+
+	tryLayoutTransition(mFrameBuffer->depthStencil(), mRenderPass->depth(), true);
+
+	mRenderPassContents.reset();
+	mFrameBuffer.reset();
+	mRenderPass.reset();
+}
+
+void CodeRed::VulkanGraphicsCommandList::applyRenderPass(const vk::SubpassContents contents)
+{
+	// the layout transitions of attachments should be submitted before we begin the render pass
+	flushBarriers();
+	
+	if (mRenderPass == nullptr) return;
+
+	if (mRenderPassContents.has_value()) {
+		CODE_RED_DEBUG_THROW_IF(
+			contents == vk::SubpassContents::eSecondaryCommandBuffers &&
+			mRenderPassContents.value() == vk::SubpassContents::eInline,
+			Exception("the render pass can not execute bundles after recording draw commands.")
+		);
+
+		CODE_RED_DEBUG_THROW_IF(
+			contents == vk::SubpassContents::eInline &&
+			mRenderPassContents.value() == vk::SubpassContents::eSecondaryCommandBuffers,
+			Exception("the render pass can not record draw commands after executing bundles.")
+		);
+		
+		return;
+	}
+	
 	std::vector<vk::ClearValue> clearValues;
 
 	for (size_t index = 0; index < mFrameBuffer->size(); index++) {
@@ -125,33 +195,33 @@ void CodeRed::VulkanGraphicsCommandList::beginRenderPass(
 			)
 		));
 
-	mCommandBuffer.beginRenderPass(info, vk::SubpassContents::eInline);
+	mCommandBuffer.beginRenderPass(info, contents);
+
+	mRenderPassContents = contents;
 }
 
-void CodeRed::VulkanGraphicsCommandList::endRenderPass()
+void CodeRed::VulkanGraphicsCommandList::setGraphicsPipeline(
+	const std::shared_ptr<GpuGraphicsPipeline>& pipeline)
 {
-	CODE_RED_DEBUG_THROW_IF(
-		mFrameBuffer == nullptr ||
-		mRenderPass == nullptr,
-		Exception("please begin a render pass before end a render pass.")
-	);
-	
-	mCommandBuffer.endRenderPass();
-	
-	for (size_t index = 0; index < mFrameBuffer->size(); index++)
-		tryLayoutTransition(mFrameBuffer->renderTarget(index), mRenderPass->color(index), true);
+	const auto vkPipeline = std::static_pointer_cast<VulkanGraphicsPipeline>(pipeline)->pipeline();
 
-	tryLayoutTransition(mFrameBuffer->depthStencil(), mRenderPass->depth(), true);
+	if (!bindState(mBoundGraphicsPipeline != vkPipeline)) return;
 
-	mFrameBuffer.reset();
-	mRenderPass.reset();
+	mCommandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics, vkPipeline);
+
+	mBoundGraphicsPipeline = vkPipeline;
 }
 
-void CodeRed::VulkanGraphicsCommandList::setGraphicsPipeline(
-	const std::shared_ptr<GpuGraphicsPipeline>& pipeline)
+void CodeRed::VulkanGraphicsCommandList::setComputePipeline(
+	const std::shared_ptr<GpuComputePipeline>& pipeline)
 {
-	mCommandBuffer.bindPipeline(vk::PipelineBindPoint::eGraphics,
-		std::static_pointer_cast<VulkanGraphicsPipeline>(pipeline)->pipeline());
+	const auto vkPipeline = std::static_pointer_cast<VulkanComputePipeline>(pipeline)->pipeline();
+
+	if (!bindState(mBoundComputePipeline != vkPipeline)) return;
+
+	mCommandBuffer.bindPipeline(vk::PipelineBindPoint::eCompute, vkPipeline);
+
+	mBoundComputePipeline = vkPipeline;
 }
 
 void CodeRed::VulkanGraphicsCommandList::setResourceLayout(
@@ -161,35 +231,70 @@ void CodeRed::VulkanGraphicsCommandList::setResourceLayout(
 }
 
 void CodeRed::VulkanGraphicsCommandList::setVertexBuffer(
-	const std::shared_ptr<GpuBuffer>& buffer)
+	const GpuBufferView& view)
 {
-	const auto vkBuffer = std::static_pointer_cast<VulkanBuffer>(buffer);
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset + view.Size > view.Buffer->size(),
+		InvalidException<GpuBufferView>({ "view" }, { "the range of view is out of the buffer." })
+	);
+	
+	const auto vkBuffer = std::static_pointer_cast<VulkanBuffer>(view.Buffer)->buffer();
+	const auto offset = static_cast<vk::DeviceSize>(view.Offset);
+
+	if (mBoundVertexBuffers.empty()) mBoundVertexBuffers.resize(1);
+
+	if (!bindState(mBoundVertexBuffers[0] != std::make_pair(vkBuffer, offset))) return;
 	
-	mCommandBuffer.bindVertexBuffers(0, vkBuffer->buffer(), { 0 });
+	mCommandBuffer.bindVertexBuffers(0, vkBuffer, { offset });
+
+	mBoundVertexBuffers[0] = { vkBuffer, offset };
 }
 
 void CodeRed::VulkanGraphicsCommandList::setVertexBuffers(
-	const std::vector<std::shared_ptr<GpuBuffer>>& buffers,
+	const std::vector<GpuBufferView>& views,
 	const size_t startSlot)
 {
-	auto vkBuffers = std::vector<vk::Buffer>(buffers.size());
-	auto offsets = std::vector<vk::DeviceSize>(buffers.size(), 0);
+	auto vkBuffers = std::vector<vk::Buffer>(views.size());
+	auto offsets = std::vector<vk::DeviceSize>(views.size(), 0);
+
+	if (mBoundVertexBuffers.size() < startSlot + views.size()) mBoundVertexBuffers.resize(startSlot + views.size());
+
+	auto changed = false;
+	
+	for (size_t index = 0; index < vkBuffers.size(); index++) {
+		vkBuffers[index] = std::static_pointer_cast<VulkanBuffer>(views[index].Buffer)->buffer();
+		offsets[index] = static_cast<vk::DeviceSize>(views[index].Offset);
+
+		changed = changed || mBoundVertexBuffers[startSlot + index] != std::make_pair(vkBuffers[index], offsets[index]);
+	}
 
-	for (size_t index = 0; index < vkBuffers.size(); index++) 
-		vkBuffers[index] = std::static_pointer_cast<VulkanBuffer>(buffers[index])->buffer();
+	if (!bindState(changed)) return;
 	
 	mCommandBuffer.bindVertexBuffers(
 		static_cast<uint32_t>(startSlot),
 		vkBuffers, offsets);
+
+	for (size_t index = 0; index < vkBuffers.size(); index++)
+		mBoundVertexBuffers[startSlot + index] = { vkBuffers[index], offsets[index] };
 }
 
 void CodeRed::VulkanGraphicsCommandList::setIndexBuffer(
-	const std::shared_ptr<GpuBuffer>& buffer,
+	const GpuBufferView& view,
 	const IndexType type)
 {
-	const auto vkBuffer = std::static_pointer_cast<VulkanBuffer>(buffer);
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset + view.Size > view.Buffer->size(),
+		InvalidException<GpuBufferView>({ "view" }, { "the range of view is out of the buffer." })
+	);
 
-	mCommandBuffer.bindIndexBuffer(vkBuffer->buffer(), 0, enumConvert(type));
+	CODE_RED_DEBUG_THROW_IF(
+		view.Offset % (type == IndexType::UInt16 ? sizeof(uint16_t) : sizeof(uint32_t)) != 0,
+		InvalidException<GpuBufferView>({ "view" }, { "the offset of view should be multiple of the size of index." })
+	);
+	
+	const auto vkBuffer = std::static_pointer_cast<VulkanBuffer>(view.Buffer);
+
+	mCommandBuffer.bindIndexBuffer(vkBuffer->buffer(), view.Offset, enumConvert(type));
 }
 
 void CodeRed::VulkanGraphicsCommandList::setDescriptorHeap(
@@ -209,11 +314,20 @@ void CodeRed::VulkanGraphicsCommandList::setDescriptorHeap(
 
 	const auto vkHeap = std::static_pointer_cast<VulkanDescriptorHeap>(heap);
 
-	CODE_RED_TRY_EXECUTE(
-		heap->count() != 0,
-		mCommandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
-			mResourceLayout->layout(), 0, vkHeap->descriptorSets(), {})
-	);
+	if (heap->count() == 0) return;
+
+	const auto descriptorSets = vkHeap->descriptorSets();
+
+	if (!bindState(mBoundLayout != mResourceLayout->layout() || mBoundDescriptorSets != descriptorSets)) return;
+	
+	// the descriptor sets are bound to both of graphics and compute pipeline
+	mCommandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eGraphics,
+		mResourceLayout->layout(), 0, descriptorSets, {});
+	mCommandBuffer.bindDescriptorSets(vk::PipelineBindPoint::eCompute,
+		mResourceLayout->layout(), 0, descriptorSets, {});
+
+	mBoundLayout = mResourceLayout->layout();
+	mBoundDescriptorSets = descriptorSets;
 }
 
 void CodeRed::VulkanGraphicsCommandList::setConstant32Bits(
@@ -263,29 +377,39 @@ void CodeRed::VulkanGraphicsCommandList::setViewPort(const ViewPort& view_port)
 	 * this is a extension VK_KHR_Maintenance1 in vulkan 1.0
 	 * but is core in vulkan 1.1
 	 */
-	mCommandBuffer.setViewport(
-		0, vk::Viewport(
-			view_port.X,
-			view_port.Height - view_port.Y,
-			view_port.Width,
-			-view_port.Height,
-			view_port.MinDepth,
-			view_port.MaxDepth
-		)
+	const auto vkViewPort = vk::Viewport(
+		view_port.X,
+		view_port.Height - view_port.Y,
+		view_port.Width,
+		-view_port.Height,
+		view_port.MinDepth,
+		view_port.MaxDepth
 	);
+
+	if (!bindState(!mBoundViewPort.has_value() || mBoundViewPort.value() != vkViewPort)) return;
+	
+	mCommandBuffer.setViewport(0, vkViewPort);
+
+	mBoundViewPort = vkViewPort;
 }
 
 void CodeRed::VulkanGraphicsCommandList::setScissorRect(
 	const ScissorRect& rect)
 {
-	mCommandBuffer.setScissor(0, vk::Rect2D(
+	const auto vkRect = vk::Rect2D(
 		vk::Offset2D(
 			static_cast<int32_t>(rect.Left),
 			static_cast<int32_t>(rect.Top)),
 		vk::Extent2D(
 			static_cast<int32_t>(rect.Right), 
 			static_cast<int32_t>(rect.Bottom))
-	));
+	);
+
+	if (!bindState(!mBoundScissorRect.has_value() || mBoundScissorRect.value() != vkRect)) return;
+	
+	mCommandBuffer.setScissor(0, vkRect);
+
+	mBoundScissorRect = vkRect;
 }
 
 void CodeRed::VulkanGraphicsCommandList::layoutTransition(
@@ -310,11 +434,9 @@ void CodeRed::VulkanGraphicsCommandList::layoutTransition(
 		.setOffset(0)
 		.setSize(buffer->size());
 
-	mCommandBuffer.pipelineBarrier(
-		vk::PipelineStageFlagBits::eAllCommands,
-		vk::PipelineStageFlagBits::eAllCommands,
-		vk::DependencyFlags(0),
-		{}, barrier, {});
+	pushBarrier(barrier,
+		enumConvert2(old_layout, ResourceType::Buffer),
+		enumConvert2(new_layout, ResourceType::Buffer));
 
 	buffer->setLayout(new_layout);
 }
@@ -328,33 +450,11 @@ void CodeRed::VulkanGraphicsCommandList::layoutTransition(
 		texture->layout() != old_layout,
 		InvalidException<ResourceLayout>({ "old_layout" })
 	);
-	
-	vk::ImageMemoryBarrier barrier = {};
-
-	barrier
-		.setPNext(nullptr)
-		.setSrcAccessMask(enumConvert1(old_layout, ResourceType::Texture))
-		.setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
-		.setOldLayout(vk::ImageLayout::eUndefined)
-		.setDstAccessMask(enumConvert1(new_layout, ResourceType::Texture))
-		.setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
-		.setNewLayout(enumConvert(new_layout))
-		.setImage(std::static_pointer_cast<VulkanTexture>(texture)->image())
-		.setSubresourceRange(
-			vk::ImageSubresourceRange(
-				enumConvert(texture->format(), texture->usage()),
-				0,static_cast<uint32_t>(texture->mipLevels()),
-				0, static_cast<uint32_t>(texture->arrays())
-			));
 
-	mCommandBuffer.pipelineBarrier(
-		vk::PipelineStageFlagBits::eAllCommands,
-		vk::PipelineStageFlagBits::eAllCommands,
-		vk::DependencyFlags(0),
-		{}, {},
-		barrier);
-
-	texture->setLayout(new_layout);
+	textureTransition(texture,
+		ValueRange<size_t>(0, texture->mipLevels()),
+		ValueRange<size_t>(0, texture->arrays()),
+		new_layout);
 }
 
 void CodeRed::VulkanGraphicsCommandList::layoutTransition(
@@ -379,15 +479,49 @@ void CodeRed::VulkanGraphicsCommandList::layoutTransition(
 		.setOffset(0)
 		.setSize(buffer->size());
 
-	mCommandBuffer.pipelineBarrier(
-		vk::PipelineStageFlagBits::eAllCommands,
-		vk::PipelineStageFlagBits::eAllCommands,
-		vk::DependencyFlags(0),
-		{}, barrier, {});
+	pushBarrier(barrier,
+		enumConvert2(old_layout, ResourceType::Buffer),
+		enumConvert2(new_layout, ResourceType::Buffer));
 
 	buffer->setLayout(new_layout);
 }
 
+void CodeRed::VulkanGraphicsCommandList::layoutTransition(
+	const std::shared_ptr<GpuTextureRef>& texture,
+	const ResourceLayout layout)
+{
+	textureTransition(texture->source(), texture->mipLevel(), texture->array(), layout);
+}
+
+void CodeRed::VulkanGraphicsCommandList::memoryBarrier(
+	const std::shared_ptr<GpuTextureRef>& texture)
+{
+	const auto source = texture->source();
+	const auto mipLevel = texture->mipLevel();
+	const auto array = texture->array();
+	const auto first = source->layout(mipLevel.Start, array.Start);
+
+	auto uniform = true;
+
+	for (auto arraySlice = array.Start; arraySlice < array.End; arraySlice++) {
+		for (auto mipSlice = mipLevel.Start; mipSlice < mipLevel.End; mipSlice++)
+			uniform = uniform && source->layout(mipSlice, arraySlice) == first;
+	}
+
+	// the barrier of layout transition is also a memory barrier, so we translate the sub-textures to their layouts
+	if (uniform) textureTransition(source, mipLevel, array, first);
+	else {
+		for (auto arraySlice = array.Start; arraySlice < array.End; arraySlice++) {
+			for (auto mipSlice = mipLevel.Start; mipSlice < mipLevel.End; mipSlice++) {
+				textureTransition(source,
+					ValueRange<size_t>(mipSlice, mipSlice + 1),
+					ValueRange<size_t>(arraySlice, arraySlice + 1),
+					source->layout(mipSlice, arraySlice));
+			}
+		}
+	}
+}
+
 void CodeRed::VulkanGraphicsCommandList::resolveTexture(
 	const TextureResolveInfo& source,
 	const TextureResolveInfo& destination)
@@ -431,10 +565,18 @@ void CodeRed::VulkanGraphicsCommandList::resolveTexture(
 	);
 
 	
+	const auto sourceMipLevel = ValueRange<size_t>(source.MipSlice, source.MipSlice + 1);
+	const auto sourceArray = ValueRange<size_t>(source.ArraySlice, source.ArraySlice + 1);
+	const auto destinationMipLevel = ValueRange<size_t>(destination.MipSlice, destination.MipSlice + 1);
+	const auto destinationArray = ValueRange<size_t>(destination.ArraySlice, destination.ArraySlice + 1);
+
+	const auto sourceLayout = source.Texture->layout(source.MipSlice, source.ArraySlice);
+	const auto destinationLayout = destination.Texture->layout(destination.MipSlice, destination.ArraySlice);
+	
 	// Because the layout of image should be vk::ImageLayout::eTransferSrcOptimal and vk::ImageLayout::eTransferDstOptimal
-	// We will transform the textures before we resolve them and transform them back after we resolve them.
-	layoutTransition(source.Texture, source.Texture->layout(), ResourceLayout::CopySource);
-	layoutTransition(destination.Texture, destination.Texture->layout(), ResourceLayout::CopyDestination);
+	// We will transform the sub-textures before we resolve them and transform them back after we resolve them.
+	textureTransition(source.Texture, sourceMipLevel, sourceArray, ResourceLayout::CopySource);
+	textureTransition(destination.Texture, destinationMipLevel, destinationArray, ResourceLayout::CopyDestination);
 	
 	vk::ImageResolve resolve = {};
 
@@ -457,14 +599,16 @@ void CodeRed::VulkanGraphicsCommandList::resolveTexture(
 			1
 		));
 	
+	flushBarriers();
+	
 	mCommandBuffer.resolveImage(
-		vkSource->image(), enumConvert(vkSource->layout()),
-		vkDestination->image(), enumConvert(vkDestination->layout()),
+		vkSource->image(), vk::ImageLayout::eTransferSrcOptimal,
+		vkDestination->image(), vk::ImageLayout::eTransferDstOptimal,
 		resolve
 	);
 
-	layoutTransition(source.Texture, ResourceLayout::CopySource, source.Texture->layout());
-	layoutTransition(destination.Texture, ResourceLayout::CopyDestination, destination.Texture->layout());
+	textureTransition(source.Texture, sourceMipLevel, sourceArray, sourceLayout);
+	textureTransition(destination.Texture, destinationMipLevel, destinationArray, destinationLayout);
 }
 
 void CodeRed::VulkanGraphicsCommandList::copyBuffer(
@@ -474,14 +618,7 @@ void CodeRed::VulkanGraphicsCommandList::copyBuffer(
 	const size_t source_offset,
 	const size_t destination_offset)
 {
-	const vk::BufferCopy copy = {
-		source_offset, destination_offset, static_cast<vk::DeviceSize>(size)
-	};
-
-	mCommandBuffer.copyBuffer(
-		std::static_pointer_cast<VulkanBuffer>(source)->buffer(),
-		std::static_pointer_cast<VulkanBuffer>(destination)->buffer(),
-		copy);
+	copyBuffer(source, destination, { BufferCopyRegion(size, source_offset, destination_offset) });
 }
 
 void CodeRed::VulkanGraphicsCommandList::copyTexture(
@@ -506,118 +643,408 @@ void CodeRed::VulkanGraphicsCommandList::copyTexture(
 	const TextureCopyInfo& destination,
 	const size_t width, const size_t height, const size_t depth)
 {
-	vk::ImageCopy copy = {};
+	copyTexture(source.Texture, destination.Texture, {
+		TextureCopyRegion(
+			source.ResourceIndex, source.LocationX, source.LocationY, source.LocationZ,
+			destination.ResourceIndex, destination.LocationX, destination.LocationY, destination.LocationZ,
+			width, height, depth)
+		});
+}
 
-	const auto size = vk::Extent3D(
-		static_cast<uint32_t>(width),
-		static_cast<uint32_t>(height),
-		static_cast<uint32_t>(depth)
-	);
+void CodeRed::VulkanGraphicsCommandList::copyTextureToBuffer(
+	const TextureCopyInfo& source,
+	const TextureBufferCopyInfo& destination, 
+	const size_t width, const size_t height, const size_t depth)
+{
+	copyTextureToBuffer(source.Texture, destination.Buffer, {
+		TextureCopyRegion(
+			source.ResourceIndex, source.LocationX, source.LocationY, source.LocationZ,
+			0, destination.LocationX, destination.LocationY, destination.LocationZ,
+			width, height, depth)
+		});
+}
+
+void CodeRed::VulkanGraphicsCommandList::copyBufferToTexture(
+	const TextureBufferCopyInfo& source,
+	const TextureCopyInfo& destination, 
+	const size_t width, const size_t height, const size_t depth)
+{
+	copyBufferToTexture(source.Buffer, destination.Texture, {
+		TextureCopyRegion(
+			0, source.LocationX, source.LocationY, source.LocationZ,
+			destination.ResourceIndex, destination.LocationX, destination.LocationY, destination.LocationZ,
+			width, height, depth)
+		});
+}
 
-	const auto srcArraySlice = source.ResourceIndex / source.Texture->mipLevels();
-	const auto srcMipSlice = source.ResourceIndex % source.Texture->mipLevels();
+void CodeRed::VulkanGraphicsCommandList::copyBuffer(
+	const std::shared_ptr<GpuBuffer>& source,
+	const std::shared_ptr<GpuBuffer>& destination,
+	const std::vector<BufferCopyRegion>& regions)
+{
+	if (regions.empty()) return;
 
-	const auto dstArraySlice = destination.ResourceIndex / source.Texture->mipLevels();
-	const auto dstMipSlice = destination.ResourceIndex % source.Texture->mipLevels();
+	flushBarriers();
 	
-	copy
-		.setExtent(size)
-		.setSrcOffset(vk::Offset3D(
-			static_cast<int32_t>(source.LocationX),
-			static_cast<int32_t>(source.LocationY),
-			static_cast<int32_t>(source.LocationZ)))
-		.setSrcSubresource(vk::ImageSubresourceLayers(
-			enumConvert(destination.Texture->format(), destination.Texture->usage()),
-			static_cast<uint32_t>(srcMipSlice),
-			static_cast<uint32_t>(srcArraySlice), 1))
-		.setDstOffset(vk::Offset3D(
-			static_cast<int32_t>(destination.LocationX),
-			static_cast<int32_t>(destination.LocationY),
-			static_cast<int32_t>(destination.LocationZ)))
-		.setDstSubresource(vk::ImageSubresourceLayers(
-			enumConvert(destination.Texture->format(), destination.Texture->usage()),
-			static_cast<uint32_t>(dstMipSlice),
-			static_cast<uint32_t>(dstArraySlice), 1));
+	std::vector<vk::BufferCopy> copies(regions.size());
+
+	for (size_t index = 0; index < regions.size(); index++) {
+		copies[index]
+			.setSrcOffset(static_cast<vk::DeviceSize>(regions[index].SourceOffset))
+			.setDstOffset(static_cast<vk::DeviceSize>(regions[index].DestinationOffset))
+			.setSize(static_cast<vk::DeviceSize>(regions[index].Size));
+	}
+
+	mCommandBuffer.copyBuffer(
+		std::static_pointer_cast<VulkanBuffer>(source)->buffer(),
+		std::static_pointer_cast<VulkanBuffer>(destination)->buffer(),
+		copies);
+}
+
+void CodeRed::VulkanGraphicsCommandList::copyTexture(
+	const std::shared_ptr<GpuTexture>& source,
+	const std::shared_ptr<GpuTexture>& destination,
+	const std::vector<TextureCopyRegion>& regions)
+{
+	if (regions.empty()) return;
+
+	flushBarriers();
+
+	const auto srcAspect = enumConvert(source->format(), source->usage());
+	const auto dstAspect = enumConvert(destination->format(), destination->usage());
+	
+	std::vector<vk::ImageCopy> copies(regions.size());
+
+	for (size_t index = 0; index < regions.size(); index++) {
+		const auto& region = regions[index];
+
+		copies[index]
+			.setExtent(vk::Extent3D(
+				static_cast<uint32_t>(region.Width),
+				static_cast<uint32_t>(region.Height),
+				static_cast<uint32_t>(region.Depth)))
+			.setSrcOffset(vk::Offset3D(
+				static_cast<int32_t>(region.SourceX),
+				static_cast<int32_t>(region.SourceY),
+				static_cast<int32_t>(region.SourceZ)))
+			.setSrcSubresource(vk::ImageSubresourceLayers(srcAspect,
+				static_cast<uint32_t>(region.SourceIndex % source->mipLevels()),
+				static_cast<uint32_t>(region.SourceIndex / source->mipLevels()), 1))
+			.setDstOffset(vk::Offset3D(
+				static_cast<int32_t>(region.DestinationX),
+				static_cast<int32_t>(region.DestinationY),
+				static_cast<int32_t>(region.DestinationZ)))
+			.setDstSubresource(vk::ImageSubresourceLayers(dstAspect,
+				static_cast<uint32_t>(region.DestinationIndex % destination->mipLevels()),
+				static_cast<uint32_t>(region.DestinationIndex / destination->mipLevels()), 1));
+	}
 
 	mCommandBuffer.copyImage(
-		std::static_pointer_cast<VulkanTexture>(source.Texture)->image(),
-		enumConvert(source.Texture->layout()),
-		std::static_pointer_cast<VulkanTexture>(destination.Texture)->image(),
-		enumConvert(destination.Texture->layout()),
-		copy
+		std::static_pointer_cast<VulkanTexture>(source)->image(),
+		regions_layout(source, regions, true),
+		std::static_pointer_cast<VulkanTexture>(destination)->image(),
+		regions_layout(destination, regions, false),
+		copies
 	);
 }
 
 void CodeRed::VulkanGraphicsCommandList::copyTextureToBuffer(
-	const TextureCopyInfo& source,
-	const TextureBufferCopyInfo& destination, 
-	const size_t width, const size_t height, const size_t depth)
+	const std::shared_ptr<GpuTexture>& source,
+	const std::shared_ptr<GpuTextureBuffer>& destination,
+	const std::vector<TextureCopyRegion>& regions)
 {
-	vk::BufferImageCopy imageCopy = {};
-
-	const auto targetArraySlice = source.ResourceIndex / source.Texture->mipLevels();
-	const auto targetMipSlice = source.ResourceIndex % source.Texture->mipLevels();
-	
-	imageCopy
-		.setBufferOffset(0)
-		.setBufferRowLength(static_cast<uint32_t>(destination.Buffer->width()))
-		.setBufferImageHeight(static_cast<uint32_t>(destination.Buffer->height()))
-		.setImageSubresource(vk::ImageSubresourceLayers(
-			enumConvert(source.Texture->format(), source.Texture->usage()),
-			static_cast<uint32_t>(targetMipSlice),
-			static_cast<uint32_t>(targetArraySlice), 1))
-		.setImageOffset(vk::Offset3D(
-			static_cast<int32_t>(source.LocationX),
-			static_cast<int32_t>(source.LocationY),
-			static_cast<int32_t>(source.LocationZ)))
-		.setImageExtent({
-				static_cast<uint32_t>(width),
-				static_cast<uint32_t>(height),
-				static_cast<uint32_t>(depth)
-			});
-	
+	if (regions.empty()) return;
+
+	flushBarriers();
+
+	const auto aspect = buffer_copy_aspect(source);
+
+	std::vector<vk::BufferImageCopy> copies(regions.size());
+
+	for (size_t index = 0; index < regions.size(); index++) {
+		const auto& region = regions[index];
+
+		copies[index]
+			.setBufferOffset(buffer_offset(destination, region.DestinationX, region.DestinationY, region.DestinationZ))
+			.setBufferRowLength(static_cast<uint32_t>(PixelFormatSizeOf::blockAlign(destination->format(), destination->width())))
+			.setBufferImageHeight(static_cast<uint32_t>(PixelFormatSizeOf::blockAlign(destination->format(), destination->height())))
+			.setImageSubresource(vk::ImageSubresourceLayers(aspect,
+				static_cast<uint32_t>(region.SourceIndex % source->mipLevels()),
+				static_cast<uint32_t>(region.SourceIndex / source->mipLevels()), 1))
+			.setImageOffset(vk::Offset3D(
+				static_cast<int32_t>(region.SourceX),
+				static_cast<int32_t>(region.SourceY),
+				static_cast<int32_t>(region.SourceZ)))
+			.setImageExtent(vk::Extent3D(
+				static_cast<uint32_t>(region.Width),
+				static_cast<uint32_t>(region.Height),
+				static_cast<uint32_t>(region.Depth)));
+	}
+
 	mCommandBuffer.copyImageToBuffer(
-		std::static_pointer_cast<VulkanTexture>(source.Texture)->image(),
-		vk::ImageLayout::eTransferSrcOptimal,
-		std::static_pointer_cast<VulkanTextureBuffer>(destination.Buffer)->buffer(),
-		imageCopy
+		std::static_pointer_cast<VulkanTexture>(source)->image(),
+		regions_layout(source, regions, true),
+		std::static_pointer_cast<VulkanTextureBuffer>(destination)->buffer(),
+		copies
 	);
 }
 
 void CodeRed::VulkanGraphicsCommandList::copyBufferToTexture(
-	const TextureBufferCopyInfo& source,
-	const TextureCopyInfo& destination, 
-	const size_t width, const size_t height, const size_t depth)
+	const std::shared_ptr<GpuTextureBuffer>& source,
+	const std::shared_ptr<GpuTexture>& destination,
+	const std::vector<TextureCopyRegion>& regions)
+{
+	if (regions.empty()) return;
+
+	flushBarriers();
+
+	const auto aspect = buffer_copy_aspect(destination);
+
+	std::vector<vk::BufferImageCopy> copies(regions.size());
+
+	for (size_t index = 0; index < regions.size(); index++) {
+		const auto& region = regions[index];
+
+		copies[index]
+			.setBufferOffset(buffer_offset(source, region.SourceX, region.SourceY, region.SourceZ))
+			.setBufferRowLength(static_cast<uint32_t>(PixelFormatSizeOf::blockAlign(source->format(), source->width())))
+			.setBufferImageHeight(static_cast<uint32_t>(PixelFormatSizeOf::blockAlign(source->format(), source->height())))
+			.setImageSubresource(vk::ImageSubresourceLayers(aspect,
+				static_cast<uint32_t>(region.DestinationIndex % destination->mipLevels()),
+				static_cast<uint32_t>(region.DestinationIndex / destination->mipLevels()), 1))
+			.setImageOffset(vk::Offset3D(
+				static_cast<int32_t>(region.DestinationX),
+				static_cast<int32_t>(region.DestinationY),
+				static_cast<int32_t>(region.DestinationZ)))
+			.setImageExtent(vk::Extent3D(
+				static_cast<uint32_t>(region.Width),
+				static_cast<uint32_t>(region.Height),
+				static_cast<uint32_t>(region.Depth)));
+	}
+
+	mCommandBuffer.copyBufferToImage(
+		std::static_pointer_cast<VulkanTextureBuffer>(source)->buffer(),
+		std::static_pointer_cast<VulkanTexture>(destination)->image(),
+		regions_layout(destination, regions, false),
+		copies
+	);
+}
+
+void CodeRed::VulkanGraphicsCommandList::blitTexture(
+	const TextureBlitInfo& source,
+	const TextureBlitInfo& destination,
+	const BlitFilter filter)
 {
-	vk::BufferImageCopy imageCopy = {};
+	CODE_RED_DEBUG_THROW_IF(
+		mRenderPass != nullptr,
+		Exception("please end the render pass before blit texture.")
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		source.Texture->sample() != MultiSample::Count1 ||
+		destination.Texture->sample() != MultiSample::Count1,
+		InvalidException<GpuTexture>({ "source or destination" },
+			{ "We can not blit MSAA texture, please use resolveTexture." })
+	);
+
+	// vkCmdBlitImage does not clip the region, so the region should be in the sub-texture
+	const auto outside = [](const TextureBlitInfo& info)
+	{
+		return
+			info.MipSlice >= info.Texture->mipLevels() ||
+			info.ArraySlice >= info.Texture->arrays() ||
+			std::max(info.Region.Left, info.Region.Right) > info.Texture->width(info.MipSlice) ||
+			std::max(info.Region.Top, info.Region.Bottom) > info.Texture->height(info.MipSlice) ||
+			std::max(info.Region.Front, info.Region.Back) > info.Texture->depth(info.MipSlice);
+	};
+
+	CODE_RED_DEBUG_THROW_IF(
+		outside(source) || outside(destination),
+		InvalidException<TextureBlitInfo>({ "source or destination" },
+			{ "The region is out of the sub-texture." })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		source.Texture->layout(source.MipSlice, source.ArraySlice) != ResourceLayout::CopySource,
+		InvalidException<TextureBlitInfo>({ "source" },
+			{ "The layout of source should be ResourceLayout::CopySource." })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		destination.Texture->layout(destination.MipSlice, destination.ArraySlice) != ResourceLayout::CopyDestination,
+		InvalidException<TextureBlitInfo>({ "destination" },
+			{ "The layout of destination should be ResourceLayout::CopyDestination." })
+	);
+
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+	const auto srcFeatures = vkDevice->mPhysicalDevice.getFormatProperties(
+		enumConvert(source.Texture->format())).optimalTilingFeatures;
+	const auto dstFeatures = vkDevice->mPhysicalDevice.getFormatProperties(
+		enumConvert(destination.Texture->format())).optimalTilingFeatures;
+
+	// the compressed and some depth formats can not be blitted
+	CODE_RED_TRY_EXECUTE(
+		!(srcFeatures & vk::FormatFeatureFlagBits::eBlitSrc) ||
+		!(dstFeatures & vk::FormatFeatureFlagBits::eBlitDst),
+		throw NotSupportException(NotSupportType::Object)
+	);
 
-	const auto targetArraySlice = destination.ResourceIndex / destination.Texture->mipLevels();
-	const auto targetMipSlice = destination.ResourceIndex % destination.Texture->mipLevels();
+	const auto srcAspect = enumConvert(source.Texture->format(), source.Texture->usage());
 
-	imageCopy
-		.setBufferOffset(0)
-		.setBufferRowLength(static_cast<uint32_t>(source.Buffer->width()))
-		.setBufferImageHeight(static_cast<uint32_t>(source.Buffer->height()))
-		.setImageSubresource(vk::ImageSubresourceLayers(
+	// if the format of source does not support linear filter, we use nearest filter
+	// the depth and stencil can only be blitted with nearest filter
+	const auto vkFilter =
+		(srcFeatures & vk::FormatFeatureFlagBits::eSampledImageFilterLinear) &&
+		!(srcAspect & (vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil)) ?
+		enumConvert(filter) : vk::Filter::eNearest;
+	
+	const auto offsets = [](const Extent3D<size_t>& region)
+	{
+		return std::array<vk::Offset3D, 2>{
+			vk::Offset3D(
+				static_cast<int32_t>(region.Left),
+				static_cast<int32_t>(region.Top),
+				static_cast<int32_t>(region.Front)),
+			vk::Offset3D(
+				static_cast<int32_t>(region.Right),
+				static_cast<int32_t>(region.Bottom),
+				static_cast<int32_t>(region.Back))
+		};
+	};
+
+	flushBarriers();
+	
+	vk::ImageBlit blit = {};
+
+	blit
+		.setSrcSubresource(vk::ImageSubresourceLayers(
+			srcAspect,
+			static_cast<uint32_t>(source.MipSlice),
+			static_cast<uint32_t>(source.ArraySlice), 1))
+		.setSrcOffsets(offsets(source.Region))
+		.setDstSubresource(vk::ImageSubresourceLayers(
 			enumConvert(destination.Texture->format(), destination.Texture->usage()),
-			static_cast<uint32_t>(targetMipSlice),
-			static_cast<uint32_t>(targetArraySlice), 1))
-		.setImageOffset(vk::Offset3D(
-			static_cast<int32_t>(destination.LocationX),
-			static_cast<int32_t>(destination.LocationY),
-			static_cast<int32_t>(destination.LocationZ)))
-		.setImageExtent({
-				static_cast<uint32_t>(width),
-				static_cast<uint32_t>(height),
-				static_cast<uint32_t>(depth)
-			});
+			static_cast<uint32_t>(destination.MipSlice),
+			static_cast<uint32_t>(destination.ArraySlice), 1))
+		.setDstOffsets(offsets(destination.Region));
 
-	mCommandBuffer.copyBufferToImage(
-		std::static_pointer_cast<VulkanTextureBuffer>(source.Buffer)->buffer(),
+	mCommandBuffer.blitImage(
+		std::static_pointer_cast<VulkanTexture>(source.Texture)->image(),
+		enumConvert(source.Texture->layout(source.MipSlice, source.ArraySlice)),
 		std::static_pointer_cast<VulkanTexture>(destination.Texture)->image(),
-		enumConvert(destination.Texture->layout()),
-		imageCopy
+		enumConvert(destination.Texture->layout(destination.MipSlice, destination.ArraySlice)),
+		blit, vkFilter);
+}
+
+void CodeRed::VulkanGraphicsCommandList::generateMipmaps(
+	const std::shared_ptr<GpuTexture>& texture)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mRenderPass != nullptr,
+		Exception("please end the render pass before generate mipmaps.")
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		texture->sample() != MultiSample::Count1,
+		InvalidException<GpuTexture>({ "texture" },
+			{ "We can not generate mipmaps for MSAA texture." })
+	);
+
+	if (texture->mipLevels() <= 1) return;
+
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+	const auto vkTexture = std::static_pointer_cast<VulkanTexture>(texture);
+
+	const auto features = vkDevice->mPhysicalDevice.getFormatProperties(
+		enumConvert(texture->format())).optimalTilingFeatures;
+
+	// the compressed and some depth formats can not be blitted
+	CODE_RED_TRY_EXECUTE(
+		!(features & vk::FormatFeatureFlagBits::eBlitSrc) ||
+		!(features & vk::FormatFeatureFlagBits::eBlitDst),
+		throw NotSupportException(NotSupportType::Object)
 	);
+
+	const auto aspect = enumConvert(texture->format(), texture->usage());
+
+	// the depth and stencil can only be blitted with nearest filter
+	const auto filter =
+		(features & vk::FormatFeatureFlagBits::eSampledImageFilterLinear) &&
+		!(aspect & (vk::ImageAspectFlagBits::eDepth | vk::ImageAspectFlagBits::eStencil)) ?
+		vk::Filter::eLinear : vk::Filter::eNearest;
+
+	const auto arrays = static_cast<uint32_t>(texture->arrays());
+	const auto levels = static_cast<uint32_t>(texture->mipLevels());
+
+	const auto allArrays = ValueRange<size_t>(0, texture->arrays());
+	
+	// the layouts of sub-textures before we generate mipmaps, we translate them back at the end
+	std::vector<ResourceLayout> layouts(texture->mipLevels() * texture->arrays());
+
+	for (size_t arraySlice = 0; arraySlice < texture->arrays(); arraySlice++) {
+		for (size_t mipSlice = 0; mipSlice < texture->mipLevels(); mipSlice++)
+			layouts[texture->index(mipSlice, arraySlice)] = texture->layout(mipSlice, arraySlice);
+	}
+
+	// the mip level 0 is the source of first blit, the other mip levels will be overwritten
+	// so we do not need keep the content of them, we translate them from undefined layout
+	for (size_t arraySlice = 0; arraySlice < texture->arrays(); arraySlice++) {
+		for (size_t mipSlice = 1; mipSlice < texture->mipLevels(); mipSlice++)
+			vkTexture->mUndefinedLayouts[texture->index(mipSlice, arraySlice)] = true;
+	}
+	
+	textureTransition(texture, ValueRange<size_t>(0, 1), allArrays, ResourceLayout::CopySource);
+	textureTransition(texture, ValueRange<size_t>(1, texture->mipLevels()), allArrays, ResourceLayout::CopyDestination);
+	
+	for (uint32_t mip = 1; mip < levels; mip++) {
+		vk::ImageBlit blit = {};
+
+		blit
+			.setSrcSubresource(vk::ImageSubresourceLayers(aspect, mip - 1, 0, arrays))
+			.setSrcOffsets({
+				vk::Offset3D(0, 0, 0),
+				vk::Offset3D(
+					static_cast<int32_t>(texture->width(mip - 1)),
+					static_cast<int32_t>(texture->height(mip - 1)),
+					static_cast<int32_t>(texture->depth(mip - 1)))
+				})
+			.setDstSubresource(vk::ImageSubresourceLayers(aspect, mip, 0, arrays))
+			.setDstOffsets({
+				vk::Offset3D(0, 0, 0),
+				vk::Offset3D(
+					static_cast<int32_t>(texture->width(mip)),
+					static_cast<int32_t>(texture->height(mip)),
+					static_cast<int32_t>(texture->depth(mip)))
+				});
+
+		flushBarriers();
+		
+		mCommandBuffer.blitImage(
+			vkTexture->image(), vk::ImageLayout::eTransferSrcOptimal,
+			vkTexture->image(), vk::ImageLayout::eTransferDstOptimal,
+			blit, filter);
+
+		// the mip level we generated is the source of next blit
+		textureTransition(texture, ValueRange<size_t>(mip, mip + 1), allArrays, ResourceLayout::CopySource);
+	}
+
+	// all mip levels are CopySource now, we transform them back to the layouts of sub-textures
+	if (std::all_of(layouts.begin(), layouts.end(),
+		[&](const ResourceLayout layout) { return layout == layouts.front(); })) {
+		textureTransition(texture, ValueRange<size_t>(0, texture->mipLevels()), allArrays, layouts.front());
+
+		return;
+	}
+
+	for (size_t arraySlice = 0; arraySlice < texture->arrays(); arraySlice++) {
+		for (size_t mipSlice = 0; mipSlice < texture->mipLevels(); mipSlice++) {
+			textureTransition(texture,
+				ValueRange<size_t>(mipSlice, mipSlice + 1),
+				ValueRange<size_t>(arraySlice, arraySlice + 1),
+				layouts[texture->index(mipSlice, arraySlice)]);
+		}
+	}
 }
 
 void CodeRed::VulkanGraphicsCommandList::draw(
@@ -626,6 +1053,8 @@ void CodeRed::VulkanGraphicsCommandList::draw(
 	const size_t start_vertex_location, 
 	const size_t start_instance_location)
 {
+	applyRenderPass(vk::SubpassContents::eInline);
+	
 	mCommandBuffer.draw(
 		static_cast<uint32_t>(vertex_count),
 		static_cast<uint32_t>(instance_count),
@@ -640,6 +1069,8 @@ void CodeRed::VulkanGraphicsCommandList::drawIndexed(
 	const size_t base_vertex_location, 
 	const size_t start_instance_location)
 {
+	applyRenderPass(vk::SubpassContents::eInline);
+	
 	mCommandBuffer.drawIndexed(
 		static_cast<uint32_t>(index_count),
 		static_cast<uint32_t>(instance_count),
@@ -649,6 +1080,174 @@ void CodeRed::VulkanGraphicsCommandList::drawIndexed(
 	);
 }
 
+void CodeRed::VulkanGraphicsCommandList::drawIndirect(
+	const std::shared_ptr<GpuBuffer>& argument_buffer, 
+	const size_t draw_count,
+	const size_t argument_offset)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		argument_offset + draw_count * sizeof(DrawIndirectArguments) > argument_buffer->size(),
+		InvalidException<GpuBuffer>({ "argument_buffer" }, { "the range of arguments is out of the buffer." })
+	);
+	
+	applyRenderPass(vk::SubpassContents::eInline);
+
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+	const auto vkBuffer = std::static_pointer_cast<VulkanBuffer>(argument_buffer)->buffer();
+
+	// if the multi draw indirect is not supported, we split it into draw calls
+	if (vkDevice->mPhysicalFeatures.multiDrawIndirect == VK_FALSE) {
+		for (size_t index = 0; index < draw_count; index++) {
+			mCommandBuffer.drawIndirect(vkBuffer,
+				static_cast<vk::DeviceSize>(argument_offset + index * sizeof(DrawIndirectArguments)),
+				1, static_cast<uint32_t>(sizeof(DrawIndirectArguments)));
+		}
+
+		return;
+	}
+	
+	mCommandBuffer.drawIndirect(vkBuffer,
+		static_cast<vk::DeviceSize>(argument_offset),
+		static_cast<uint32_t>(draw_count),
+		static_cast<uint32_t>(sizeof(DrawIndirectArguments)));
+}
+
+void CodeRed::VulkanGraphicsCommandList::drawIndexedIndirect(
+	const std::shared_ptr<GpuBuffer>& argument_buffer, 
+	const size_t draw_count,
+	const size_t argument_offset)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		argument_offset + draw_count * sizeof(DrawIndexedIndirectArguments) > argument_buffer->size(),
+		InvalidException<GpuBuffer>({ "argument_buffer" }, { "the range of arguments is out of the buffer." })
+	);
+	
+	applyRenderPass(vk::SubpassContents::eInline);
+
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+	const auto vkBuffer = std::static_pointer_cast<VulkanBuffer>(argument_buffer)->buffer();
+
+	// if the multi draw indirect is not supported, we split it into draw calls
+	if (vkDevice->mPhysicalFeatures.multiDrawIndirect == VK_FALSE) {
+		for (size_t index = 0; index < draw_count; index++) {
+			mCommandBuffer.drawIndexedIndirect(vkBuffer,
+				static_cast<vk::DeviceSize>(argument_offset + index * sizeof(DrawIndexedIndirectArguments)),
+				1, static_cast<uint32_t>(sizeof(DrawIndexedIndirectArguments)));
+		}
+
+		return;
+	}
+
+	mCommandBuffer.drawIndexedIndirect(vkBuffer,
+		static_cast<vk::DeviceSize>(argument_offset),
+		static_cast<uint32_t>(draw_count),
+		static_cast<uint32_t>(sizeof(DrawIndexedIndirectArguments)));
+}
+
+void CodeRed::VulkanGraphicsCommandList::drawIndirectCount(
+	const std::shared_ptr<GpuBuffer>& argument_buffer,
+	const std::shared_ptr<GpuBuffer>& count_buffer, 
+	const size_t max_draw_count,
+	const size_t argument_offset,
+	const size_t count_offset)
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+	CODE_RED_THROW_IF(
+		vkDevice->mDrawIndirectCount == false,
+		NotSupportException(NotSupportType::Method)
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		argument_offset + max_draw_count * sizeof(DrawIndirectArguments) > argument_buffer->size(),
+		InvalidException<GpuBuffer>({ "argument_buffer" }, { "the range of arguments is out of the buffer." })
+	);
+
+	// the count of draws is a 32bit unsigned integer
+	CODE_RED_DEBUG_THROW_IF(
+		count_offset + sizeof(uint32_t) > count_buffer->size(),
+		InvalidException<GpuBuffer>({ "count_buffer" }, { "the range of count is out of the buffer." })
+	);
+
+	applyRenderPass(vk::SubpassContents::eInline);
+
+	mCommandBuffer.drawIndirectCountKHR(
+		std::static_pointer_cast<VulkanBuffer>(argument_buffer)->buffer(),
+		static_cast<vk::DeviceSize>(argument_offset),
+		std::static_pointer_cast<VulkanBuffer>(count_buffer)->buffer(),
+		static_cast<vk::DeviceSize>(count_offset),
+		static_cast<uint32_t>(max_draw_count),
+		static_cast<uint32_t>(sizeof(DrawIndirectArguments)),
+		vkDevice->mDynamicLoader);
+}
+
+void CodeRed::VulkanGraphicsCommandList::drawIndexedIndirectCount(
+	const std::shared_ptr<GpuBuffer>& argument_buffer,
+	const std::shared_ptr<GpuBuffer>& count_buffer, 
+	const size_t max_draw_count,
+	const size_t argument_offset,
+	const size_t count_offset)
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+	CODE_RED_THROW_IF(
+		vkDevice->mDrawIndirectCount == false,
+		NotSupportException(NotSupportType::Method)
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		argument_offset + max_draw_count * sizeof(DrawIndexedIndirectArguments) > argument_buffer->size(),
+		InvalidException<GpuBuffer>({ "argument_buffer" }, { "the range of arguments is out of the buffer." })
+	);
+
+	// the count of draws is a 32bit unsigned integer
+	CODE_RED_DEBUG_THROW_IF(
+		count_offset + sizeof(uint32_t) > count_buffer->size(),
+		InvalidException<GpuBuffer>({ "count_buffer" }, { "the range of count is out of the buffer." })
+	);
+
+	applyRenderPass(vk::SubpassContents::eInline);
+
+	mCommandBuffer.drawIndexedIndirectCountKHR(
+		std::static_pointer_cast<VulkanBuffer>(argument_buffer)->buffer(),
+		static_cast<vk::DeviceSize>(argument_offset),
+		std::static_pointer_cast<VulkanBuffer>(count_buffer)->buffer(),
+		static_cast<vk::DeviceSize>(count_offset),
+		static_cast<uint32_t>(max_draw_count),
+		static_cast<uint32_t>(sizeof(DrawIndexedIndirectArguments)),
+		vkDevice->mDynamicLoader);
+}
+
+void CodeRed::VulkanGraphicsCommandList::dispatch(
+	const size_t x, 
+	const size_t y, 
+	const size_t z)
+{
+	flushBarriers();
+	
+	mCommandBuffer.dispatch(
+		static_cast<uint32_t>(x),
+		static_cast<uint32_t>(y),
+		static_cast<uint32_t>(z));
+}
+
+void CodeRed::VulkanGraphicsCommandList::executeBundle(
+	const std::shared_ptr<GpuGraphicsBundle>& bundle)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		mRenderPass == nullptr,
+		Exception("please begin a render pass before execute a bundle.")
+	);
+
+	applyRenderPass(vk::SubpassContents::eSecondaryCommandBuffers);
+
+	mCommandBuffer.executeCommands(
+		std::static_pointer_cast<VulkanGraphicsBundle>(bundle)->commandList());
+
+	// the state bound by bundle is unknown, so we need bind the state again
+	resetBoundState();
+}
+
 auto CodeRed::VulkanGraphicsCommandList::image_memory_barrier(
 	const std::shared_ptr<GpuTexture>& texture,
 	const vk::AccessFlags srcAccessMask, 
@@ -677,6 +1276,239 @@ auto CodeRed::VulkanGraphicsCommandList::image_memory_barrier(
 	return barrier;
 }
 
+auto CodeRed::VulkanGraphicsCommandList::buffer_offset(
+	const std::shared_ptr<GpuTextureBuffer>& buffer,
+	const size_t x,
+	const size_t y,
+	const size_t z) -> vk::DeviceSize
+{
+	// the location of compressed texture should be aligned to blocks
+	const auto rowPitch = PixelFormatSizeOf::rowPitch(buffer->format(), buffer->width());
+	const auto depthPitch = rowPitch * PixelFormatSizeOf::rowCount(buffer->format(), buffer->height());
+
+	return static_cast<vk::DeviceSize>(
+		z * depthPitch +
+		PixelFormatSizeOf::rowCount(buffer->format(), y) * rowPitch +
+		PixelFormatSizeOf::rowPitch(buffer->format(), x));
+}
+
+auto CodeRed::VulkanGraphicsCommandList::regions_layout(
+	const std::shared_ptr<GpuTexture>& texture,
+	const std::vector<TextureCopyRegion>& regions,
+	const bool source) -> vk::ImageLayout
+{
+	const auto layout = [&](const TextureCopyRegion& region)
+	{
+		const auto index = source ? region.SourceIndex : region.DestinationIndex;
+
+		return texture->layout(index % texture->mipLevels(), index / texture->mipLevels());
+	};
+
+	const auto first = layout(regions.front());
+
+	// vulkan copies all regions with one layout of image
+	CODE_RED_DEBUG_THROW_IF(
+		std::any_of(regions.begin(), regions.end(),
+			[&](const TextureCopyRegion& region) { return layout(region) != first; }),
+		InvalidException<TextureCopyRegion>({ "regions" },
+			{ "The sub-textures in regions should have same layout." })
+	);
+
+	return enumConvert(first);
+}
+
+auto CodeRed::VulkanGraphicsCommandList::buffer_copy_aspect(
+	const std::shared_ptr<GpuTexture>& texture) -> vk::ImageAspectFlags
+{
+	const auto aspect = enumConvert(texture->format(), texture->usage());
+
+	// the copy between buffer and image can only use one aspect
+	// so we only copy the depth aspect of depth stencil texture, the stencil aspect is not copied
+	if (aspect & vk::ImageAspectFlagBits::eDepth) return vk::ImageAspectFlagBits::eDepth;
+
+	return aspect;
+}
+
+void CodeRed::VulkanGraphicsCommandList::pushBarrier(
+	const vk::ImageMemoryBarrier& barrier,
+	const vk::PipelineStageFlags srcStageMask,
+	const vk::PipelineStageFlags dstStageMask)
+{
+	const auto overlap = [](const vk::ImageSubresourceRange& left, const vk::ImageSubresourceRange& right)
+	{
+		return
+			left.baseMipLevel < right.baseMipLevel + right.levelCount &&
+			right.baseMipLevel < left.baseMipLevel + left.levelCount &&
+			left.baseArrayLayer < right.baseArrayLayer + right.layerCount &&
+			right.baseArrayLayer < left.baseArrayLayer + left.layerCount;
+	};
+	
+	for (auto& pending : mImageBarriers) {
+		if (pending.image != barrier.image || !overlap(pending.subresourceRange, barrier.subresourceRange)) continue;
+
+		// the same sub-resources are translated twice without any command between them
+		// so we merge them into one transition from the first layout to the last layout
+		if (pending.subresourceRange == barrier.subresourceRange) {
+			pending
+				.setDstAccessMask(barrier.dstAccessMask)
+				.setNewLayout(barrier.newLayout);
+
+			mDstStageMask |= dstStageMask;
+
+			return;
+		}
+
+		// the barriers in one vkCmdPipelineBarrier are not ordered
+		// so we need submit the pending barriers before we translate the sub-resources again
+		flushBarriers();
+
+		break;
+	}
+
+	mImageBarriers.push_back(barrier);
+
+	mSrcStageMask |= srcStageMask;
+	mDstStageMask |= dstStageMask;
+}
+
+void CodeRed::VulkanGraphicsCommandList::pushBarrier(
+	const vk::BufferMemoryBarrier& barrier,
+	const vk::PipelineStageFlags srcStageMask,
+	const vk::PipelineStageFlags dstStageMask)
+{
+	for (auto& pending : mBufferBarriers) {
+		if (pending.buffer != barrier.buffer) continue;
+
+		if (pending.offset == barrier.offset && pending.size == barrier.size) {
+			pending.setDstAccessMask(barrier.dstAccessMask);
+
+			mDstStageMask |= dstStageMask;
+
+			return;
+		}
+
+		flushBarriers();
+
+		break;
+	}
+
+	mBufferBarriers.push_back(barrier);
+
+	mSrcStageMask |= srcStageMask;
+	mDstStageMask |= dstStageMask;
+}
+
+void CodeRed::VulkanGraphicsCommandList::flushBarriers()
+{
+	if (mImageBarriers.empty() && mBufferBarriers.empty()) return;
+
+	mCommandBuffer.pipelineBarrier(
+		mSrcStageMask,
+		mDstStageMask,
+		vk::DependencyFlags(0),
+		{}, mBufferBarriers, mImageBarriers);
+
+	mImageBarriers.clear();
+	mBufferBarriers.clear();
+
+	mSrcStageMask = vk::PipelineStageFlags();
+	mDstStageMask = vk::PipelineStageFlags();
+}
+
+void CodeRed::VulkanGraphicsCommandList::textureTransition(
+	const std::shared_ptr<GpuTexture>& texture,
+	const ValueRange<size_t>& mipLevel,
+	const ValueRange<size_t>& array, 
+	const ResourceLayout layout)
+{
+	const auto vkTexture = std::static_pointer_cast<VulkanTexture>(texture);
+	const auto aspect = enumConvert(texture->format(), texture->usage());
+
+	const auto transition = [&](
+		const ResourceLayout old_layout,
+		const bool undefined,
+		const size_t mipStart, const size_t mipCount,
+		const size_t arrayStart, const size_t arrayCount)
+	{
+		vk::ImageMemoryBarrier barrier = {};
+
+		barrier
+			.setPNext(nullptr)
+			.setSrcAccessMask(enumConvert1(old_layout, ResourceType::Texture))
+			.setSrcQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+			.setOldLayout(undefined ? vk::ImageLayout::eUndefined : enumConvert(old_layout))
+			.setDstAccessMask(enumConvert1(layout, ResourceType::Texture))
+			.setDstQueueFamilyIndex(VK_QUEUE_FAMILY_IGNORED)
+			.setNewLayout(enumConvert(layout))
+			.setImage(vkTexture->image())
+			.setSubresourceRange(
+				vk::ImageSubresourceRange(aspect,
+					static_cast<uint32_t>(mipStart), static_cast<uint32_t>(mipCount),
+					static_cast<uint32_t>(arrayStart), static_cast<uint32_t>(arrayCount)
+				));
+
+		pushBarrier(barrier,
+			enumConvert2(old_layout, ResourceType::Texture),
+			enumConvert2(layout, ResourceType::Texture));
+	};
+
+	const auto undefined = [&](const size_t mipSlice, const size_t arraySlice)
+	{
+		return static_cast<bool>(vkTexture->mUndefinedLayouts[texture->index(mipSlice, arraySlice)]);
+	};
+	
+	const auto first = texture->layout(mipLevel.Start, array.Start);
+	const auto firstUndefined = undefined(mipLevel.Start, array.Start);
+
+	auto uniform = true;
+	
+	for (auto arraySlice = array.Start; arraySlice < array.End; arraySlice++) {
+		for (auto mipSlice = mipLevel.Start; mipSlice < mipLevel.End; mipSlice++) {
+			uniform = uniform &&
+				texture->layout(mipSlice, arraySlice) == first &&
+				undefined(mipSlice, arraySlice) == firstUndefined;
+		}
+	}
+
+	// if the sub-textures in range have same layout, we only need one barrier
+	// otherwise we translate the sub-textures one by one with their old layouts
+	if (uniform) transition(first, firstUndefined, mipLevel.Start, mipLevel.size(), array.Start, array.size());
+	else {
+		for (auto arraySlice = array.Start; arraySlice < array.End; arraySlice++) {
+			for (auto mipSlice = mipLevel.Start; mipSlice < mipLevel.End; mipSlice++)
+				transition(texture->layout(mipSlice, arraySlice), undefined(mipSlice, arraySlice), mipSlice, 1, arraySlice, 1);
+		}
+	}
+
+	texture->setLayout(mipLevel, array, layout);
+
+	for (auto arraySlice = array.Start; arraySlice < array.End; arraySlice++) {
+		for (auto mipSlice = mipLevel.Start; mipSlice < mipLevel.End; mipSlice++)
+			vkTexture->mUndefinedLayouts[texture->index(mipSlice, arraySlice)] = false;
+	}
+}
+
+void CodeRed::VulkanGraphicsCommandList::resetBoundState()
+{
+	mBoundGraphicsPipeline = nullptr;
+	mBoundComputePipeline = nullptr;
+
+	mBoundLayout = nullptr;
+	mBoundDescriptorSets.clear();
+	mBoundVertexBuffers.clear();
+
+	mBoundViewPort.reset();
+	mBoundScissorRect.reset();
+}
+
+auto CodeRed::VulkanGraphicsCommandList::bindState(const bool changed) -> bool
+{
+	if (changed) mStateStatistics.Issued++;
+	else mStateStatistics.Skipped++;
+
+	return changed;
+}
+
 void CodeRed::VulkanGraphicsCommandList::tryLayoutTransition(
 	const std::shared_ptr<GpuTextureRef>& texture,
 	const std::optional<Attachment>& attachment, 
@@ -684,8 +1516,7 @@ void CodeRed::VulkanGraphicsCommandList::tryLayoutTransition(
 {
 	CODE_RED_TRY_EXECUTE(
 		texture != nullptr && attachment.has_value(),
-		layoutTransition(texture->source(), texture->source()->layout(),
-			final ? attachment->FinalLayout : attachment->InitialLayout)
+		layoutTransition(texture, final ? attachment->FinalLayout : attachment->InitialLayout)
 	);
 }
 
@@ -37,18 +37,21 @@ namespace CodeRed {
 		void setGraphicsPipeline(
 			const std::shared_ptr<GpuGraphicsPipeline>& pipeline) override;
 
+		void setComputePipeline(
+			const std::shared_ptr<GpuComputePipeline>& pipeline) override;
+
 		void setResourceLayout(
 			const std::shared_ptr<GpuResourceLayout>& layout) override;
 
 		void setVertexBuffer(
-			const std::shared_ptr<GpuBuffer>& buffer) override;
+			const GpuBufferView& view) override;
 
 		void setVertexBuffers(
-			const std::vector<std::shared_ptr<GpuBuffer>>& buffers, 
+			const std::vector<GpuBufferView>& views,
 			const size_t startSlot) override;
 		
 		void setIndexBuffer(
-			const std::shared_ptr<GpuBuffer>& buffer,
+			const GpuBufferView& view,
 			const IndexType type) override;
 
 		void setDescriptorHeap(
@@ -77,6 +80,13 @@ namespace CodeRed {
 			const std::shared_ptr<GpuBuffer>& buffer,
 			const ResourceLayout old_layout,
 			const ResourceLayout new_layout) override;
+
+		void layoutTransition(
+			const std::shared_ptr<GpuTextureRef>& texture,
+			const ResourceLayout layout) override;
+
+		void memoryBarrier(
+			const std::shared_ptr<GpuTextureRef>& texture) override;
 		
 		void resolveTexture(
 			const TextureResolveInfo& source, 
@@ -117,6 +127,34 @@ namespace CodeRed {
 			const size_t width, 
 			const size_t height, 
 			const size_t depth) override;
+
+		void copyBuffer(
+			const std::shared_ptr<GpuBuffer>& source,
+			const std::shared_ptr<GpuBuffer>& destination,
+			const std::vector<BufferCopyRegion>& regions) override;
+
+		void copyTexture(
+			const std::shared_ptr<GpuTexture>& source,
+			const std::shared_ptr<GpuTexture>& destination,
+			const std::vector<TextureCopyRegion>& regions) override;
+
+		void copyTextureToBuffer(
+			const std::shared_ptr<GpuTexture>& source,
+			const std::shared_ptr<GpuTextureBuffer>& destination,
+			const std::vector<TextureCopyRegion>& regions) override;
+
+		void copyBufferToTexture(
+			const std::shared_ptr<GpuTextureBuffer>& source,
+			const std::shared_ptr<GpuTexture>& destination,
+			const std::vector<TextureCopyRegion>& regions) override;
+
+		void blitTexture(
+			const TextureBlitInfo& source,
+			const TextureBlitInfo& destination,
+			const BlitFilter filter) override;
+
+		void generateMipmaps(
+			const std::shared_ptr<GpuTexture>& texture) override;
 		
 		void draw(
 			const size_t vertex_count,
@@ -131,7 +169,50 @@ namespace CodeRed {
 			const size_t base_vertex_location,
 			const size_t start_instance_location) override;
 
+		void drawIndirect(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const size_t draw_count = 1,
+			const size_t argument_offset = 0) override;
+
+		void drawIndexedIndirect(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const size_t draw_count = 1,
+			const size_t argument_offset = 0) override;
+
+		void drawIndirectCount(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const std::shared_ptr<GpuBuffer>& count_buffer,
+			const size_t max_draw_count,
+			const size_t argument_offset = 0,
+			const size_t count_offset = 0) override;
+
+		void drawIndexedIndirectCount(
+			const std::shared_ptr<GpuBuffer>& argument_buffer,
+			const std::shared_ptr<GpuBuffer>& count_buffer,
+			const size_t max_draw_count,
+			const size_t argument_offset = 0,
+			const size_t count_offset = 0) override;
+
+		void dispatch(
+			const size_t x,
+			const size_t y = 1,
+			const size_t z = 1) override;
+
+		void executeBundle(
+			const std::shared_ptr<GpuGraphicsBundle>& bundle) override;
+
 		auto commandList() const noexcept -> vk::CommandBuffer { return mCommandBuffer; }
+
+		/*
+		 * the pipelines, descriptor heaps, vertex buffers, view ports and scissor rects we set are recorded,
+		 * if they are same as the bound ones, we skip them. the counters are reset when we begin recording.
+		 */
+		struct StateStatistics {
+			size_t Issued = 0;
+			size_t Skipped = 0;
+		};
+
+		auto stateStatistics() const noexcept -> StateStatistics { return mStateStatistics; }
 	private:
 		static auto image_memory_barrier(
 			const std::shared_ptr<GpuTexture>& texture,
@@ -139,17 +220,88 @@ namespace CodeRed {
 			const vk::AccessFlags dstAccessMask,
 			const vk::ImageLayout srcLayout,
 			const vk::ImageLayout dstLayout) -> vk::ImageMemoryBarrier;
+
+		// the offset of location(x, y, z) in texture buffer, the rows of texture buffer are tightly packed
+		static auto buffer_offset(
+			const std::shared_ptr<GpuTextureBuffer>& buffer,
+			const size_t x,
+			const size_t y,
+			const size_t z) -> vk::DeviceSize;
+
+		// the layout of sub-textures in regions, the sub-textures should have same layout
+		static auto regions_layout(
+			const std::shared_ptr<GpuTexture>& texture,
+			const std::vector<TextureCopyRegion>& regions,
+			const bool source) -> vk::ImageLayout;
+
+		// the aspect of copy between texture buffer and texture, only the depth aspect of depth stencil is copied
+		static auto buffer_copy_aspect(
+			const std::shared_ptr<GpuTexture>& texture) -> vk::ImageAspectFlags;
+		
+		void applyRenderPass(const vk::SubpassContents contents);
+
+		/*
+		 * the barriers of layout transitions are pending until the next command that uses resources
+		 * so we can submit them with one vkCmdPipelineBarrier and the stage masks of their layouts
+		 */
+		void pushBarrier(
+			const vk::ImageMemoryBarrier& barrier,
+			const vk::PipelineStageFlags srcStageMask,
+			const vk::PipelineStageFlags dstStageMask);
+
+		void pushBarrier(
+			const vk::BufferMemoryBarrier& barrier,
+			const vk::PipelineStageFlags srcStageMask,
+			const vk::PipelineStageFlags dstStageMask);
+
+		void flushBarriers();
 		
+		// translate the sub-textures in the range, the old layouts are the layouts of sub-textures
+		void textureTransition(
+			const std::shared_ptr<GpuTexture>& texture,
+			const ValueRange<size_t>& mipLevel,
+			const ValueRange<size_t>& array,
+			const ResourceLayout layout);
+
 		void tryLayoutTransition(
 			const std::shared_ptr<GpuTextureRef>& texture,
 			const std::optional<Attachment>& attachment,
 			const bool final = false);
+
+		// the state of command buffer is undefined after recording begins or bundles execute
+		void resetBoundState();
+
+		// return true if the state is changed, and count the issued or skipped call
+		auto bindState(const bool changed) -> bool;
 	private:
 		vk::CommandBuffer mCommandBuffer;
 		
 		std::shared_ptr<VulkanResourceLayout> mResourceLayout;
 		std::shared_ptr<VulkanFrameBuffer> mFrameBuffer;
 		std::shared_ptr<VulkanRenderPass> mRenderPass;
+
+		// the contents of render pass, it is null if the render pass is not began
+		std::optional<vk::SubpassContents> mRenderPassContents;
+
+		std::vector<vk::ImageMemoryBarrier> mImageBarriers;
+		std::vector<vk::BufferMemoryBarrier> mBufferBarriers;
+
+		vk::PipelineStageFlags mSrcStageMask;
+		vk::PipelineStageFlags mDstStageMask;
+
+		// the shadow state of command buffer, we use it to skip the binds that change nothing
+		vk::Pipeline mBoundGraphicsPipeline;
+		vk::Pipeline mBoundComputePipeline;
+
+		vk::PipelineLayout mBoundLayout;
+		std::vector<vk::DescriptorSet> mBoundDescriptorSets;
+
+		std::vector<std::pair<vk::Buffer, vk::DeviceSize>> mBoundVertexBuffers;
+
+		std::optional<vk::Viewport> mBoundViewPort;
+		std::optional<vk::Rect2D> mBoundScissorRect;
+
+		StateStatistics mStateStatistics;
 	};
 	
 }
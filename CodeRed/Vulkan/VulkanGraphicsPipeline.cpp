@@ -104,14 +104,18 @@ CodeRed::VulkanGraphicsPipeline::VulkanGraphicsPipeline(
 		.setRenderPass(renderPass)
 		.setSubpass(0);
 
-	mGraphicsPipeline = vkDevice.createGraphicsPipeline(nullptr, info);
+	const auto vkLogicalDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+	std::shared_lock<std::shared_mutex> lock(vkLogicalDevice->mPipelineCacheMutex);
+	
+	mGraphicsPipeline = vkDevice.createGraphicsPipeline(vkLogicalDevice->pipelineCache(), info);
 }
 
 CodeRed::VulkanGraphicsPipeline::~VulkanGraphicsPipeline()
 {
 	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
 
-	vkDevice.destroyPipeline(mGraphicsPipeline);
+	mDevice->deferDestruction([vkDevice, pipeline = mGraphicsPipeline]() { vkDevice.destroyPipeline(pipeline); });
 }
 
 #endif
@@ -11,6 +11,8 @@
 
 #include "VulkanGraphicsCommandList.hpp"
 #include "VulkanGraphicsPipeline.hpp"
+#include "VulkanComputePipeline.hpp"
+#include "VulkanGraphicsBundle.hpp"
 #include "VulkanCommandAllocator.hpp"
 #include "VulkanDisplayAdapter.hpp"
 #include "VulkanResourceLayout.hpp"
@@ -38,8 +40,7 @@ static VKAPI_ATTR VkBool32 VKAPI_CALL debugReportCallBack(
 {
 	// some messages from validation layer are ignored for DirectX12 version.
 	const static std::vector<const char*> ignoreMessages = {
-		"is being used in draw but has never been updated via vkUpdateDescriptorSets() or a similar call.",
-		"vkCreateImage(): initialLayout is VK_IMAGE_LAYOUT_GENERAL, must be VK_IMAGE_LAYOUT_UNDEFINED or VK_IMAGE_LAYOUT_PREINITIALIZED."
+		"is being used in draw but has never been updated via vkUpdateDescriptorSets() or a similar call."
 	};
 
 	// we only show the messages once for better watching
@@ -121,6 +122,77 @@ CodeRed::VulkanLogicalDevice::VulkanLogicalDevice(const std::shared_ptr<GpuDispl
 
 	initializeFeatures();
 
+	auto deviceExtensions = mDeviceExtensions;
+	
+#ifdef VK_KHR_timeline_semaphore
+	// the timeline semaphore is used by VulkanFence, if it is not supported we will use binary fences
+	vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR timelineFeatures = {};
+	
+	for (const auto& extension : mPhysicalDevice.enumerateDeviceExtensionProperties()) {
+		if (std::strcmp(extension.extensionName, VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME) != 0) continue;
+		if (mPhysicalDevice.getProperties().apiVersion < VK_API_VERSION_1_1) break;
+
+		const auto features = mPhysicalDevice.getFeatures2<
+			vk::PhysicalDeviceFeatures2,
+			vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>();
+
+		mTimelineSemaphore = features.get<vk::PhysicalDeviceTimelineSemaphoreFeaturesKHR>().timelineSemaphore == VK_TRUE;
+
+		break;
+	}
+
+	if (mTimelineSemaphore == true) {
+		timelineFeatures
+			.setPNext(nullptr)
+			.setTimelineSemaphore(true);
+
+		deviceExtensions.push_back(VK_KHR_TIMELINE_SEMAPHORE_EXTENSION_NAME);
+	}
+#endif
+
+#ifdef VK_KHR_draw_indirect_count
+	// the draw indirect count is used by drawIndirectCount and drawIndexedIndirectCount
+	for (const auto& extension : mPhysicalDevice.enumerateDeviceExtensionProperties()) {
+		if (std::strcmp(extension.extensionName, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME) != 0) continue;
+
+		mDrawIndirectCount = true;
+
+		deviceExtensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
+		break;
+	}
+#endif
+
+#ifdef VK_EXT_vertex_attribute_divisor
+	// the vertex attribute divisor is used by the per-instance elements whose step rate is not 1
+	vk::PhysicalDeviceVertexAttributeDivisorFeaturesEXT divisorFeatures = {};
+
+	for (const auto& extension : mPhysicalDevice.enumerateDeviceExtensionProperties()) {
+		if (std::strcmp(extension.extensionName, VK_EXT_VERTEX_ATTRIBUTE_DIVISOR_EXTENSION_NAME) != 0) continue;
+		if (mPhysicalDevice.getProperties().apiVersion < VK_API_VERSION_1_1) break;
+
+		const auto features = mPhysicalDevice.getFeatures2<
+			vk::PhysicalDeviceFeatures2,
+			vk::PhysicalDeviceVertexAttributeDivisorFeaturesEXT>();
+
+		mVertexAttributeDivisor = features.get<vk::PhysicalDeviceVertexAttributeDivisorFeaturesEXT>()
+			.vertexAttributeInstanceRateDivisor == VK_TRUE;
+		mVertexAttributeZeroDivisor = features.get<vk::PhysicalDeviceVertexAttributeDivisorFeaturesEXT>()
+			.vertexAttributeInstanceRateZeroDivisor == VK_TRUE;
+
+		break;
+	}
+
+	if (mVertexAttributeDivisor == true) {
+		divisorFeatures
+			.setPNext(nullptr)
+			.setVertexAttributeInstanceRateDivisor(true)
+			.setVertexAttributeInstanceRateZeroDivisor(mVertexAttributeZeroDivisor);
+
+		deviceExtensions.push_back(VK_EXT_VERTEX_ATTRIBUTE_DIVISOR_EXTENSION_NAME);
+	}
+#endif
+	
 	queueInfo
 		.setPNext(nullptr)
 		.setFlags(vk::DeviceQueueCreateFlags(0))
@@ -134,20 +206,61 @@ CodeRed::VulkanLogicalDevice::VulkanLogicalDevice(const std::shared_ptr<GpuDispl
 		.setQueueCreateInfoCount(1)
 		.setPQueueCreateInfos(&queueInfo)
 		.setEnabledLayerCount(0)
-		.setEnabledExtensionCount(static_cast<uint32_t>(mDeviceExtensions.size()))
+		.setEnabledExtensionCount(static_cast<uint32_t>(deviceExtensions.size()))
 		.setPpEnabledLayerNames(nullptr)
-		.setPpEnabledExtensionNames(mDeviceExtensions.data())
+		.setPpEnabledExtensionNames(deviceExtensions.data())
 		.setPEnabledFeatures(&mPhysicalFeatures);
+
+#ifdef VK_KHR_timeline_semaphore
+	if (mTimelineSemaphore == true) deviceInfo.setPNext(&timelineFeatures);
+#endif
+
+#ifdef VK_EXT_vertex_attribute_divisor
+	if (mVertexAttributeDivisor == true) {
+		divisorFeatures.setPNext(const_cast<void*>(deviceInfo.pNext));
+		deviceInfo.setPNext(&divisorFeatures);
+	}
+#endif
 	
 	mDevice = mPhysicalDevice.createDevice(deviceInfo);
 
-	for (const auto extension : mDeviceExtensions) {
+	mMemoryAllocator = std::make_unique<VulkanMemoryAllocator>(mPhysicalDevice, mDevice);
+
+	// start with an empty pipeline cache, we can load the data from file later
+	mPipelineCache = mDevice.createPipelineCache(vk::PipelineCacheCreateInfo());
+
+#ifdef VK_KHR_timeline_semaphore
+	if (mTimelineSemaphore == true) {
+		mDynamicLoader.vkWaitSemaphoresKHR = reinterpret_cast<PFN_vkWaitSemaphoresKHR>(
+			mDevice.getProcAddr("vkWaitSemaphoresKHR"));
+		mDynamicLoader.vkGetSemaphoreCounterValueKHR = reinterpret_cast<PFN_vkGetSemaphoreCounterValueKHR>(
+			mDevice.getProcAddr("vkGetSemaphoreCounterValueKHR"));
+	}
+#endif
+
+#ifdef VK_KHR_draw_indirect_count
+	if (mDrawIndirectCount == true) {
+		mDynamicLoader.vkCmdDrawIndirectCountKHR = reinterpret_cast<PFN_vkCmdDrawIndirectCountKHR>(
+			mDevice.getProcAddr("vkCmdDrawIndirectCountKHR"));
+		mDynamicLoader.vkCmdDrawIndexedIndirectCountKHR = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+			mDevice.getProcAddr("vkCmdDrawIndexedIndirectCountKHR"));
+	}
+#endif
+	
+	for (const auto extension : deviceExtensions) {
 		CODE_RED_DEBUG_LOG("enabled vulkan device extension : " + std::string(extension));
 	}
 }
 
 CodeRed::VulkanLogicalDevice::~VulkanLogicalDevice()
 {
+	// the queues are destroyed before device, so the deferred objects are not used by gpu
+	releaseAllDeferredObjects();
+
+	// the blocks of memory allocator must be freed before we destroy the device
+	mMemoryAllocator.reset();
+
+	mDevice.destroyPipelineCache(mPipelineCache);
 	mDevice.destroy();
 	
 	if (mEnableValidationLayer == true)
@@ -182,6 +295,12 @@ auto CodeRed::VulkanLogicalDevice::createGraphicsCommandList(
 		allocator);
 }
 
+auto CodeRed::VulkanLogicalDevice::createGraphicsBundle()
+	-> std::shared_ptr<GpuGraphicsBundle>
+{
+	return std::make_shared<VulkanGraphicsBundle>(shared_from_this());
+}
+
 auto CodeRed::VulkanLogicalDevice::createCommandQueue()
 	-> std::shared_ptr<GpuCommandQueue>
 {
@@ -219,6 +338,17 @@ auto CodeRed::VulkanLogicalDevice::createGraphicsPipeline(
 		rasterization_state);
 }
 
+auto CodeRed::VulkanLogicalDevice::createComputePipeline(
+	const std::shared_ptr<GpuResourceLayout>& resource_layout,
+	const std::shared_ptr<GpuShaderState>& compute_shader_state)
+	-> std::shared_ptr<GpuComputePipeline>
+{
+	return std::make_shared<VulkanComputePipeline>(
+		shared_from_this(),
+		resource_layout,
+		compute_shader_state);
+}
+
 auto CodeRed::VulkanLogicalDevice::createResourceLayout(
 	const std::vector<ResourceLayoutElement>& elements,
 	const std::vector<SamplerLayoutElement>& samplers,
@@ -311,6 +441,65 @@ auto CodeRed::VulkanLogicalDevice::createPipelineFactory()
 	return std::make_shared<VulkanPipelineFactory>(shared_from_this());
 }
 
+auto CodeRed::VulkanLogicalDevice::isFormatSupported(
+	const PixelFormat format,
+	const ResourceUsage usage)
+	-> bool
+{
+	if (format == PixelFormat::Unknown) return false;
+	
+	const auto properties = mPhysicalDevice.getFormatProperties(enumConvert(format));
+
+	if (enumHas(usage, ResourceUsage::VertexBuffer) &&
+		!(properties.bufferFeatures & vk::FormatFeatureFlagBits::eVertexBuffer)) return false;
+
+	if (usage == ResourceUsage::VertexBuffer) return true;
+
+	auto required = vk::FormatFeatureFlags();
+
+	if (enumHas(usage, ResourceUsage::RenderTarget)) required |= vk::FormatFeatureFlagBits::eColorAttachment;
+	if (enumHas(usage, ResourceUsage::DepthStencil)) required |= vk::FormatFeatureFlagBits::eDepthStencilAttachment;
+
+	// the render target and depth stencil need not be sampled, so we only check sampling for other textures
+	if (!required) required = vk::FormatFeatureFlagBits::eSampledImage;
+
+	return (properties.optimalTilingFeatures & required) == required;
+}
+
+auto CodeRed::VulkanLogicalDevice::pipelineCacheData() -> std::vector<Byte>
+{
+	const auto data = mDevice.getPipelineCacheData(mPipelineCache);
+
+	return std::vector<Byte>(data.begin(), data.end());
+}
+
+auto CodeRed::VulkanLogicalDevice::setPipelineCacheData(const std::vector<Byte>& data) -> bool
+{
+	// the driver checks the header of its data(vendor id, device id and uuid)
+	// and ignores the data if it is incompatible, so we can create the cache directly
+	vk::PipelineCacheCreateInfo info = {};
+
+	info
+		.setPNext(nullptr)
+		.setFlags(vk::PipelineCacheCreateFlags(0))
+		.setInitialDataSize(data.size())
+		.setPInitialData(data.data());
+
+	const auto pipelineCache = mDevice.createPipelineCache(info);
+
+	// we merge the data into the pipeline cache instead of replacing it
+	// so the pipelines that are compiling still use a valid pipeline cache
+	{
+		std::unique_lock<std::shared_mutex> lock(mPipelineCacheMutex);
+
+		mDevice.mergePipelineCaches(mPipelineCache, pipelineCache);
+	}
+	
+	mDevice.destroyPipelineCache(pipelineCache);
+
+	return true;
+}
+
 void CodeRed::VulkanLogicalDevice::initializeExtensions()
 {
 	mInstanceExtensions.push_back(VK_KHR_SURFACE_EXTENSION_NAME);
@@ -398,6 +587,8 @@ void CodeRed::VulkanLogicalDevice::initializeFeatures()
 
 auto CodeRed::VulkanLogicalDevice::allocateQueue() -> size_t
 {
+	std::lock_guard<std::mutex> lock(mQueueMutex);
+	
 	CODE_RED_THROW_IF(
 		mFreeQueues.empty(),
 		FailedException(DebugType::Get,
@@ -414,6 +605,8 @@ auto CodeRed::VulkanLogicalDevice::allocateQueue() -> size_t
 
 void CodeRed::VulkanLogicalDevice::freeQueue(const size_t index)
 {
+	std::lock_guard<std::mutex> lock(mQueueMutex);
+	
 	const auto it = std::find(mFreeQueues.begin(), mFreeQueues.end(), index);
 	
 	CODE_RED_THROW_IF(
@@ -442,6 +635,21 @@ auto CodeRed::VulkanLogicalDevice::getMemoryTypeIndex(
 	throw FailedException(DebugType::Get, { "memory type index", "memory properties" });
 }
 
+auto CodeRed::VulkanLogicalDevice::allocateMemory(
+	const vk::MemoryRequirements& requirements,
+	const vk::MemoryPropertyFlags& flags,
+	const bool linear)
+	-> VulkanMemoryAllocation
+{
+	return mMemoryAllocator->allocate(requirements,
+		getMemoryTypeIndex(requirements.memoryTypeBits, flags), linear);
+}
+
+void CodeRed::VulkanLogicalDevice::freeMemory(const VulkanMemoryAllocation& allocation)
+{
+	mMemoryAllocator->free(allocation);
+}
+
 void CodeRed::VulkanLogicalDevice::initializeInstance()
 {
 	initializeLayers();
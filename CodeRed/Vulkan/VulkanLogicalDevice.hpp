@@ -1,8 +1,11 @@
 #pragma once
 
 #include "../Interface/GpuLogicalDevice.hpp"
+#include "VulkanMemoryAllocator.hpp"
 #include "VulkanUtility.hpp"
 
+#include <shared_mutex>
+
 #ifdef __ENABLE__VULKAN__
 
 namespace CodeRed {
@@ -25,6 +28,9 @@ namespace CodeRed {
 			const std::shared_ptr<GpuCommandAllocator>& allocator)
 			->std::shared_ptr<GpuGraphicsCommandList> override;
 
+		auto createGraphicsBundle()
+			-> std::shared_ptr<GpuGraphicsBundle> override;
+
 		auto createCommandQueue()
 			->std::shared_ptr<GpuCommandQueue> override;
 
@@ -42,6 +48,11 @@ namespace CodeRed {
 			const std::shared_ptr<GpuRasterizationState>& rasterization_state)
 			->std::shared_ptr<GpuGraphicsPipeline> override;
 
+		auto createComputePipeline(
+			const std::shared_ptr<GpuResourceLayout>& resource_layout,
+			const std::shared_ptr<GpuShaderState>& compute_shader_state)
+			-> std::shared_ptr<GpuComputePipeline> override;
+
 		auto createResourceLayout(
 			const std::vector<ResourceLayoutElement>& elements = {},
 			const std::vector<SamplerLayoutElement>& samplers = {},
@@ -83,12 +94,23 @@ namespace CodeRed {
 
 		auto createPipelineFactory()
 			->std::shared_ptr<GpuPipelineFactory> override;
+
+		auto isFormatSupported(
+			const PixelFormat format,
+			const ResourceUsage usage = ResourceUsage::None)
+			-> bool override;
 		
 		auto device() const noexcept -> vk::Device { return mDevice; }
 
 		auto queueFamilyIndex() const noexcept -> size_t { return mQueueFamilyIndex; }
 
+		auto pipelineCache() const noexcept -> vk::PipelineCache { return mPipelineCache; }
+
 		static auto instance() -> vk::Instance;
+	protected:
+		auto pipelineCacheData() -> std::vector<Byte> override;
+
+		auto setPipelineCacheData(const std::vector<Byte>& data) -> bool override;
 	private:
 		static void initializeLayers();
 
@@ -111,9 +133,22 @@ namespace CodeRed {
 			const vk::MemoryPropertyFlags& flags)
 			const -> uint32_t;
 
+		auto allocateMemory(
+			const vk::MemoryRequirements& requirements,
+			const vk::MemoryPropertyFlags& flags,
+			const bool linear)
+			-> VulkanMemoryAllocation;
+
+		void freeMemory(const VulkanMemoryAllocation& allocation);
+
+		friend class VulkanGraphicsCommandList;
+		friend class VulkanInputAssemblyState;
+		friend class VulkanGraphicsPipeline;
+		friend class VulkanComputePipeline;
 		friend class VulkanTextureBuffer;
 		friend class VulkanCommandQueue;
 		friend class VulkanSwapChain;
+		friend class VulkanFence;
 		friend class VulkanTexture;
 		friend class VulkanBuffer;
 	private:
@@ -134,9 +169,23 @@ namespace CodeRed {
 		
 		vk::Device mDevice;
 
+		vk::PipelineCache mPipelineCache;
+
+		// the pipelines are created with shared lock(they may be created in worker threads)
+		// and we merge the data into pipeline cache with unique lock
+		std::shared_mutex mPipelineCacheMutex;
+
 		size_t mQueueFamilyIndex = SIZE_MAX;
+
+		bool mTimelineSemaphore = false;
+		bool mDrawIndirectCount = false;
+		bool mVertexAttributeDivisor = false;
+		bool mVertexAttributeZeroDivisor = false;
 		
 		std::vector<size_t> mFreeQueues;
+		std::mutex mQueueMutex;
+
+		std::unique_ptr<VulkanMemoryAllocator> mMemoryAllocator;
 
 	};
 	
@@ -0,0 +1,387 @@
+#include "../Shared/Exception/FailedException.hpp"
+#include "../Shared/Exception/ZeroException.hpp"
+
+#include "VulkanMemoryAllocator.hpp"
+
+#ifdef __ENABLE__VULKAN__
+
+using namespace CodeRed::Vulkan;
+
+static auto alignUp(const vk::DeviceSize value, const vk::DeviceSize alignment) -> vk::DeviceSize
+{
+	return alignment <= 1 ? value : (value + alignment - 1) / alignment * alignment;
+}
+
+CodeRed::VulkanMemoryAllocator::VulkanMemoryAllocator(
+	const vk::PhysicalDevice& physical_device,
+	const vk::Device& device) :
+	mMemoryProperties(physical_device.getMemoryProperties()),
+	mDevice(device)
+{
+	mNonCoherentAtomSize = physical_device.getProperties().limits.nonCoherentAtomSize;
+	
+	// the size of block should not be too large for small heaps
+	// so we limit it to 1/8 of the smallest heap
+	for (uint32_t index = 0; index < mMemoryProperties.memoryHeapCount; index++) {
+		const auto heapSize = mMemoryProperties.memoryHeaps[index].size;
+
+		if (heapSize / 8 < mBlockSize) mBlockSize = heapSize / 8;
+	}
+
+	mBlockSize = std::max(mBlockSize, mMaxSizeClass * mSlotsPerChunk);
+
+	mPools.resize(static_cast<size_t>(mMemoryProperties.memoryTypeCount) * 2);
+
+	for (auto& pool : mPools)
+		pool.FreeSlots.resize(sizeClassOf(mMaxSizeClass) + 1);
+}
+
+CodeRed::VulkanMemoryAllocator::~VulkanMemoryAllocator()
+{
+	for (auto& pool : mPools) {
+		for (auto& block : pool.Blocks) {
+			if (block.MappedMemory != nullptr) mDevice.unmapMemory(block.Memory);
+
+			mDevice.freeMemory(block.Memory);
+		}
+	}
+}
+
+auto CodeRed::VulkanMemoryAllocator::allocate(
+	const vk::MemoryRequirements& requirements,
+	const uint32_t type_index,
+	const bool linear)
+	-> VulkanMemoryAllocation
+{
+	CODE_RED_THROW_IF(
+		requirements.size == 0,
+		ZeroException<vk::DeviceSize>({ "requirements.size" })
+	);
+
+	// the large resources are allocated with dedicated memory
+	// because they will waste too much space of block
+	if (requirements.size > mBlockSize / 2) return allocateDedicated(requirements, type_index);
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	VulkanMemoryAllocation allocation;
+
+	allocation.TypeIndex = type_index;
+	allocation.Pool = static_cast<size_t>(type_index) * 2 + (linear ? 0 : 1);
+
+	auto& pool = mPools[allocation.Pool];
+
+	auto alignment = std::max(requirements.alignment, static_cast<vk::DeviceSize>(1));
+	auto size = requirements.size;
+
+	// the range of flush and invalidate is aligned with the nonCoherentAtomSize
+	// so we align the non-coherent allocations to avoid sharing an atom with other allocations
+	const auto propertyFlags = mMemoryProperties.memoryTypes[type_index].propertyFlags;
+
+	if ((propertyFlags & vk::MemoryPropertyFlagBits::eHostVisible) &&
+		!(propertyFlags & vk::MemoryPropertyFlagBits::eHostCoherent)) {
+		alignment = std::max(alignment, mNonCoherentAtomSize);
+		size = alignUp(size, mNonCoherentAtomSize);
+	}
+
+	// the small resources are allocated from the free list of size class
+	// the size of class is power of two and the chunk is aligned with the size of class
+	// so the slot is aligned if the alignment is not greater than the size of class
+	if (size <= mMaxSizeClass && alignment <= mMaxSizeClass) {
+		const auto sizeClass = sizeClassOf(std::max(size, alignment));
+		const auto classSize = sizeOfClass(sizeClass);
+
+		auto& freeSlots = pool.FreeSlots[sizeClass];
+
+		// when the free list is empty, we allocate a new chunk for this size class
+		if (freeSlots.empty()) {
+			size_t blockIndex = 0;
+
+			const auto chunkOffset = allocateRange(pool, type_index,
+				classSize * mSlotsPerChunk, classSize, blockIndex);
+
+			for (size_t index = mSlotsPerChunk; index > 0; index--) {
+				freeSlots.push_back({ blockIndex, chunkOffset + (index - 1) * classSize });
+			}
+		}
+
+		const auto slot = freeSlots.back();
+
+		freeSlots.pop_back();
+
+		allocation.Memory = pool.Blocks[slot.Block].Memory;
+		allocation.Offset = slot.Offset;
+		allocation.Size = classSize;
+		allocation.Block = slot.Block;
+		allocation.SizeClass = sizeClass;
+
+		return allocation;
+	}
+
+	allocation.Offset = allocateRange(pool, type_index, size, alignment, allocation.Block);
+	allocation.Memory = pool.Blocks[allocation.Block].Memory;
+	allocation.Size = size;
+
+	return allocation;
+}
+
+void CodeRed::VulkanMemoryAllocator::free(const VulkanMemoryAllocation& allocation)
+{
+	if (!allocation.Memory) return;
+
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (allocation.dedicated()) {
+		const auto it = mDedicatedMappings.find(static_cast<VkDeviceMemory>(allocation.Memory));
+
+		if (it != mDedicatedMappings.end()) {
+			mDevice.unmapMemory(allocation.Memory);
+			mDedicatedMappings.erase(it);
+		}
+
+		mDevice.freeMemory(allocation.Memory);
+
+		return;
+	}
+
+	auto& pool = mPools[allocation.Pool];
+
+	// the slot of size class is returned to the free list
+	// we do not merge them, because the resources with same size class are usually created again
+	if (allocation.SizeClass != SIZE_MAX) {
+		pool.FreeSlots[allocation.SizeClass].push_back({ allocation.Block, allocation.Offset });
+
+		return;
+	}
+
+	freeRange(pool.Blocks[allocation.Block], allocation.Offset, allocation.Size);
+}
+
+auto CodeRed::VulkanMemoryAllocator::mapMemory(const VulkanMemoryAllocation& allocation) -> void*
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// a vk::DeviceMemory can not be mapped more than once
+	// so we map the whole memory and count the references of mapping
+	if (allocation.dedicated()) {
+		auto& mapping = mDedicatedMappings[static_cast<VkDeviceMemory>(allocation.Memory)];
+
+		if (mapping.second++ == 0) mapping.first = mDevice.mapMemory(allocation.Memory, 0, VK_WHOLE_SIZE);
+
+		return mapping.first;
+	}
+
+	auto& block = mPools[allocation.Pool].Blocks[allocation.Block];
+
+	if (block.MappedCount++ == 0) block.MappedMemory = mDevice.mapMemory(block.Memory, 0, VK_WHOLE_SIZE);
+
+	return static_cast<unsigned char*>(block.MappedMemory) + allocation.Offset;
+}
+
+void CodeRed::VulkanMemoryAllocator::unmapMemory(const VulkanMemoryAllocation& allocation)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (allocation.dedicated()) {
+		const auto it = mDedicatedMappings.find(static_cast<VkDeviceMemory>(allocation.Memory));
+
+		CODE_RED_THROW_IF(
+			it == mDedicatedMappings.end(),
+			InvalidException<vk::DeviceMemory>({ "allocation.Memory" }, { "the memory is not mapped." })
+		);
+
+		if (--it->second.second == 0) {
+			mDevice.unmapMemory(allocation.Memory);
+			mDedicatedMappings.erase(it);
+		}
+
+		return;
+	}
+
+	auto& block = mPools[allocation.Pool].Blocks[allocation.Block];
+
+	CODE_RED_THROW_IF(
+		block.MappedCount == 0,
+		InvalidException<vk::DeviceMemory>({ "allocation.Memory" }, { "the memory is not mapped." })
+	);
+
+	if (--block.MappedCount == 0) {
+		mDevice.unmapMemory(block.Memory);
+		block.MappedMemory = nullptr;
+	}
+}
+
+void CodeRed::VulkanMemoryAllocator::flushMemory(
+	const VulkanMemoryAllocation& allocation,
+	const vk::DeviceSize offset,
+	const vk::DeviceSize size)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	const auto range = mappedMemoryRange(allocation, offset, size);
+
+	if (range.has_value()) mDevice.flushMappedMemoryRanges(range.value());
+}
+
+void CodeRed::VulkanMemoryAllocator::invalidateMemory(
+	const VulkanMemoryAllocation& allocation,
+	const vk::DeviceSize offset,
+	const vk::DeviceSize size)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	const auto range = mappedMemoryRange(allocation, offset, size);
+
+	if (range.has_value()) mDevice.invalidateMappedMemoryRanges(range.value());
+}
+
+auto CodeRed::VulkanMemoryAllocator::allocateDedicated(
+	const vk::MemoryRequirements& requirements,
+	const uint32_t type_index)
+	-> VulkanMemoryAllocation
+{
+	vk::MemoryAllocateInfo memoryInfo = {};
+
+	memoryInfo
+		.setPNext(nullptr)
+		.setAllocationSize(requirements.size)
+		.setMemoryTypeIndex(type_index);
+
+	VulkanMemoryAllocation allocation;
+
+	allocation.Memory = mDevice.allocateMemory(memoryInfo);
+	allocation.Offset = 0;
+	allocation.Size = requirements.size;
+	allocation.TypeIndex = type_index;
+
+	return allocation;
+}
+
+auto CodeRed::VulkanMemoryAllocator::allocateRange(
+	Pool& pool,
+	const uint32_t type_index,
+	const vk::DeviceSize size,
+	const vk::DeviceSize alignment,
+	size_t& block_index)
+	-> vk::DeviceSize
+{
+	// first fit in the free ranges of blocks
+	for (size_t index = 0; index < pool.Blocks.size(); index++) {
+		auto& freeRanges = pool.Blocks[index].FreeRanges;
+
+		for (auto it = freeRanges.begin(); it != freeRanges.end(); ++it) {
+			const auto rangeOffset = it->first;
+			const auto rangeSize = it->second;
+			const auto offset = alignUp(rangeOffset, alignment);
+
+			if (offset + size > rangeOffset + rangeSize) continue;
+
+			freeRanges.erase(it);
+
+			// the padding before the offset and the tail after the range are still free
+			if (offset > rangeOffset) freeRanges[rangeOffset] = offset - rangeOffset;
+			if (offset + size < rangeOffset + rangeSize)
+				freeRanges[offset + size] = rangeOffset + rangeSize - offset - size;
+
+			block_index = index;
+
+			return offset;
+		}
+	}
+
+	// no free range is enough, so we allocate a new block
+	vk::MemoryAllocateInfo memoryInfo = {};
+
+	memoryInfo
+		.setPNext(nullptr)
+		.setAllocationSize(mBlockSize)
+		.setMemoryTypeIndex(type_index);
+
+	Block block;
+
+	block.Memory = mDevice.allocateMemory(memoryInfo);
+	block.Size = mBlockSize;
+
+	if (size < block.Size) block.FreeRanges[size] = block.Size - size;
+
+	pool.Blocks.push_back(block);
+
+	block_index = pool.Blocks.size() - 1;
+
+	return 0;
+}
+
+void CodeRed::VulkanMemoryAllocator::freeRange(
+	Block& block,
+	const vk::DeviceSize offset,
+	const vk::DeviceSize size)
+{
+	auto rangeOffset = offset;
+	auto rangeSize = size;
+
+	auto next = block.FreeRanges.lower_bound(offset);
+
+	// merge with the next free range
+	if (next != block.FreeRanges.end() && next->first == offset + size) {
+		rangeSize = rangeSize + next->second;
+		next = block.FreeRanges.erase(next);
+	}
+
+	// merge with the previous free range
+	if (next != block.FreeRanges.begin()) {
+		const auto prev = std::prev(next);
+
+		if (prev->first + prev->second == offset) {
+			rangeOffset = prev->first;
+			rangeSize = rangeSize + prev->second;
+			block.FreeRanges.erase(prev);
+		}
+	}
+
+	block.FreeRanges[rangeOffset] = rangeSize;
+}
+
+auto CodeRed::VulkanMemoryAllocator::mappedMemoryRange(
+	const VulkanMemoryAllocation& allocation,
+	const vk::DeviceSize offset,
+	const vk::DeviceSize size)
+	-> std::optional<vk::MappedMemoryRange>
+{
+	// the host coherent memory does not need to flush or invalidate
+	if (size == 0 || (mMemoryProperties.memoryTypes[allocation.TypeIndex].propertyFlags &
+		vk::MemoryPropertyFlagBits::eHostCoherent)) return std::nullopt;
+
+	const auto memorySize = allocation.dedicated() ? allocation.Size :
+		mPools[allocation.Pool].Blocks[allocation.Block].Size;
+
+	// the offset and size of range must be multiple of nonCoherentAtomSize
+	// or the end of range is the end of memory
+	const auto begin = allocation.Offset + offset - (allocation.Offset + offset) % mNonCoherentAtomSize;
+	const auto end = alignUp(allocation.Offset + offset + size, mNonCoherentAtomSize);
+
+	vk::MappedMemoryRange range = {};
+
+	range
+		.setPNext(nullptr)
+		.setMemory(allocation.Memory)
+		.setOffset(begin)
+		.setSize(end >= memorySize ? VK_WHOLE_SIZE : end - begin);
+
+	return range;
+}
+
+auto CodeRed::VulkanMemoryAllocator::sizeClassOf(const vk::DeviceSize size) -> size_t
+{
+	size_t sizeClass = 0;
+
+	while (sizeOfClass(sizeClass) < size) sizeClass++;
+
+	return sizeClass;
+}
+
+auto CodeRed::VulkanMemoryAllocator::sizeOfClass(const size_t size_class) -> vk::DeviceSize
+{
+	return mMinSizeClass << size_class;
+}
+
+#endif
@@ -0,0 +1,146 @@
+#pragma once
+
+#include "../Shared/Noncopyable.hpp"
+#include "VulkanUtility.hpp"
+
+#ifdef __ENABLE__VULKAN__
+
+#include <optional>
+#include <mutex>
+#include <map>
+
+namespace CodeRed {
+
+	/*
+	 * a range of device memory returned by VulkanMemoryAllocator
+	 * the resource should bind its buffer or image with Memory and Offset
+	 * the other members are used by the allocator to free the range
+	 */
+	struct VulkanMemoryAllocation {
+		vk::DeviceMemory Memory = nullptr;
+		vk::DeviceSize Offset = 0;
+		vk::DeviceSize Size = 0;
+
+		uint32_t TypeIndex = 0;
+
+		size_t Pool = SIZE_MAX;
+		size_t Block = SIZE_MAX;
+		size_t SizeClass = SIZE_MAX;
+
+		VulkanMemoryAllocation() = default;
+
+		auto dedicated() const noexcept -> bool { return Block == SIZE_MAX; }
+	};
+
+	/*
+	 * VulkanMemoryAllocator is a block based sub-allocator of device memory
+	 * we allocate large blocks of vk::DeviceMemory for each memory type and sub-allocate resources in them.
+	 * small resources are allocated from the free lists of size classes (power of two),
+	 * medium resources are allocated from the free ranges of blocks
+	 * and large resources are allocated with dedicated vk::DeviceMemory.
+	 * buffers and images are allocated from different pools, so we do not need to care the bufferImageGranularity.
+	 */
+	class VulkanMemoryAllocator final : public Noncopyable {
+	public:
+		explicit VulkanMemoryAllocator(
+			const vk::PhysicalDevice& physical_device,
+			const vk::Device& device);
+
+		~VulkanMemoryAllocator();
+
+		auto allocate(
+			const vk::MemoryRequirements& requirements,
+			const uint32_t type_index,
+			const bool linear)
+			-> VulkanMemoryAllocation;
+
+		void free(const VulkanMemoryAllocation& allocation);
+
+		auto mapMemory(const VulkanMemoryAllocation& allocation) -> void*;
+
+		void unmapMemory(const VulkanMemoryAllocation& allocation);
+
+		void flushMemory(
+			const VulkanMemoryAllocation& allocation,
+			const vk::DeviceSize offset,
+			const vk::DeviceSize size);
+
+		void invalidateMemory(
+			const VulkanMemoryAllocation& allocation,
+			const vk::DeviceSize offset,
+			const vk::DeviceSize size);
+
+		auto blockSize() const noexcept -> vk::DeviceSize { return mBlockSize; }
+	private:
+		struct Block {
+			vk::DeviceMemory Memory = nullptr;
+			vk::DeviceSize Size = 0;
+
+			// free ranges of block, offset -> size
+			std::map<vk::DeviceSize, vk::DeviceSize> FreeRanges;
+
+			void* MappedMemory = nullptr;
+			size_t MappedCount = 0;
+		};
+
+		struct Slot {
+			size_t Block = 0;
+			vk::DeviceSize Offset = 0;
+		};
+
+		struct Pool {
+			std::vector<Block> Blocks;
+			std::vector<std::vector<Slot>> FreeSlots;
+		};
+
+		auto allocateDedicated(
+			const vk::MemoryRequirements& requirements,
+			const uint32_t type_index)
+			-> VulkanMemoryAllocation;
+
+		auto allocateRange(
+			Pool& pool,
+			const uint32_t type_index,
+			const vk::DeviceSize size,
+			const vk::DeviceSize alignment,
+			size_t& block_index)
+			-> vk::DeviceSize;
+
+		void freeRange(
+			Block& block,
+			const vk::DeviceSize offset,
+			const vk::DeviceSize size);
+
+		auto mappedMemoryRange(
+			const VulkanMemoryAllocation& allocation,
+			const vk::DeviceSize offset,
+			const vk::DeviceSize size)
+			-> std::optional<vk::MappedMemoryRange>;
+
+		static auto sizeClassOf(const vk::DeviceSize size) -> size_t;
+
+		static auto sizeOfClass(const size_t size_class) -> vk::DeviceSize;
+	private:
+		static constexpr vk::DeviceSize mMinSizeClass = 256;
+		static constexpr vk::DeviceSize mMaxSizeClass = 64 * 1024;
+		static constexpr vk::DeviceSize mDefaultBlockSize = 64 * 1024 * 1024;
+		static constexpr size_t mSlotsPerChunk = 32;
+
+		vk::PhysicalDeviceMemoryProperties mMemoryProperties;
+		vk::Device mDevice;
+
+		vk::DeviceSize mBlockSize = mDefaultBlockSize;
+		vk::DeviceSize mNonCoherentAtomSize = 1;
+
+		// pool index = type index * 2 + (linear ? 0 : 1)
+		std::vector<Pool> mPools;
+
+		// the mapped memory of dedicated allocations, memory -> (pointer, count)
+		std::map<VkDeviceMemory, std::pair<void*, size_t>> mDedicatedMappings;
+
+		std::mutex mMutex;
+	};
+
+}
+
+#endif
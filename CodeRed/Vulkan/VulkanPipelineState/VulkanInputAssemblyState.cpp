@@ -1,4 +1,7 @@
-#include "../../Shared/PixelFormatSizeOf.hpp"
+#include "../../Shared/Exception/NotSupportException.hpp"
+
+#include "../VulkanLogicalDevice.hpp"
+
 #include "VulkanInputAssemblyState.hpp"
 
 #ifdef __ENABLE__VULKAN__
@@ -15,25 +18,51 @@ CodeRed::VulkanInputAssemblyState::VulkanInputAssemblyState(
 	mVertexBindings = std::vector<vk::VertexInputBindingDescription>(mSlotCount);
 	
 	for (size_t index = 0; index < mElements.size(); index++) {
-		const auto slot = mElements[index].Slot;
-		
 		mVertexAttributes.push_back(
 			vk::VertexInputAttributeDescription(
 				static_cast<uint32_t>(index), 
-				static_cast<uint32_t>(slot),
+				static_cast<uint32_t>(mElements[index].Slot),
 				enumConvert(mElements[index].Format),
-				mVertexBindings[slot].stride)
+				static_cast<uint32_t>(mOffsets[index]))
+		);
+	}
+
+	for (size_t index = 0; index < mVertexBindings.size(); index++) {
+		mVertexBindings[index]
+			.setBinding(static_cast<uint32_t>(index))
+			.setStride(static_cast<uint32_t>(mStrides[index]))
+			.setInputRate(mRates[index] == InputRate::PerInstance ?
+				vk::VertexInputRate::eInstance : vk::VertexInputRate::eVertex);
+
+		if (mRates[index] != InputRate::PerInstance || mStepRates[index] == 1) continue;
+
+		// the step rate of per-instance slot is the divisor in Vulkan
+		CODE_RED_THROW_IF(
+			std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->mVertexAttributeDivisor == false,
+			NotSupportException(NotSupportType::Object)
+		);
+
+		// the step rate 0 means all instances use the first element, it needs the zero divisor feature
+		CODE_RED_THROW_IF(
+			mStepRates[index] == 0 &&
+			std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->mVertexAttributeZeroDivisor == false,
+			NotSupportException(NotSupportType::Object)
 		);
 
-		mVertexBindings[slot].stride = 
-			static_cast<uint32_t>(mVertexBindings[slot].stride + PixelFormatSizeOf::get(mElements[index].Format));
+		mVertexBindingDivisors.push_back(
+			vk::VertexInputBindingDivisorDescriptionEXT(
+				static_cast<uint32_t>(index),
+				static_cast<uint32_t>(mStepRates[index]))
+		);
 	}
 
-	for (size_t index = 0; index < mVertexBindings.size(); index++) 
-		mVertexBindings[index].binding = static_cast<uint32_t>(index);
+	mVertexDivisor
+		.setPNext(nullptr)
+		.setVertexBindingDivisorCount(static_cast<uint32_t>(mVertexBindingDivisors.size()))
+		.setPVertexBindingDivisors(mVertexBindingDivisors.empty() ? nullptr : mVertexBindingDivisors.data());
 
 	mVertexInput
-		.setPNext(nullptr)
+		.setPNext(mVertexBindingDivisors.empty() ? nullptr : &mVertexDivisor)
 		.setFlags(vk::PipelineVertexInputStateCreateFlags(0))
 		.setVertexBindingDescriptionCount(static_cast<uint32_t>(mVertexBindings.size()))
 		.setVertexAttributeDescriptionCount(static_cast<uint32_t>(mVertexAttributes.size()))
@@ -22,6 +22,9 @@ namespace CodeRed {
 	private:
 		std::vector<vk::VertexInputAttributeDescription> mVertexAttributes = {};
 		std::vector<vk::VertexInputBindingDescription> mVertexBindings = {};
+		std::vector<vk::VertexInputBindingDivisorDescriptionEXT> mVertexBindingDivisors = {};
+
+		vk::PipelineVertexInputDivisorStateCreateInfoEXT mVertexDivisor = {};
 		
 		vk::PipelineInputAssemblyStateCreateInfo mInputAssembly = {};
 		vk::PipelineVertexInputStateCreateInfo mVertexInput = {};
@@ -22,10 +22,11 @@ auto CodeRed::VulkanPipelineFactory::createInputAssemblyState(
 	const PrimitiveTopology primitive_topology)
 	-> std::shared_ptr<GpuInputAssemblyState>
 {
-	return std::make_shared<VulkanInputAssemblyState>(
-		mDevice,
-		elements,
-		primitive_topology);
+	return findOrCreate(mInputAssemblyStates,
+		inputAssemblyStateKey(elements, primitive_topology), [&]()
+		{
+			return std::make_shared<VulkanInputAssemblyState>(mDevice, elements, primitive_topology);
+		});
 }
 
 auto CodeRed::VulkanPipelineFactory::createRasterizationState(
@@ -35,12 +36,11 @@ auto CodeRed::VulkanPipelineFactory::createRasterizationState(
 	const bool depth_clamp)
 	-> std::shared_ptr<GpuRasterizationState>
 {
-	return std::make_shared<VulkanRasterizationState>(
-		mDevice,
-		front_face,
-		cull_mode,
-		fill_mode,
-		depth_clamp);
+	return findOrCreate(mRasterizationStates,
+		rasterizationStateKey(front_face, cull_mode, fill_mode, depth_clamp), [&]()
+		{
+			return std::make_shared<VulkanRasterizationState>(mDevice, front_face, cull_mode, fill_mode, depth_clamp);
+		});
 }
 
 auto CodeRed::VulkanPipelineFactory::createDetphStencilState(
@@ -52,14 +52,18 @@ auto CodeRed::VulkanPipelineFactory::createDetphStencilState(
 	const StencilOperatorInfo& back)
 	-> std::shared_ptr<GpuDepthStencilState>
 {
-	return std::make_shared<VulkanDepthStencilState>(
-		mDevice,
-		depth_enable,
-		depth_write_enable,
-		stencil_enable,
-		depth_operator,
-		front,
-		back);
+	return findOrCreate(mDepthStencilStates,
+		depthStencilStateKey(depth_enable, depth_write_enable, stencil_enable, depth_operator, front, back), [&]()
+		{
+			return std::make_shared<VulkanDepthStencilState>(
+				mDevice,
+				depth_enable,
+				depth_write_enable,
+				stencil_enable,
+				depth_operator,
+				front,
+				back);
+		});
 }
 
 auto CodeRed::VulkanPipelineFactory::createShaderState(
@@ -68,24 +72,28 @@ auto CodeRed::VulkanPipelineFactory::createShaderState(
 	const std::string& name)
 	-> std::shared_ptr<GpuShaderState>
 {
-	return std::make_shared<VulkanShaderState>(
-		mDevice,
-		type,
-		code,
-		name);
+	return findOrCreate(mShaderStates,
+		shaderStateKey(type, code, name), [&]()
+		{
+			return std::make_shared<VulkanShaderState>(mDevice, type, code, name);
+		});
 }
 
 auto CodeRed::VulkanPipelineFactory::createBlendState(
 	const std::vector<BlendProperty>& properties)
 	-> std::shared_ptr<GpuBlendState>
 {
-	return std::make_shared<VulkanBlendState>(mDevice, properties);
+	return findOrCreate(mBlendStates,
+		blendStateKey(properties), [&]()
+		{
+			return std::make_shared<VulkanBlendState>(mDevice, properties);
+		});
 }
 
 auto CodeRed::VulkanPipelineFactory::createBlendState(const size_t numRenderTargets)
 	-> std::shared_ptr<GpuBlendState>
 {
-	return std::make_shared<VulkanBlendState>(mDevice, std::vector<BlendProperty>(numRenderTargets));
+	return createBlendState(std::vector<BlendProperty>(numRenderTargets));
 }
 
 #endif
@@ -10,7 +10,6 @@ CodeRed::VulkanBuffer::VulkanBuffer(
 	const ResourceInfo& info) :
 	GpuBuffer(device, info)
 {
-	vk::MemoryAllocateInfo memoryInfo = {};
 	vk::BufferCreateInfo bufferInfo = {};
 
 	bufferInfo
@@ -28,38 +27,60 @@ CodeRed::VulkanBuffer::VulkanBuffer(
 
 	const auto memoryRequirement = vkDevice->device().getBufferMemoryRequirements(mBuffer);
 
-	memoryInfo
-		.setPNext(nullptr)
-		.setAllocationSize(memoryRequirement.size)
-		.setMemoryTypeIndex(
-			vkDevice->getMemoryTypeIndex(memoryRequirement.memoryTypeBits,
-			enumConvert(mInfo.Heap)));
+	mMemory = vkDevice->allocateMemory(memoryRequirement, enumConvert(mInfo.Heap), true);
 
-	mMemory = vkDevice->device().allocateMemory(memoryInfo);
+	vkDevice->device().bindBufferMemory(mBuffer, mMemory.Memory, mMemory.Offset);
 
-	vkDevice->device().bindBufferMemory(mBuffer, mMemory, 0);
+	// the buffer in upload or readback heap is mapped persistently
+	// so we do not need to map it when we update or read it every frame
+	if (mInfo.Heap != MemoryHeap::Default) mMappedMemory = vkDevice->mMemoryAllocator->mapMemory(mMemory);
 }
 
 CodeRed::VulkanBuffer::~VulkanBuffer()
 {
-	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
 
-	vkDevice.freeMemory(mMemory);
-	vkDevice.destroyBuffer(mBuffer);
+	if (mMappedMemory != nullptr) vkDevice->mMemoryAllocator->unmapMemory(mMemory);
+
+	// the buffer may be used by the submissions in flight, so we destroy it after they are finished
+	vkDevice->deferDestruction([device = vkDevice.get(), buffer = mBuffer, memory = mMemory]()
+		{
+			device->device().destroyBuffer(buffer);
+			device->freeMemory(memory);
+		});
 }
 
 auto CodeRed::VulkanBuffer::mapMemory() const -> void* 
 {
-	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
+	if (mMappedMemory != nullptr) return mMappedMemory;
+	
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
 
-	return vkDevice.mapMemory(mMemory, 0, VK_WHOLE_SIZE);
+	return vkDevice->mMemoryAllocator->mapMemory(mMemory);
 }
 
 void CodeRed::VulkanBuffer::unmapMemory() const
 {
-	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
+	// the persistently mapped memory is unmapped when we destroy the buffer
+	if (mMappedMemory != nullptr) return;
+	
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+	vkDevice->mMemoryAllocator->unmapMemory(mMemory);
+}
+
+void CodeRed::VulkanBuffer::flush(const size_t offset, const size_t size) const
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+	vkDevice->mMemoryAllocator->flushMemory(mMemory, offset, size);
+}
+
+void CodeRed::VulkanBuffer::invalidate(const size_t offset, const size_t size) const
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
 
-	vkDevice.unmapMemory(mMemory);
+	vkDevice->mMemoryAllocator->invalidateMemory(mMemory, offset, size);
 }
 
 #endif
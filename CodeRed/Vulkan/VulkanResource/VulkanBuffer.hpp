@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../Interface/GpuResource/GpuBuffer.hpp"
+#include "../VulkanMemoryAllocator.hpp"
 #include "../VulkanUtility.hpp"
 
 #ifdef __ENABLE__VULKAN__
@@ -18,10 +19,14 @@ namespace CodeRed {
 		auto mapMemory() const -> void* override;
 
 		void unmapMemory() const override;
+
+		void flush(const size_t offset, const size_t size) const override;
+
+		void invalidate(const size_t offset, const size_t size) const override;
 		
 		auto buffer() const noexcept -> vk::Buffer { return mBuffer; }
 	private:
-		vk::DeviceMemory mMemory;
+		VulkanMemoryAllocation mMemory;
 		vk::Buffer mBuffer;
 	};
 	
@@ -14,7 +14,6 @@ CodeRed::VulkanTexture::VulkanTexture(
 	const ResourceInfo& info) :
 	GpuTexture(device, info)
 {
-	vk::MemoryAllocateInfo memoryInfo = {};
 	vk::ImageCreateInfo imageInfo = {};
 
 	const auto property = std::get<TextureProperty>(mInfo.Property);
@@ -39,7 +38,11 @@ CodeRed::VulkanTexture::VulkanTexture(
 		 */
 		.setArrayLayers(static_cast<uint32_t>(property.Dimension == Dimension::Dimension3D ? 1 : property.Depth))
 		.setSamples(enumConvert(property.Sample))
-		.setInitialLayout(enumConvert(mInfo.Layout))
+		/*
+		 * the initial layout of image must be undefined or preinitialized
+		 * so the image is undefined until the first layout transition of sub-texture
+		 */
+		.setInitialLayout(vk::ImageLayout::eUndefined)
 		.setUsage(enumConvert(mInfo.Usage).second)
 		.setQueueFamilyIndexCount(0)
 		.setPQueueFamilyIndices(nullptr)
@@ -56,16 +59,11 @@ CodeRed::VulkanTexture::VulkanTexture(
 	mPhysicalSize = memoryRequirement.size;
 	mAlignment = memoryRequirement.alignment;
 	
-	memoryInfo
-		.setPNext(nullptr)
-		.setAllocationSize(mPhysicalSize)
-		.setMemoryTypeIndex(
-			vkDevice->getMemoryTypeIndex(memoryRequirement.memoryTypeBits,
-				enumConvert(mInfo.Heap)));
+	mMemory = vkDevice->allocateMemory(memoryRequirement, enumConvert(mInfo.Heap), false);
 
-	mMemory = vkDevice->device().allocateMemory(memoryInfo);
+	vkDevice->device().bindImageMemory(mImage, mMemory.Memory, mMemory.Offset);
 
-	vkDevice->device().bindImageMemory(mImage, mMemory, 0);
+	mUndefinedLayouts = std::vector<bool>(mipLevels() * arrays(), true);
 }
 
 CodeRed::VulkanTexture::VulkanTexture(
@@ -73,25 +71,29 @@ CodeRed::VulkanTexture::VulkanTexture(
 	const ResourceInfo& info,
 	const vk::Image image) :
 	GpuTexture(device, info),
-	mMemory(nullptr),
 	mImage(image)
 {
 	//this ctor version is used for swapchain
 	//we use this ctor to create GpuTexture in swap chain.
 	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
 	const auto property = std::get<TextureProperty>(mInfo.Property);
+
+	mUndefinedLayouts = std::vector<bool>(mipLevels() * arrays(), true);
 }
 
 CodeRed::VulkanTexture::~VulkanTexture()
 {
-	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
 
 	//vulkan texture for swapchain
 	//so we do not need to destroy memory and image
 	//we will do this when we destroy the swapchain
-	if (mMemory) {
-		vkDevice.freeMemory(mMemory);
-		vkDevice.destroyImage(mImage);
+	if (mMemory.Memory) {
+		vkDevice->deferDestruction([device = vkDevice.get(), image = mImage, memory = mMemory]()
+			{
+				device->device().destroyImage(image);
+				device->freeMemory(memory);
+			});
 	}
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../Interface/GpuResource/GpuTexture.hpp"
+#include "../VulkanMemoryAllocator.hpp"
 #include "../VulkanUtility.hpp"
 
 #ifdef __ENABLE__VULKAN__
@@ -24,8 +25,14 @@ namespace CodeRed {
 		
 		auto image() const noexcept -> vk::Image { return mImage; }
 	private:
-		vk::DeviceMemory mMemory;
+		friend class VulkanGraphicsCommandList;
+		
+		VulkanMemoryAllocation mMemory;
 		vk::Image mImage;
+
+		// the sub-textures are undefined before their first layout transition
+		// the index is same as index(mipSlice, arraySlice)
+		std::vector<bool> mUndefinedLayouts;
 	};
 	
 }
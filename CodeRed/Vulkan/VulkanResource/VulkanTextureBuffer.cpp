@@ -11,7 +11,6 @@ CodeRed::VulkanTextureBuffer::VulkanTextureBuffer(
 	const std::shared_ptr<GpuLogicalDevice>& device,
 	const TextureBufferInfo& info) : GpuTextureBuffer(device, info)
 {
-	vk::MemoryAllocateInfo memoryInfo = {};
 	vk::BufferCreateInfo bufferInfo = {};
 
 	bufferInfo
@@ -29,16 +28,12 @@ CodeRed::VulkanTextureBuffer::VulkanTextureBuffer(
 
 	const auto memoryRequirement = vkDevice->device().getBufferMemoryRequirements(mBuffer);
 
-	memoryInfo
-		.setPNext(nullptr)
-		.setAllocationSize(memoryRequirement.size)
-		.setMemoryTypeIndex(
-			vkDevice->getMemoryTypeIndex(memoryRequirement.memoryTypeBits,
-				enumConvert(MemoryHeap::Upload)));
+	mMemory = vkDevice->allocateMemory(memoryRequirement, enumConvert(MemoryHeap::Upload), true);
 
-	mMemory = vkDevice->device().allocateMemory(memoryInfo);
+	vkDevice->device().bindBufferMemory(mBuffer, mMemory.Memory, mMemory.Offset);
 
-	vkDevice->device().bindBufferMemory(mBuffer, mMemory, 0);
+	// the texture buffer is always in upload heap, so we map it persistently
+	mMappedMemory = vkDevice->mMemoryAllocator->mapMemory(mMemory);
 }
 
 CodeRed::VulkanTextureBuffer::VulkanTextureBuffer(
@@ -56,30 +51,40 @@ CodeRed::VulkanTextureBuffer::VulkanTextureBuffer(
 
 CodeRed::VulkanTextureBuffer::~VulkanTextureBuffer()
 {
-	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+	vkDevice->mMemoryAllocator->unmapMemory(mMemory);
 
-	vkDevice.freeMemory(mMemory);
-	vkDevice.destroyBuffer(mBuffer);
+	vkDevice->deferDestruction([device = vkDevice.get(), buffer = mBuffer, memory = mMemory]()
+		{
+			device->device().destroyBuffer(buffer);
+			device->freeMemory(memory);
+		});
 }
 
 auto CodeRed::VulkanTextureBuffer::read(const Extent3D<size_t>& extent) const -> std::vector<Byte>
 {
-	const auto rowPitch = mInfo.Width * PixelFormatSizeOf::get(mInfo.Format);
-	const auto depthPitch = rowPitch * mInfo.Height;
-	const auto widthOffset = extent.Left * PixelFormatSizeOf::get(mInfo.Format);
+	// if the format is compressed, we copy the rows of 4x4 blocks, so the extent should be aligned to blocks
+	const auto blockSize = PixelFormatSizeOf::blockSize(mInfo.Format);
+	const auto rowPitch = PixelFormatSizeOf::rowPitch(mInfo.Format, mInfo.Width);
+	const auto depthPitch = rowPitch * PixelFormatSizeOf::rowCount(mInfo.Format, mInfo.Height);
+	const auto widthOffset = PixelFormatSizeOf::rowPitch(mInfo.Format, extent.Left);
 	
-	std::vector<Byte> data(extent.width() * extent.height() * extent.depth() * PixelFormatSizeOf::get(mInfo.Format));
+	std::vector<Byte> data(PixelFormatSizeOf::size(mInfo.Format, extent.width(), extent.height(), extent.depth()));
+
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
 
-	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
+	// the memory may be written by gpu, so we need invalidate it before we read
+	vkDevice->mMemoryAllocator->invalidateMemory(mMemory, 0, mInfo.Size);
 
-	const auto buffer = vkDevice.mapMemory(mMemory, 0, VK_WHOLE_SIZE);
+	const auto buffer = mMappedMemory;
 
-	const auto dataLength = extent.width() * PixelFormatSizeOf::get(mInfo.Format);
+	const auto dataLength = PixelFormatSizeOf::rowPitch(mInfo.Format, extent.width());
 	
 	size_t dstOffset = 0;
 
 	for (auto z = extent.Front; z < extent.Back; z++) {
-		for (auto y = extent.Top; y < extent.Bottom; y++) {
+		for (auto y = extent.Top / blockSize; y < (extent.Bottom + blockSize - 1) / blockSize; y++) {
 			const auto srcOffset = z * depthPitch + y * rowPitch + widthOffset;
 
 			std::memcpy(data.data() + dstOffset, static_cast<unsigned char*>(buffer) + srcOffset, dataLength);
@@ -88,8 +93,6 @@ auto CodeRed::VulkanTextureBuffer::read(const Extent3D<size_t>& extent) const ->
 		}
 	}
 
-	vkDevice.unmapMemory(mMemory);
-	
 	return data;
 }
 
@@ -97,32 +100,35 @@ auto CodeRed::VulkanTextureBuffer::read() const -> std::vector<Byte>
 {
 	std::vector<Byte> data(mInfo.Size);
 	
-	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
-	const auto buffer = vkDevice.mapMemory(mMemory, 0, VK_WHOLE_SIZE);
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
 
-	std::memcpy(data.data(), buffer, mInfo.Size);
+	// the memory may be written by gpu, so we need invalidate it before we read
+	vkDevice->mMemoryAllocator->invalidateMemory(mMemory, 0, mInfo.Size);
 
-	vkDevice.unmapMemory(mMemory);
+	const auto buffer = mMappedMemory;
+
+	std::memcpy(data.data(), buffer, mInfo.Size);
 
 	return data;
 }
 
 void CodeRed::VulkanTextureBuffer::write(const Extent3D<size_t>& extent, const void* data)
 {
-	const auto rowPitch = mInfo.Width * PixelFormatSizeOf::get(mInfo.Format);
-	const auto depthPitch = rowPitch * mInfo.Height;
-	const auto widthOffset = extent.Left * PixelFormatSizeOf::get(mInfo.Format);
+	const auto blockSize = PixelFormatSizeOf::blockSize(mInfo.Format);
+	const auto rowPitch = PixelFormatSizeOf::rowPitch(mInfo.Format, mInfo.Width);
+	const auto depthPitch = rowPitch * PixelFormatSizeOf::rowCount(mInfo.Format, mInfo.Height);
+	const auto widthOffset = PixelFormatSizeOf::rowPitch(mInfo.Format, extent.Left);
 
-	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
 
-	const auto buffer = vkDevice.mapMemory(mMemory, 0, VK_WHOLE_SIZE);
+	const auto buffer = mMappedMemory;
 
-	const auto dataLength = extent.width() * PixelFormatSizeOf::get(mInfo.Format);
+	const auto dataLength = PixelFormatSizeOf::rowPitch(mInfo.Format, extent.width());
 
 	size_t srcOffset = 0;
 
 	for (auto z = extent.Front; z < extent.Back; z++) {
-		for (auto y = extent.Top; y < extent.Bottom; y++) {
+		for (auto y = extent.Top / blockSize; y < (extent.Bottom + blockSize - 1) / blockSize; y++) {
 			const auto dstOffset = z * depthPitch + y * rowPitch + widthOffset;
 
 			std::memcpy(
@@ -133,17 +139,24 @@ void CodeRed::VulkanTextureBuffer::write(const Extent3D<size_t>& extent, const v
 		}
 	}
 
-	vkDevice.unmapMemory(mMemory);
+	vkDevice->mMemoryAllocator->flushMemory(mMemory, 0, mInfo.Size);
 }
 
 void CodeRed::VulkanTextureBuffer::write(const void* data)
 {
-	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice)->device();
-	const auto buffer = vkDevice.mapMemory(mMemory, 0, VK_WHOLE_SIZE);
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+	const auto buffer = mMappedMemory;
 
 	std::memcpy(buffer, data, mInfo.Size);
 	
-	vkDevice.unmapMemory(mMemory);
+	vkDevice->mMemoryAllocator->flushMemory(mMemory, 0, mInfo.Size);
+}
+
+void CodeRed::VulkanTextureBuffer::flush() const
+{
+	const auto vkDevice = std::static_pointer_cast<VulkanLogicalDevice>(mDevice);
+
+	vkDevice->mMemoryAllocator->flushMemory(mMemory, 0, mInfo.Size);
 }
 
 #endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "../../Interface/GpuResource/GpuTextureBuffer.hpp"
+#include "../VulkanMemoryAllocator.hpp"
 #include "../VulkanUtility.hpp"
 
 #ifdef __ENABLE__VULKAN__
@@ -27,10 +28,12 @@ namespace CodeRed {
 		void write(const Extent3D<size_t>& extent, const void* data) override;
 
 		void write(const void* data) override;
+
+		void flush() const override;
 		
 		auto buffer() const noexcept -> vk::Buffer { return mBuffer; }
 	private:
-		vk::DeviceMemory mMemory;
+		VulkanMemoryAllocation mMemory;
 		vk::Buffer mBuffer;
 	};
 	
@@ -105,12 +105,16 @@ void CodeRed::VulkanSwapChain::present()
 		.setPWaitSemaphores(&mSemaphore)
 		.setPResults(nullptr);
 
-	const auto vkQueue = std::static_pointer_cast<VulkanCommandQueue>(mQueue)->queue();
+	const auto vkQueue = std::static_pointer_cast<VulkanCommandQueue>(mQueue);
 
-	CODE_RED_THROW_IF(
-		vkQueue.presentKHR(info) != vk::Result::eSuccess,
-		Exception("present failed.")
-	);
+	{
+		std::lock_guard<std::mutex> lock(vkQueue->mMutex);
+		
+		CODE_RED_THROW_IF(
+			vkQueue->queue().presentKHR(info) != vk::Result::eSuccess,
+			Exception("present failed.")
+		);
+	}
 
 	updateCurrentFrameIndex();
 }
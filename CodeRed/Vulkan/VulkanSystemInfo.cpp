@@ -29,11 +29,13 @@ auto CodeRed::VulkanSystemInfo::selectDisplayAdapter() const
 		CODE_RED_DEBUG_LOG("device name  : " + std::string(properties.deviceName));
 		CODE_RED_DEBUG_LOG("device id    : " + std::to_string(properties.deviceID));
 		CODE_RED_DEBUG_LOG("vendor id    : " + std::to_string(properties.vendorID));
+		CODE_RED_DEBUG_LOG("driver       : " + std::to_string(properties.driverVersion));
 		CODE_RED_DEBUG_LOG("");
 		
 		displayAdapters.push_back(
 			std::make_shared<VulkanDisplayAdapter>(
-				physicalDevice, properties.deviceName, properties.deviceID, properties.vendorID));
+				physicalDevice, properties.deviceName, properties.deviceID, properties.vendorID,
+				properties.driverVersion));
 	}
 
 	return displayAdapters;
@@ -12,6 +12,7 @@
 #include "../Shared/Enum/FilterOptions.hpp"
 #include "../Shared/Enum/ResourceUsage.hpp"
 #include "../Shared/Enum/BlendOperator.hpp"
+#include "../Shared/Enum/BlitFilter.hpp"
 #include "../Shared/Enum/ResourceType.hpp"
 #include "../Shared/Enum/PixelFormat.hpp"
 #include "../Shared/Enum/MultiSample.hpp"
@@ -58,6 +59,17 @@ auto CodeRed::Vulkan::enumConvert(const FilterOptions filter)
 		vk::SamplerMipmapMode::eNearest;
 }
 
+auto CodeRed::Vulkan::enumConvert(const BlitFilter filter)
+	-> vk::Filter
+{
+	switch (filter) {
+	case BlitFilter::Point: return vk::Filter::eNearest;
+	case BlitFilter::Linear: return vk::Filter::eLinear;
+	default:
+		throw NotSupportException(NotSupportType::Enum);
+	}
+}
+
 auto CodeRed::Vulkan::enumConvert(const AddressMode mode)
 	-> vk::SamplerAddressMode
 {
@@ -112,6 +124,7 @@ auto CodeRed::Vulkan::enumConvert(const ResourceLayout layout)
 {
 	switch (layout) {
 	case ResourceLayout::GeneralRead: return vk::ImageLayout::eGeneral;
+	case ResourceLayout::GeneralReadWrite: return vk::ImageLayout::eGeneral;
 	case ResourceLayout::RenderTarget: return vk::ImageLayout::eColorAttachmentOptimal;
 	case ResourceLayout::DepthStencil: return vk::ImageLayout::eDepthStencilAttachmentOptimal;
 	case ResourceLayout::CopyDestination: return vk::ImageLayout::eTransferDstOptimal;
@@ -137,7 +150,9 @@ auto CodeRed::Vulkan::enumConvert(const ResourceUsage usage)
 		ResourceUsage::IndexBuffer | ResourceUsage::RenderTarget,
 		ResourceUsage::IndexBuffer | ResourceUsage::DepthStencil,
 		ResourceUsage::ConstantBuffer | ResourceUsage::RenderTarget,
-		ResourceUsage::ConstantBuffer | ResourceUsage::DepthStencil
+		ResourceUsage::ConstantBuffer | ResourceUsage::DepthStencil,
+		ResourceUsage::IndirectBuffer | ResourceUsage::RenderTarget,
+		ResourceUsage::IndirectBuffer | ResourceUsage::DepthStencil
 	};
 
 	//if usage has this mask we disable, we will throw a InvalidException with nullptr
@@ -153,7 +168,8 @@ auto CodeRed::Vulkan::enumConvert(const ResourceUsage usage)
 		ResourceUsage::IndexBuffer,
 		ResourceUsage::ConstantBuffer,
 		ResourceUsage::RenderTarget,
-		ResourceUsage::DepthStencil
+		ResourceUsage::DepthStencil,
+		ResourceUsage::IndirectBuffer
 	};
 
 	static std::vector<VulkanResourceUsage> targetPool = {
@@ -162,7 +178,8 @@ auto CodeRed::Vulkan::enumConvert(const ResourceUsage usage)
 		VulkanResourceUsage(vk::BufferUsageFlagBits::eIndexBuffer, 0),
 		VulkanResourceUsage(vk::BufferUsageFlagBits::eUniformBuffer | vk::BufferUsageFlagBits::eStorageBuffer, 0),
 		VulkanResourceUsage(0, vk::ImageUsageFlagBits::eColorAttachment),
-		VulkanResourceUsage(0, vk::ImageUsageFlagBits::eDepthStencilAttachment)
+		VulkanResourceUsage(0, vk::ImageUsageFlagBits::eDepthStencilAttachment),
+		VulkanResourceUsage(vk::BufferUsageFlagBits::eIndirectBuffer, 0)
 	};
 
 	auto res = VulkanResourceUsage(0, 0);
@@ -187,6 +204,9 @@ auto CodeRed::Vulkan::enumConvert(const MemoryHeap heap)
 	case MemoryHeap::Default: return vk::MemoryPropertyFlagBits::eDeviceLocal;
 	case MemoryHeap::Upload: return vk::MemoryPropertyFlagBits::eHostVisible | 
 		vk::MemoryPropertyFlagBits::eHostCoherent;
+	// the host cached memory is not supported by every device, so we use the same memory as upload heap
+	case MemoryHeap::Readback: return vk::MemoryPropertyFlagBits::eHostVisible |
+		vk::MemoryPropertyFlagBits::eHostCoherent;
 	default:
 		throw NotSupportException(NotSupportType::Enum);
 	}
@@ -204,6 +224,30 @@ auto CodeRed::Vulkan::enumConvert(const PixelFormat format)
 	case PixelFormat::Depth32BitFloat: return vk::Format::eD32Sfloat;
 	case PixelFormat::Red8BitUnknown: return vk::Format::eR8Unorm;
 	case PixelFormat::Red32BitFloat: return vk::Format::eR32Sfloat;
+	case PixelFormat::Red16BitFloat: return vk::Format::eR16Sfloat;
+	case PixelFormat::RedGreen16BitFloat: return vk::Format::eR16G16Sfloat;
+	case PixelFormat::RedGreenBlueAlpha16BitFloat: return vk::Format::eR16G16B16A16Sfloat;
+	case PixelFormat::Red16BitUnknown: return vk::Format::eR16Unorm;
+	case PixelFormat::RedGreen16BitUnknown: return vk::Format::eR16G16Unorm;
+	case PixelFormat::RedGreenBlueAlpha16BitUnknown: return vk::Format::eR16G16B16A16Unorm;
+	case PixelFormat::RedGreen16BitSignedUnknown: return vk::Format::eR16G16Snorm;
+	case PixelFormat::RedGreenBlueAlpha16BitSignedUnknown: return vk::Format::eR16G16B16A16Snorm;
+	case PixelFormat::RedGreen8BitUnknown: return vk::Format::eR8G8Unorm;
+	case PixelFormat::RedGreenBlueAlpha8BitSignedUnknown: return vk::Format::eR8G8B8A8Snorm;
+	case PixelFormat::RedGreenBlueAlpha8BitSRGB: return vk::Format::eR8G8B8A8Srgb;
+	case PixelFormat::BlueGreenRedAlpha8BitSRGB: return vk::Format::eB8G8R8A8Srgb;
+	case PixelFormat::RedGreenBlue10BitAlpha2BitUnknown: return vk::Format::eA2B10G10R10UnormPack32;
+	case PixelFormat::RedGreen11BitBlue10BitFloat: return vk::Format::eB10G11R11UfloatPack32;
+	case PixelFormat::Depth16BitUnknown: return vk::Format::eD16Unorm;
+	case PixelFormat::Depth24BitStencil8Bit: return vk::Format::eD24UnormS8Uint;
+	case PixelFormat::BlockCompressed1Unknown: return vk::Format::eBc1RgbaUnormBlock;
+	case PixelFormat::BlockCompressed1SRGB: return vk::Format::eBc1RgbaSrgbBlock;
+	case PixelFormat::BlockCompressed3Unknown: return vk::Format::eBc3UnormBlock;
+	case PixelFormat::BlockCompressed3SRGB: return vk::Format::eBc3SrgbBlock;
+	case PixelFormat::BlockCompressed4Unknown: return vk::Format::eBc4UnormBlock;
+	case PixelFormat::BlockCompressed5Unknown: return vk::Format::eBc5UnormBlock;
+	case PixelFormat::BlockCompressed7Unknown: return vk::Format::eBc7UnormBlock;
+	case PixelFormat::BlockCompressed7SRGB: return vk::Format::eBc7SrgbBlock;
 	case PixelFormat::Unknown: return vk::Format::eUndefined;
 	default:
 		throw NotSupportException(NotSupportType::Enum);
@@ -377,6 +421,7 @@ auto CodeRed::Vulkan::enumConvert(const ShaderType type)
 	switch (type) {
 	case ShaderType::Vertex: return vk::ShaderStageFlagBits::eVertex;
 	case ShaderType::Pixel: return vk::ShaderStageFlagBits::eFragment;
+	case ShaderType::Compute: return vk::ShaderStageFlagBits::eCompute;
 	default:
 		throw NotSupportException(NotSupportType::Enum);
 	}
@@ -464,14 +509,16 @@ auto CodeRed::Vulkan::enumConvert1(
 	case ResourceLayout::GeneralRead:
 		switch (type) {
 		case ResourceType::Buffer:
-			return vk::AccessFlagBits::eUniformRead | vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eVertexAttributeRead;
+			return vk::AccessFlagBits::eUniformRead | vk::AccessFlagBits::eIndexRead | vk::AccessFlagBits::eVertexAttributeRead |
+				vk::AccessFlagBits::eIndirectCommandRead;
 		case ResourceType::Texture:
 			return vk::AccessFlagBits::eShaderRead;
 		case ResourceType::GroupBuffer:
-			return vk::AccessFlagBits::eUniformRead;
+			return vk::AccessFlagBits::eUniformRead | vk::AccessFlagBits::eIndirectCommandRead;
 		default:
 			throw NotSupportException(NotSupportType::Enum);
 		}
+	case ResourceLayout::GeneralReadWrite: return vk::AccessFlagBits::eShaderRead | vk::AccessFlagBits::eShaderWrite;
 	case ResourceLayout::RenderTarget: return vk::AccessFlagBits::eColorAttachmentWrite;
 	case ResourceLayout::DepthStencil:
 		return vk::AccessFlagBits::eDepthStencilAttachmentRead | vk::AccessFlagBits::eDepthStencilAttachmentWrite;
@@ -483,4 +530,38 @@ auto CodeRed::Vulkan::enumConvert1(
 	}
 }
 
+auto CodeRed::Vulkan::enumConvert2(
+	const ResourceLayout layout, 
+	const ResourceType type)
+	-> vk::PipelineStageFlags
+{
+	const auto shaderStages =
+		vk::PipelineStageFlagBits::eVertexShader |
+		vk::PipelineStageFlagBits::eFragmentShader |
+		vk::PipelineStageFlagBits::eComputeShader;
+	
+	switch (layout) {
+	case ResourceLayout::GeneralRead:
+		switch (type) {
+		case ResourceType::Buffer:
+			return shaderStages | vk::PipelineStageFlagBits::eVertexInput | vk::PipelineStageFlagBits::eDrawIndirect;
+		case ResourceType::Texture:
+			return shaderStages;
+		case ResourceType::GroupBuffer:
+			return shaderStages | vk::PipelineStageFlagBits::eDrawIndirect;
+		default:
+			throw NotSupportException(NotSupportType::Enum);
+		}
+	case ResourceLayout::GeneralReadWrite: return shaderStages;
+	case ResourceLayout::RenderTarget: return vk::PipelineStageFlagBits::eColorAttachmentOutput;
+	case ResourceLayout::DepthStencil:
+		return vk::PipelineStageFlagBits::eEarlyFragmentTests | vk::PipelineStageFlagBits::eLateFragmentTests;
+	case ResourceLayout::CopyDestination: return vk::PipelineStageFlagBits::eTransfer;
+	case ResourceLayout::CopySource: return vk::PipelineStageFlagBits::eTransfer;
+	case ResourceLayout::Present: return vk::PipelineStageFlagBits::eColorAttachmentOutput;
+	default:
+		throw NotSupportException(NotSupportType::Enum);
+	}
+}
+
 #endif
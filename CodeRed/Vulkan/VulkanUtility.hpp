@@ -28,6 +28,7 @@ namespace CodeRed {
 	enum class AttachmentLoad : UInt32;
 	enum class FilterOptions : UInt32;
 	enum class BlendOperator : UInt32;
+	enum class BlitFilter : UInt32;
 	enum class ResourceUsage : UInt32;
 	enum class ResourceType : UInt32;
 	enum class PixelFormat : UInt32;
@@ -52,6 +53,8 @@ namespace CodeRed {
 
 		auto enumConvert(const FilterOptions filter)->vk::SamplerMipmapMode;
 
+		auto enumConvert(const BlitFilter filter)->vk::Filter;
+
 		auto enumConvert(const AddressMode mode)->vk::SamplerAddressMode;
 
 		auto enumConvert(const BorderColor color)->vk::BorderColor;
@@ -108,6 +111,8 @@ namespace CodeRed {
 
 		auto enumConvert1(const ResourceLayout layout, const ResourceType type)->vk::AccessFlags;
 
+		auto enumConvert2(const ResourceLayout layout, const ResourceType type)->vk::PipelineStageFlags;
+
 	}
 }
 
@@ -13,12 +13,20 @@ using Microsoft::WRL::ComPtr;
 
 auto to_shader_kind(const CodeRed::ShaderType& type) noexcept -> shaderc_shader_kind
 {
-	return type == CodeRed::ShaderType::Vertex ? shaderc_vertex_shader : shaderc_fragment_shader;
+	switch (type) {
+	case CodeRed::ShaderType::Vertex: return shaderc_vertex_shader;
+	case CodeRed::ShaderType::Compute: return shaderc_compute_shader;
+	default: return shaderc_fragment_shader;
+	}
 }
 
 auto to_shader_model(const CodeRed::ShaderType& type) noexcept -> const wchar_t* 
 {
-	return type == CodeRed::ShaderType::Vertex ? L"vs_6_0" : L"ps_6_0";
+	switch (type) {
+	case CodeRed::ShaderType::Vertex: return L"vs_6_0";
+	case CodeRed::ShaderType::Compute: return L"cs_6_0";
+	default: return L"ps_6_0";
+	}
 }
 
 template<typename Result>
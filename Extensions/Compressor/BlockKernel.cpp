@@ -0,0 +1,311 @@
+#include "BlockKernel.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define __ENABLE__COMPRESSOR__SIMD__
+#endif
+
+#ifdef __ENABLE__COMPRESSOR__SIMD__
+
+#include <immintrin.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#define COMPRESSOR_TARGET_SSE41
+#define COMPRESSOR_TARGET_AVX2
+#else
+#define COMPRESSOR_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define COMPRESSOR_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#endif
+
+using namespace CodeRed::Compressor;
+using CodeRed::Byte;
+
+static void scalarBounds(const Byte* block, Byte* min, Byte* max)
+{
+	for (size_t channel = 0; channel < 4; channel++) {
+		min[channel] = 255;
+		max[channel] = 0;
+	}
+
+	for (size_t index = 0; index < 16; index++) {
+		for (size_t channel = 0; channel < 4; channel++) {
+			min[channel] = std::min(min[channel], block[index * 4 + channel]);
+			max[channel] = std::max(max[channel], block[index * 4 + channel]);
+		}
+	}
+}
+
+static void scalarColorIndices(const Byte* block, const Byte* palette, Byte* indices)
+{
+	for (size_t index = 0; index < 16; index++) {
+		const auto pixel = block + index * 4;
+
+		int best = INT32_MAX;
+
+		for (size_t color = 0; color < 4; color++) {
+			const auto distance =
+				std::abs(pixel[0] - palette[color * 4 + 0]) +
+				std::abs(pixel[1] - palette[color * 4 + 1]) +
+				std::abs(pixel[2] - palette[color * 4 + 2]);
+
+			if (distance < best) {
+				best = distance;
+				indices[index] = static_cast<Byte>(color);
+			}
+		}
+	}
+}
+
+static void scalarChannelIndices(const Byte* block, const size_t channel, const Byte* palette, Byte* indices)
+{
+	for (size_t index = 0; index < 16; index++) {
+		const auto value = block[index * 4 + channel];
+
+		int best = INT32_MAX;
+
+		for (size_t entry = 0; entry < 8; entry++) {
+			const auto distance = std::abs(value - palette[entry]);
+
+			if (distance < best) {
+				best = distance;
+				indices[index] = static_cast<Byte>(entry);
+			}
+		}
+	}
+}
+
+#ifdef __ENABLE__COMPRESSOR__SIMD__
+
+COMPRESSOR_TARGET_SSE41 static void sse41ReduceBounds(__m128i min, __m128i max, Byte* out_min, Byte* out_max)
+{
+	// reduce the four pixels of register to one pixel
+	min = _mm_min_epu8(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(1, 0, 3, 2)));
+	min = _mm_min_epu8(min, _mm_shuffle_epi32(min, _MM_SHUFFLE(2, 3, 0, 1)));
+	max = _mm_max_epu8(max, _mm_shuffle_epi32(max, _MM_SHUFFLE(1, 0, 3, 2)));
+	max = _mm_max_epu8(max, _mm_shuffle_epi32(max, _MM_SHUFFLE(2, 3, 0, 1)));
+
+	const auto packedMin = static_cast<unsigned>(_mm_cvtsi128_si32(min));
+	const auto packedMax = static_cast<unsigned>(_mm_cvtsi128_si32(max));
+
+	for (size_t channel = 0; channel < 4; channel++) {
+		out_min[channel] = static_cast<Byte>(packedMin >> (channel * 8));
+		out_max[channel] = static_cast<Byte>(packedMax >> (channel * 8));
+	}
+}
+
+COMPRESSOR_TARGET_SSE41 static void sse41Bounds(const Byte* block, Byte* min, Byte* max)
+{
+	const auto row0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 0));
+	const auto row1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16));
+	const auto row2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 32));
+	const auto row3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 48));
+
+	sse41ReduceBounds(
+		_mm_min_epu8(_mm_min_epu8(row0, row1), _mm_min_epu8(row2, row3)),
+		_mm_max_epu8(_mm_max_epu8(row0, row1), _mm_max_epu8(row2, row3)),
+		min, max);
+}
+
+COMPRESSOR_TARGET_SSE41 static void sse41ColorIndices(const Byte* block, const Byte* palette, Byte* indices)
+{
+	const auto colorMask = _mm_set1_epi32(0x00FFFFFF);
+	const auto ones8 = _mm_set1_epi8(1);
+	const auto ones16 = _mm_set1_epi16(1);
+
+	__m128i pixels[4];
+	__m128i best[4];
+	__m128i result[4];
+
+	for (size_t row = 0; row < 4; row++) {
+		pixels[row] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + row * 16));
+		best[row] = _mm_set1_epi32(INT32_MAX);
+		result[row] = _mm_setzero_si128();
+	}
+
+	for (int color = 0; color < 4; color++) {
+		int packed = 0;
+
+		std::memcpy(&packed, palette + color * 4, 4);
+
+		const auto entry = _mm_set1_epi32(packed);
+		const auto index = _mm_set1_epi32(color);
+
+		for (size_t row = 0; row < 4; row++) {
+			// |a - b| of unsigned bytes, then sum the r, g and b of each pixel
+			const auto difference = _mm_and_si128(colorMask,
+				_mm_sub_epi8(_mm_max_epu8(pixels[row], entry), _mm_min_epu8(pixels[row], entry)));
+			const auto distance = _mm_madd_epi16(_mm_maddubs_epi16(difference, ones8), ones16);
+			const auto less = _mm_cmplt_epi32(distance, best[row]);
+
+			best[row] = _mm_min_epi32(distance, best[row]);
+			result[row] = _mm_blendv_epi8(result[row], index, less);
+		}
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(indices), _mm_packus_epi16(
+		_mm_packs_epi32(result[0], result[1]),
+		_mm_packs_epi32(result[2], result[3])));
+}
+
+COMPRESSOR_TARGET_SSE41 static void sse41ChannelIndices(const Byte* block, const size_t channel, const Byte* palette, Byte* indices)
+{
+	const auto shift = _mm_cvtsi32_si128(static_cast<int>(channel * 8));
+	const auto mask = _mm_set1_epi32(0xFF);
+
+	__m128i rows[4];
+
+	for (size_t row = 0; row < 4; row++) {
+		rows[row] = _mm_and_si128(mask, _mm_srl_epi32(
+			_mm_loadu_si128(reinterpret_cast<const __m128i*>(block + row * 16)), shift));
+	}
+
+	// the 16 values of channel in one register
+	const auto values = _mm_packus_epi16(
+		_mm_packus_epi32(rows[0], rows[1]),
+		_mm_packus_epi32(rows[2], rows[3]));
+
+	auto best = _mm_set1_epi8(-1);
+	auto result = _mm_setzero_si128();
+
+	for (int entry = 0; entry < 8; entry++) {
+		const auto value = _mm_set1_epi8(static_cast<char>(palette[entry]));
+		const auto distance = _mm_sub_epi8(_mm_max_epu8(values, value), _mm_min_epu8(values, value));
+
+		// distance < best, the bytes are unsigned so we use min and cmpeq
+		const auto lessEqual = _mm_cmpeq_epi8(_mm_min_epu8(distance, best), distance);
+		const auto less = _mm_andnot_si128(_mm_cmpeq_epi8(distance, best), lessEqual);
+
+		best = _mm_min_epu8(distance, best);
+		result = _mm_blendv_epi8(result, _mm_set1_epi8(static_cast<char>(entry)), less);
+	}
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(indices), result);
+}
+
+COMPRESSOR_TARGET_AVX2 static void avx2Bounds(const Byte* block, Byte* min, Byte* max)
+{
+	const auto half0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 0));
+	const auto half1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + 32));
+
+	const auto min256 = _mm256_min_epu8(half0, half1);
+	const auto max256 = _mm256_max_epu8(half0, half1);
+
+	auto min128 = _mm_min_epu8(_mm256_castsi256_si128(min256), _mm256_extracti128_si256(min256, 1));
+	auto max128 = _mm_max_epu8(_mm256_castsi256_si128(max256), _mm256_extracti128_si256(max256, 1));
+
+	min128 = _mm_min_epu8(min128, _mm_shuffle_epi32(min128, _MM_SHUFFLE(1, 0, 3, 2)));
+	min128 = _mm_min_epu8(min128, _mm_shuffle_epi32(min128, _MM_SHUFFLE(2, 3, 0, 1)));
+	max128 = _mm_max_epu8(max128, _mm_shuffle_epi32(max128, _MM_SHUFFLE(1, 0, 3, 2)));
+	max128 = _mm_max_epu8(max128, _mm_shuffle_epi32(max128, _MM_SHUFFLE(2, 3, 0, 1)));
+
+	const auto packedMin = static_cast<unsigned>(_mm_cvtsi128_si32(min128));
+	const auto packedMax = static_cast<unsigned>(_mm_cvtsi128_si32(max128));
+
+	for (size_t channel = 0; channel < 4; channel++) {
+		min[channel] = static_cast<Byte>(packedMin >> (channel * 8));
+		max[channel] = static_cast<Byte>(packedMax >> (channel * 8));
+	}
+}
+
+COMPRESSOR_TARGET_AVX2 static void avx2ColorIndices(const Byte* block, const Byte* palette, Byte* indices)
+{
+	const auto colorMask = _mm256_set1_epi32(0x00FFFFFF);
+	const auto ones8 = _mm256_set1_epi8(1);
+	const auto ones16 = _mm256_set1_epi16(1);
+
+	__m256i pixels[2];
+	__m256i best[2];
+	__m256i result[2];
+
+	for (size_t half = 0; half < 2; half++) {
+		pixels[half] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + half * 32));
+		best[half] = _mm256_set1_epi32(INT32_MAX);
+		result[half] = _mm256_setzero_si256();
+	}
+
+	for (int color = 0; color < 4; color++) {
+		int packed = 0;
+
+		std::memcpy(&packed, palette + color * 4, 4);
+
+		const auto entry = _mm256_set1_epi32(packed);
+		const auto index = _mm256_set1_epi32(color);
+
+		for (size_t half = 0; half < 2; half++) {
+			const auto difference = _mm256_and_si256(colorMask,
+				_mm256_sub_epi8(_mm256_max_epu8(pixels[half], entry), _mm256_min_epu8(pixels[half], entry)));
+			const auto distance = _mm256_madd_epi16(_mm256_maddubs_epi16(difference, ones8), ones16);
+			const auto less = _mm256_cmpgt_epi32(best[half], distance);
+
+			best[half] = _mm256_min_epi32(distance, best[half]);
+			result[half] = _mm256_blendv_epi8(result[half], index, less);
+		}
+	}
+
+	// the pack instructions work in 128 bits lanes, so we need permute the dwords to the order of pixels
+	const auto packed = _mm256_packus_epi16(_mm256_packs_epi32(result[0], result[1]), _mm256_setzero_si256());
+	const auto ordered = _mm256_permutevar8x32_epi32(packed, _mm256_setr_epi32(0, 4, 1, 5, 2, 3, 6, 7));
+
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(indices), _mm256_castsi256_si128(ordered));
+}
+
+#endif
+
+auto CodeRed::Compressor::detectInstructionSet() noexcept -> InstructionSet
+{
+#ifdef __ENABLE__COMPRESSOR__SIMD__
+#ifdef _MSC_VER
+	int info[4] = { 0, 0, 0, 0 };
+
+	__cpuid(info, 0);
+
+	const auto maxLeaf = info[0];
+
+	__cpuid(info, 1);
+
+	const auto sse41 = (info[2] & (1 << 19)) != 0;
+	const auto osxsave = (info[2] & (1 << 27)) != 0;
+	const auto avx = (info[2] & (1 << 28)) != 0;
+
+	auto avx2 = false;
+
+	// the os needs save the ymm registers, so we check the xcr0 before we use avx2
+	if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+		__cpuidex(info, 7, 0);
+
+		avx2 = (info[1] & (1 << 5)) != 0;
+	}
+#else
+	const auto sse41 = __builtin_cpu_supports("sse4.1") != 0;
+	const auto avx2 = __builtin_cpu_supports("avx2") != 0;
+#endif
+
+	if (avx2) return InstructionSet::eAVX2;
+	if (sse41) return InstructionSet::eSSE41;
+#endif
+
+	return InstructionSet::eScalar;
+}
+
+auto CodeRed::Compressor::selectBlockKernel(const InstructionSet instruction) noexcept -> BlockKernel
+{
+#ifdef __ENABLE__COMPRESSOR__SIMD__
+	const auto supported = detectInstructionSet();
+	const auto selected = static_cast<unsigned>(instruction) < static_cast<unsigned>(supported) ? instruction : supported;
+
+	switch (selected) {
+	case InstructionSet::eAVX2: return { avx2Bounds, avx2ColorIndices, sse41ChannelIndices };
+	case InstructionSet::eSSE41: return { sse41Bounds, sse41ColorIndices, sse41ChannelIndices };
+	default: break;
+	}
+#endif
+
+	return { scalarBounds, scalarColorIndices, scalarChannelIndices };
+}
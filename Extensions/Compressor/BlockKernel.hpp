@@ -0,0 +1,32 @@
+#pragma once
+
+#include <CodeRed/Shared/Utility.hpp>
+
+#include "InstructionSet.hpp"
+
+#include <cstddef>
+
+namespace CodeRed {
+
+	namespace Compressor {
+
+		/*
+		 * the kernels of 4x4 block, a block is 16 RGBA8 pixels(64 bytes)
+		 * Bounds : compute the min and max value of each channel
+		 * ColorIndices : select the nearest color of palette(4 RGBA8 colors, alpha is ignored) for each pixel
+		 * ChannelIndices : select the nearest value of palette(8 values) for the channel of each pixel
+		 * all kernels choose the smallest index if there are same distances,
+		 * so the SIMD kernels output the same blocks as the scalar kernels
+		 */
+		struct BlockKernel {
+			void (*Bounds)(const Byte* block, Byte* min, Byte* max);
+			void (*ColorIndices)(const Byte* block, const Byte* palette, Byte* indices);
+			void (*ChannelIndices)(const Byte* block, const size_t channel, const Byte* palette, Byte* indices);
+		};
+
+		auto detectInstructionSet() noexcept -> InstructionSet;
+
+		auto selectBlockKernel(const InstructionSet instruction) noexcept -> BlockKernel;
+	}
+	
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <CodeRed/Shared/Enum/PixelFormat.hpp>
+
+#include "InstructionSet.hpp"
+
+#include <cstddef>
+
+namespace CodeRed {
+
+	namespace Compressor {
+
+		/*
+		 * Format : the block compressed format we want to encode, only BC1, BC3, BC4 and BC5 are supported
+		 * Instruction : the highest instruction set we can use, we will fall back if the cpu does not support it
+		 * Threads : the number of threads we use to encode the blocks, 0 means std::thread::hardware_concurrency
+		 */
+		struct CompressOption {
+			PixelFormat Format = PixelFormat::BlockCompressed1Unknown;
+
+			InstructionSet Instruction = InstructionSet::eAVX2;
+
+			size_t Threads = 0;
+
+			CompressOption() = default;
+
+			CompressOption(
+				const PixelFormat& format,
+				const InstructionSet& instruction = InstructionSet::eAVX2,
+				const size_t threads = 0) :
+				Format(format), Instruction(instruction), Threads(threads) {}
+		};
+	}
+	
+}
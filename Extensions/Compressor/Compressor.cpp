@@ -0,0 +1,528 @@
+#include "Compressor.hpp"
+#include "BlockKernel.hpp"
+
+#include <CodeRed/Interface/GpuResource/GpuTextureBuffer.hpp>
+#include <CodeRed/Shared/Exception/NotSupportException.hpp>
+#include <CodeRed/Shared/Exception/InvalidException.hpp>
+#include <CodeRed/Shared/Exception/ZeroException.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <thread>
+#include <limits>
+#include <cmath>
+
+using namespace CodeRed::Compressor;
+using CodeRed::PixelFormat;
+using CodeRed::Byte;
+
+static auto to565(const int red, const int green, const int blue) -> unsigned
+{
+	return
+		static_cast<unsigned>((red * 31 + 127) / 255) << 11 |
+		static_cast<unsigned>((green * 63 + 127) / 255) << 5 |
+		static_cast<unsigned>((blue * 31 + 127) / 255);
+}
+
+static void expand565(const unsigned color, Byte* rgba)
+{
+	const auto red = (color >> 11) & 31;
+	const auto green = (color >> 5) & 63;
+	const auto blue = color & 31;
+
+	rgba[0] = static_cast<Byte>((red << 3) | (red >> 2));
+	rgba[1] = static_cast<Byte>((green << 2) | (green >> 4));
+	rgba[2] = static_cast<Byte>((blue << 3) | (blue >> 2));
+	rgba[3] = 255;
+}
+
+static void writeBits(Byte* destination, const unsigned long long bits, const size_t bytes)
+{
+	for (size_t index = 0; index < bytes; index++)
+		destination[index] = static_cast<Byte>(bits >> (index * 8));
+}
+
+static void loadBlock(
+	const Byte* source,
+	const size_t width,
+	const size_t height,
+	const size_t x,
+	const size_t y,
+	Byte* block)
+{
+	// the full block can be copied by rows, the edge block repeats the edge pixels
+	if (x + 4 <= width && y + 4 <= height) {
+		for (size_t row = 0; row < 4; row++)
+			std::memcpy(block + row * 16, source + ((y + row) * width + x) * 4, 16);
+
+		return;
+	}
+
+	for (size_t row = 0; row < 4; row++) {
+		for (size_t column = 0; column < 4; column++) {
+			const auto sourceX = std::min(x + column, width - 1);
+			const auto sourceY = std::min(y + row, height - 1);
+
+			std::memcpy(block + (row * 4 + column) * 4, source + (sourceY * width + sourceX) * 4, 4);
+		}
+	}
+}
+
+static void encodeColorBlock(
+	const BlockKernel& kernel,
+	const Byte* block,
+	const Byte* min,
+	const Byte* max,
+	Byte* destination)
+{
+	int low[3] = { min[0], min[1], min[2] };
+	int high[3] = { max[0], max[1], max[2] };
+
+	// the bounding box has four diagonals, we use the covariance of red-green and blue-green to choose one
+	auto covarianceRG = 0;
+	auto covarianceBG = 0;
+
+	for (size_t index = 0; index < 16; index++) {
+		const auto green = 2 * block[index * 4 + 1] - (low[1] + high[1]);
+
+		covarianceRG += (2 * block[index * 4 + 0] - (low[0] + high[0])) * green;
+		covarianceBG += (2 * block[index * 4 + 2] - (low[2] + high[2])) * green;
+	}
+
+	if (covarianceRG < 0) std::swap(low[0], high[0]);
+	if (covarianceBG < 0) std::swap(low[2], high[2]);
+
+	// inset the endpoints by 1/16 of the range to reduce the error of the interpolated colors
+	for (size_t channel = 0; channel < 3; channel++) {
+		const auto inset = (high[channel] - low[channel]) / 16;
+
+		low[channel] = low[channel] + inset;
+		high[channel] = high[channel] - inset;
+	}
+
+	auto color0 = to565(high[0], high[1], high[2]);
+	auto color1 = to565(low[0], low[1], low[2]);
+
+	// color0 > color1 means the 4 colors mode
+	if (color0 < color1) std::swap(color0, color1);
+
+	unsigned indexBits = 0;
+
+	if (color0 != color1) {
+		Byte palette[16];
+		Byte indices[16];
+
+		expand565(color0, palette + 0);
+		expand565(color1, palette + 4);
+
+		for (size_t channel = 0; channel < 4; channel++) {
+			palette[8 + channel] = static_cast<Byte>((2 * palette[channel] + palette[4 + channel] + 1) / 3);
+			palette[12 + channel] = static_cast<Byte>((palette[channel] + 2 * palette[4 + channel] + 1) / 3);
+		}
+
+		kernel.ColorIndices(block, palette, indices);
+
+		for (size_t index = 0; index < 16; index++)
+			indexBits |= static_cast<unsigned>(indices[index]) << (index * 2);
+	}
+
+	writeBits(destination + 0, color0, 2);
+	writeBits(destination + 2, color1, 2);
+	writeBits(destination + 4, indexBits, 4);
+}
+
+static void encodeChannelBlock(
+	const BlockKernel& kernel,
+	const Byte* block,
+	const size_t channel,
+	const Byte min,
+	const Byte max,
+	Byte* destination)
+{
+	unsigned long long indexBits = 0;
+
+	// value0 > value1 means the 8 values mode
+	if (max != min) {
+		Byte palette[8] = { max, min };
+		Byte indices[16];
+
+		for (int index = 1; index < 7; index++)
+			palette[index + 1] = static_cast<Byte>(((7 - index) * max + index * min + 3) / 7);
+
+		kernel.ChannelIndices(block, channel, palette, indices);
+
+		for (size_t index = 0; index < 16; index++)
+			indexBits |= static_cast<unsigned long long>(indices[index]) << (index * 3);
+	}
+
+	destination[0] = max;
+	destination[1] = min;
+
+	writeBits(destination + 2, indexBits, 6);
+}
+
+static void encodeBlock(
+	const BlockKernel& kernel,
+	const PixelFormat format,
+	const Byte* block,
+	Byte* destination)
+{
+	Byte min[4];
+	Byte max[4];
+
+	kernel.Bounds(block, min, max);
+
+	switch (format) {
+	case PixelFormat::BlockCompressed1Unknown:
+	case PixelFormat::BlockCompressed1SRGB:
+		encodeColorBlock(kernel, block, min, max, destination);
+		break;
+	case PixelFormat::BlockCompressed3Unknown:
+	case PixelFormat::BlockCompressed3SRGB:
+		encodeChannelBlock(kernel, block, 3, min[3], max[3], destination);
+		encodeColorBlock(kernel, block, min, max, destination + 8);
+		break;
+	case PixelFormat::BlockCompressed4Unknown:
+		encodeChannelBlock(kernel, block, 0, min[0], max[0], destination);
+		break;
+	case PixelFormat::BlockCompressed5Unknown:
+		encodeChannelBlock(kernel, block, 0, min[0], max[0], destination);
+		encodeChannelBlock(kernel, block, 1, min[1], max[1], destination + 8);
+		break;
+	default:
+		throw CodeRed::NotSupportException(CodeRed::NotSupportType::Enum);
+	}
+}
+
+static void decodeColorBlock(const Byte* source, const bool opaque, Byte* pixels)
+{
+	const auto color0 = static_cast<unsigned>(source[0] | source[1] << 8);
+	const auto color1 = static_cast<unsigned>(source[2] | source[3] << 8);
+
+	Byte palette[16];
+
+	expand565(color0, palette + 0);
+	expand565(color1, palette + 4);
+
+	// BC3 always uses the 4 colors mode, BC1 uses the 3 colors mode if color0 <= color1
+	for (size_t channel = 0; channel < 4; channel++) {
+		if (opaque || color0 > color1) {
+			palette[8 + channel] = static_cast<Byte>((2 * palette[channel] + palette[4 + channel] + 1) / 3);
+			palette[12 + channel] = static_cast<Byte>((palette[channel] + 2 * palette[4 + channel] + 1) / 3);
+		}
+		else {
+			palette[8 + channel] = static_cast<Byte>((palette[channel] + palette[4 + channel] + 1) / 2);
+			palette[12 + channel] = 0;
+		}
+	}
+
+	for (size_t index = 0; index < 16; index++) {
+		const auto entry = (source[4 + index / 4] >> ((index % 4) * 2)) & 3;
+
+		std::memcpy(pixels + index * 4, palette + entry * 4, 3);
+
+		pixels[index * 4 + 3] = palette[entry * 4 + 3];
+	}
+}
+
+static void decodeChannelBlock(const Byte* source, const size_t channel, Byte* pixels)
+{
+	const int value0 = source[0];
+	const int value1 = source[1];
+
+	Byte palette[8] = { source[0], source[1] };
+
+	if (value0 > value1) {
+		for (int index = 1; index < 7; index++)
+			palette[index + 1] = static_cast<Byte>(((7 - index) * value0 + index * value1 + 3) / 7);
+	}
+	else {
+		for (int index = 1; index < 5; index++)
+			palette[index + 1] = static_cast<Byte>(((5 - index) * value0 + index * value1 + 2) / 5);
+
+		palette[6] = 0;
+		palette[7] = 255;
+	}
+
+	unsigned long long indexBits = 0;
+
+	for (size_t index = 0; index < 6; index++)
+		indexBits |= static_cast<unsigned long long>(source[2 + index]) << (index * 8);
+
+	for (size_t index = 0; index < 16; index++)
+		pixels[index * 4 + channel] = palette[(indexBits >> (index * 3)) & 7];
+}
+
+auto CodeRed::Compressor::supportedInstructionSet() -> InstructionSet
+{
+	return detectInstructionSet();
+}
+
+auto CodeRed::Compressor::isSupported(const PixelFormat format) noexcept -> bool
+{
+	switch (format) {
+	case PixelFormat::BlockCompressed1Unknown:
+	case PixelFormat::BlockCompressed1SRGB:
+	case PixelFormat::BlockCompressed3Unknown:
+	case PixelFormat::BlockCompressed3SRGB:
+	case PixelFormat::BlockCompressed4Unknown:
+	case PixelFormat::BlockCompressed5Unknown:
+		return true;
+	default:
+		return false;
+	}
+}
+
+auto CodeRed::Compressor::blockSize(const PixelFormat format) -> size_t
+{
+	switch (format) {
+	case PixelFormat::BlockCompressed1Unknown:
+	case PixelFormat::BlockCompressed1SRGB:
+	case PixelFormat::BlockCompressed4Unknown:
+		return 8;
+	case PixelFormat::BlockCompressed3Unknown:
+	case PixelFormat::BlockCompressed3SRGB:
+	case PixelFormat::BlockCompressed5Unknown:
+		return 16;
+	default:
+		throw NotSupportException(NotSupportType::Enum);
+	}
+}
+
+auto CodeRed::Compressor::rowPitch(const PixelFormat format, const size_t width) -> size_t
+{
+	return ((width + 3) / 4) * blockSize(format);
+}
+
+void CodeRed::Compressor::compress(
+	const void* source,
+	const size_t width,
+	const size_t height,
+	void* destination,
+	const size_t row_pitch,
+	const CompressOption& option)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		source == nullptr || destination == nullptr,
+		ZeroException<void*>({ "source or destination" })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		width == 0 || height == 0,
+		ZeroException<size_t>({ "width or height" })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		row_pitch < rowPitch(option.Format, width),
+		InvalidException<size_t>({ "row_pitch" },
+			{ "row_pitch is less than the size of a row of blocks." })
+	);
+
+	if (!isSupported(option.Format)) throw NotSupportException(NotSupportType::Enum);
+
+	// the empty image has no block to encode, and we can not split zero rows to threads
+	if (width == 0 || height == 0) return;
+
+	const auto kernel = selectBlockKernel(option.Instruction);
+	const auto size = blockSize(option.Format);
+
+	const auto blocksX = (width + 3) / 4;
+	const auto blocksY = (height + 3) / 4;
+
+	const auto sourceBytes = static_cast<const Byte*>(source);
+	const auto destinationBytes = static_cast<Byte*>(destination);
+
+	const auto encodeRows = [&](const size_t begin, const size_t end)
+	{
+		Byte block[64];
+
+		for (size_t y = begin; y < end; y++) {
+			const auto row = destinationBytes + y * row_pitch;
+
+			for (size_t x = 0; x < blocksX; x++) {
+				loadBlock(sourceBytes, width, height, x * 4, y * 4, block);
+				encodeBlock(kernel, option.Format, block, row + x * size);
+			}
+		}
+	};
+
+	// the rows of blocks are independent, so we split them to threads
+	// the last range is encoded by current thread
+	const auto hardwareThreads = static_cast<size_t>(std::max(1u, std::thread::hardware_concurrency()));
+	const auto threadCount = std::min(option.Threads == 0 ? hardwareThreads : option.Threads, blocksY);
+	const auto rowsPerThread = (blocksY + threadCount - 1) / threadCount;
+
+	std::vector<std::thread> threads;
+
+	for (size_t begin = 0; begin + rowsPerThread < blocksY; begin += rowsPerThread)
+		threads.emplace_back(encodeRows, begin, begin + rowsPerThread);
+
+	encodeRows(threads.size() * rowsPerThread, blocksY);
+
+	for (auto& thread : threads) thread.join();
+}
+
+auto CodeRed::Compressor::compress(
+	const void* source,
+	const size_t width,
+	const size_t height,
+	const CompressOption& option)
+	-> std::vector<Byte>
+{
+	const auto pitch = rowPitch(option.Format, width);
+
+	auto result = std::vector<Byte>(pitch * ((height + 3) / 4));
+
+	compress(source, width, height, result.data(), pitch, option);
+
+	return result;
+}
+
+void CodeRed::Compressor::compress(
+	const std::shared_ptr<GpuTextureBuffer>& buffer,
+	const void* source,
+	const CompressOption& option)
+{
+	CODE_RED_DEBUG_THROW_IF(
+		buffer == nullptr,
+		ZeroException<GpuTextureBuffer>({ "buffer" })
+	);
+
+	CODE_RED_DEBUG_THROW_IF(
+		buffer->depth() != 1,
+		InvalidException<GpuTextureBuffer>({ "buffer" },
+			{ "the depth of texture buffer should be 1." })
+	);
+
+	auto bufferOption = option;
+
+	bufferOption.Format = buffer->format();
+
+	// the blocks are tightly packed in the data of texture buffer
+	// if the texture buffer is mapped(Vulkan), we encode the blocks into it without copying them
+	if (buffer->mappedMemory() != nullptr) {
+		compress(source, buffer->width(), buffer->height(), buffer->mappedMemory(),
+			rowPitch(bufferOption.Format, buffer->width()), bufferOption);
+
+		buffer->flush();
+
+		return;
+	}
+
+	buffer->write(compress(source, buffer->width(), buffer->height(), bufferOption));
+}
+
+auto CodeRed::Compressor::decompress(
+	const void* source,
+	const size_t width,
+	const size_t height,
+	const PixelFormat format)
+	-> std::vector<Byte>
+{
+	const auto size = blockSize(format);
+
+	const auto blocksX = (width + 3) / 4;
+	const auto blocksY = (height + 3) / 4;
+
+	const auto sourceBytes = static_cast<const Byte*>(source);
+
+	auto result = std::vector<Byte>(width * height * 4);
+
+	for (size_t y = 0; y < blocksY; y++) {
+		for (size_t x = 0; x < blocksX; x++) {
+			const auto blockSource = sourceBytes + (y * blocksX + x) * size;
+
+			Byte pixels[64];
+
+			// the channels that are not stored in format are 0, alpha is 255
+			for (size_t index = 0; index < 16; index++) {
+				pixels[index * 4 + 0] = 0;
+				pixels[index * 4 + 1] = 0;
+				pixels[index * 4 + 2] = 0;
+				pixels[index * 4 + 3] = 255;
+			}
+
+			switch (format) {
+			case PixelFormat::BlockCompressed1Unknown:
+			case PixelFormat::BlockCompressed1SRGB:
+				decodeColorBlock(blockSource, false, pixels);
+				break;
+			case PixelFormat::BlockCompressed3Unknown:
+			case PixelFormat::BlockCompressed3SRGB:
+				decodeColorBlock(blockSource + 8, true, pixels);
+				decodeChannelBlock(blockSource, 3, pixels);
+				break;
+			case PixelFormat::BlockCompressed4Unknown:
+				decodeChannelBlock(blockSource, 0, pixels);
+				break;
+			case PixelFormat::BlockCompressed5Unknown:
+				decodeChannelBlock(blockSource, 0, pixels);
+				decodeChannelBlock(blockSource + 8, 1, pixels);
+				break;
+			default:
+				throw NotSupportException(NotSupportType::Enum);
+			}
+
+			for (size_t row = 0; row < 4 && y * 4 + row < height; row++) {
+				const auto columns = std::min(static_cast<size_t>(4), width - x * 4);
+
+				std::memcpy(
+					result.data() + ((y * 4 + row) * width + x * 4) * 4,
+					pixels + row * 16, columns * 4);
+			}
+		}
+	}
+
+	return result;
+}
+
+auto CodeRed::Compressor::computePSNR(
+	const void* reference,
+	const void* image,
+	const size_t width,
+	const size_t height,
+	const PixelFormat format)
+	-> double
+{
+	size_t channels = 0;
+
+	switch (format) {
+	case PixelFormat::BlockCompressed1Unknown:
+	case PixelFormat::BlockCompressed1SRGB:
+		channels = 3;
+		break;
+	case PixelFormat::BlockCompressed3Unknown:
+	case PixelFormat::BlockCompressed3SRGB:
+		channels = 4;
+		break;
+	case PixelFormat::BlockCompressed4Unknown:
+		channels = 1;
+		break;
+	case PixelFormat::BlockCompressed5Unknown:
+		channels = 2;
+		break;
+	default:
+		throw NotSupportException(NotSupportType::Enum);
+	}
+
+	const auto referenceBytes = static_cast<const Byte*>(reference);
+	const auto imageBytes = static_cast<const Byte*>(image);
+
+	double error = 0;
+
+	for (size_t index = 0; index < width * height; index++) {
+		for (size_t channel = 0; channel < channels; channel++) {
+			const auto difference =
+				static_cast<double>(referenceBytes[index * 4 + channel]) -
+				static_cast<double>(imageBytes[index * 4 + channel]);
+
+			error += difference * difference;
+		}
+	}
+
+	const auto mse = error / static_cast<double>(width * height * channels);
+
+	if (mse == 0) return std::numeric_limits<double>::infinity();
+
+	return 10.0 * std::log10(255.0 * 255.0 / mse);
+}
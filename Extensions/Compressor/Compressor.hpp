@@ -0,0 +1,82 @@
+#pragma once
+
+#include <CodeRed/Shared/Utility.hpp>
+
+#include "CompressOption.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace CodeRed {
+
+	class GpuTextureBuffer;
+	
+	namespace Compressor {
+
+		/*
+		 * the source image is RGBA8 and tightly packed(the row pitch is width * 4)
+		 * the edge blocks of the image that is not multiple of 4 will repeat the edge pixels
+		 * BC1 is always encoded as opaque(4 colors mode), BC4 uses the red channel and BC5 uses the red and green channel
+		 */
+		
+		auto supportedInstructionSet() -> InstructionSet;
+
+		auto isSupported(const PixelFormat format) noexcept -> bool;
+
+		auto blockSize(const PixelFormat format) -> size_t;
+
+		auto rowPitch(const PixelFormat format, const size_t width) -> size_t;
+
+		/*
+		 * encode the image to destination, the destination can be the mapped memory of upload buffer
+		 * row_pitch is the size of a row of blocks in destination, it should not be less than rowPitch(format, width)
+		 */
+		void compress(
+			const void* source,
+			const size_t width,
+			const size_t height,
+			void* destination,
+			const size_t row_pitch,
+			const CompressOption& option);
+
+		auto compress(
+			const void* source,
+			const size_t width,
+			const size_t height,
+			const CompressOption& option)
+			-> std::vector<Byte>;
+
+		/*
+		 * encode the image with the format and size of texture buffer and write it to the buffer
+		 * if the memory of texture buffer is mapped(Vulkan), we encode the image into it directly
+		 * the Format of option will be ignored
+		 */
+		void compress(
+			const std::shared_ptr<GpuTextureBuffer>& buffer,
+			const void* source,
+			const CompressOption& option = CompressOption());
+
+		/*
+		 * decode the blocks to RGBA8 image, it is used to measure the quality of encoder
+		 */
+		auto decompress(
+			const void* source,
+			const size_t width,
+			const size_t height,
+			const PixelFormat format)
+			-> std::vector<Byte>;
+
+		/*
+		 * compute the PSNR(dB) between two RGBA8 images with the channels stored in format
+		 * BC1 uses RGB, BC3 uses RGBA, BC4 uses R and BC5 uses RG
+		 */
+		auto computePSNR(
+			const void* reference,
+			const void* image,
+			const size_t width,
+			const size_t height,
+			const PixelFormat format)
+			-> double;
+	}
+	
+}
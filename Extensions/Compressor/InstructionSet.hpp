@@ -0,0 +1,19 @@
+#pragma once
+
+namespace CodeRed {
+
+	namespace Compressor {
+
+		/*
+		 * the instruction set used by the block kernels
+		 * eAVX2 uses SSE4.1 for the single channel(BC4) kernel, because a block only has 16 values
+		 */
+		enum class InstructionSet : unsigned {
+			eScalar = 0,
+			eSSE41 = 1,
+			eAVX2 = 2
+		};
+		
+	}
+	
+}
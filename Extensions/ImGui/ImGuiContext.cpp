@@ -51,8 +51,9 @@ void CodeRed::ImGuiFrameResources::update(ImDrawData* drawData)
 		)
 	);
 
-	auto vtxMemory = static_cast<ImDrawVert*>(mVertexBuffer->mapMemory());
-	auto idxMemory = static_cast<ImDrawIdx*>(mIndexBuffer->mapMemory());
+	// the buffers are in upload heap, so they are mapped persistently
+	auto vtxMemory = static_cast<ImDrawVert*>(mVertexBuffer->mappedRange(0, mVertexBuffer->size()));
+	auto idxMemory = static_cast<ImDrawIdx*>(mIndexBuffer->mappedRange(0, mIndexBuffer->size()));
 	
 	for (auto index = 0; index < drawData->CmdListsCount; index++) {
 		const auto commandList = drawData->CmdLists[index];
@@ -64,8 +65,8 @@ void CodeRed::ImGuiFrameResources::update(ImDrawData* drawData)
 		idxMemory = idxMemory + commandList->IdxBuffer.Size;
 	}
 
-	mVertexBuffer->unmapMemory();
-	mIndexBuffer->unmapMemory();
+	mVertexBuffer->flush(0, drawData->TotalVtxCount * sizeof(ImDrawVert));
+	mIndexBuffer->flush(0, drawData->TotalIdxCount * sizeof(ImDrawIdx));
 }
 
 CodeRed::ImGuiContext::ImGuiContext(
@@ -201,11 +202,6 @@ void CodeRed::ImGuiContext::draw(
 	const std::shared_ptr<GpuGraphicsCommandList>& ctx, 
 	ImDrawData* drawData)
 {
-	//clear the current heaps, we can not clear this heaps at the end of draw
-	//because we need keep the resources' life until the queue finish the commands
-	//so we can only clear them at the begin of draw
-	mCurrentDescriptorHeaps.clear();
-	
 	//copy from https://github.com/ocornut/imgui/blob/master/examples/imgui_impl_dx12.cpp#L123
 	// Avoid rendering when minimized
 	if (drawData->DisplaySize.x <= 0.0f || drawData->DisplaySize.y <= 0.0f)
@@ -269,6 +265,10 @@ void CodeRed::ImGuiContext::draw(
 		globalVtxOffset = globalVtxOffset + commandList->VtxBuffer.Size;
 	}
 
+	//the device defers the destruction of textures until the queue finishes the next submission
+	//so we do not need to keep them alive until the next draw
+	mCurrentDescriptorHeaps.clear();
+
 	mCurrentFrameIndex = (mCurrentFrameIndex + 1) % mFrameResources.size();
 }
 
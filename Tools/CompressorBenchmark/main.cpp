@@ -0,0 +1,124 @@
+#include <Extensions/Compressor/Compressor.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace CodeRed;
+
+/*
+ * the synthetic image has smooth gradients, hard edges and noise
+ * the size is not multiple of 4, so the edge blocks are also encoded
+ */
+static auto createImage(const size_t width, const size_t height) -> std::vector<Byte>
+{
+	auto image = std::vector<Byte>(width * height * 4);
+
+	unsigned seed = 19260817;
+
+	const auto noise = [&]()
+	{
+		seed = seed * 1664525u + 1013904223u;
+
+		return static_cast<int>((seed >> 24) % 17) - 8;
+	};
+
+	const auto clamp = [](const int value)
+	{
+		return static_cast<Byte>(value < 0 ? 0 : (value > 255 ? 255 : value));
+	};
+
+	for (size_t y = 0; y < height; y++) {
+		for (size_t x = 0; x < width; x++) {
+			const auto pixel = image.data() + (y * width + x) * 4;
+
+			const auto edge = ((x / 37) + (y / 29)) % 2 == 0 ? 48 : 0;
+
+			pixel[0] = clamp(static_cast<int>(x * 255 / width) + edge + noise());
+			pixel[1] = clamp(static_cast<int>(y * 255 / height) - edge + noise());
+			pixel[2] = clamp(static_cast<int>((x + y) * 255 / (width + height)) + noise());
+			pixel[3] = clamp(static_cast<int>((width - x) * 255 / width) + edge + noise());
+		}
+	}
+
+	return image;
+}
+
+/*
+ * program
+ * encode the synthetic image(1027x771) to BC1/BC3/BC4/BC5 with one thread
+ * and report the speed(MPix/s) of scalar, SSE4.1 and AVX2 kernels and the PSNR(dB) of result
+ * the kernels output the same blocks, so we only need to report the PSNR once
+ */
+
+int main() {
+	const size_t width = 1027;
+	const size_t height = 771;
+	const size_t iterations = 10;
+
+	const auto image = createImage(width, height);
+
+	const std::vector<std::pair<PixelFormat, std::string>> formats = {
+		{ PixelFormat::BlockCompressed1Unknown, "BC1" },
+		{ PixelFormat::BlockCompressed3Unknown, "BC3" },
+		{ PixelFormat::BlockCompressed4Unknown, "BC4" },
+		{ PixelFormat::BlockCompressed5Unknown, "BC5" }
+	};
+
+	const std::vector<std::pair<Compressor::InstructionSet, std::string>> instructions = {
+		{ Compressor::InstructionSet::eScalar, "Scalar" },
+		{ Compressor::InstructionSet::eSSE41, "SSE4.1" },
+		{ Compressor::InstructionSet::eAVX2, "AVX2" }
+	};
+
+	const auto supported = Compressor::supportedInstructionSet();
+
+	std::cout << "image: " << width << "x" << height << ", iterations: " << iterations << std::endl;
+
+	for (const auto& format : formats) {
+		std::cout << format.second << " :";
+
+		std::string separator = " ";
+
+		std::vector<Byte> blocks;
+
+		for (const auto& instruction : instructions) {
+			// the compressor falls back if the cpu does not support the instruction set
+			// so we skip it to avoid reporting the speed of other kernels
+			if (instruction.first > supported) {
+				std::cout << separator << instruction.second << " unsupported";
+
+				separator = ", ";
+
+				continue;
+			}
+
+			const auto option = Compressor::CompressOption(format.first, instruction.first, 1);
+
+			// warm up, the result is used to compute the PSNR
+			blocks = Compressor::compress(image.data(), width, height, option);
+
+			const auto begin = std::chrono::steady_clock::now();
+
+			for (size_t index = 0; index < iterations; index++)
+				Compressor::compress(image.data(), width, height, option);
+
+			const auto end = std::chrono::steady_clock::now();
+
+			const auto seconds = std::chrono::duration<double>(end - begin).count();
+			const auto speed = static_cast<double>(width * height * iterations) / seconds / 1e6;
+
+			std::cout << separator << instruction.second << " " << std::fixed << std::setprecision(1) << speed << " MPix/s";
+
+			separator = ", ";
+		}
+
+		const auto result = Compressor::decompress(blocks.data(), width, height, format.first);
+
+		std::cout << ", PSNR " << std::fixed << std::setprecision(1)
+			<< Compressor::computePSNR(image.data(), result.data(), width, height, format.first)
+			<< " dB" << std::endl;
+	}
+}
@@ -0,0 +1,171 @@
+#include <CodeRed/Core/CodeRedGraphics.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#undef min
+#undef max
+
+using namespace CodeRed;
+
+static auto createDevice(const std::string& api) -> std::shared_ptr<GpuLogicalDevice>
+{
+	if (api == "dx12") {
+		const auto systemInfo = std::make_shared<DirectX12SystemInfo>();
+
+		return std::make_shared<DirectX12LogicalDevice>(systemInfo->selectDisplayAdapter()[0]);
+	}
+
+	const auto systemInfo = std::make_shared<VulkanSystemInfo>();
+
+	return std::make_shared<VulkanLogicalDevice>(systemInfo->selectDisplayAdapter()[0]);
+}
+
+/*
+ * the RGBA8 image with random values, the random is a linear congruential generator
+ * so the image is same for every run
+ */
+static auto randomImage(const size_t width, const size_t height) -> std::vector<Byte>
+{
+	std::vector<Byte> image(width * height * 4);
+
+	UInt32 seed = 2020;
+
+	for (auto& value : image) {
+		seed = seed * 1664525 + 1013904223;
+
+		value = static_cast<Byte>(seed >> 24);
+	}
+
+	return image;
+}
+
+/*
+ * the 2x2 box filter of RGBA8 image, the width and height of image should be multiple of 2
+ */
+static auto boxFilter(const std::vector<Byte>& image, const size_t width, const size_t height) -> std::vector<Byte>
+{
+	const auto halfWidth = width / 2;
+	const auto halfHeight = height / 2;
+
+	std::vector<Byte> result(halfWidth * halfHeight * 4);
+
+	for (size_t y = 0; y < halfHeight; y++) {
+		for (size_t x = 0; x < halfWidth; x++) {
+			for (size_t channel = 0; channel < 4; channel++) {
+				const auto sum =
+					image[((y * 2 + 0) * width + x * 2 + 0) * 4 + channel] +
+					image[((y * 2 + 0) * width + x * 2 + 1) * 4 + channel] +
+					image[((y * 2 + 1) * width + x * 2 + 0) * 4 + channel] +
+					image[((y * 2 + 1) * width + x * 2 + 1) * 4 + channel];
+
+				// round to nearest, same as the conversion from float to unorm
+				result[(y * halfWidth + x) * 4 + channel] = static_cast<Byte>((sum + 2) / 4);
+			}
+		}
+	}
+
+	return result;
+}
+
+static auto maxDifference(const std::vector<Byte>& left, const std::vector<Byte>& right) -> int
+{
+	int difference = 0;
+
+	for (size_t index = 0; index < left.size(); index++)
+		difference = std::max(difference, std::abs(static_cast<int>(left[index]) - static_cast<int>(right[index])));
+
+	return difference;
+}
+
+/*
+ * program
+ * [dx12] : use DirectX12 instead of Vulkan(default)
+ * upload a random 256x256 image to the mip level 0 of texture and generate the other mip levels on gpu
+ * then read every mip level back and compare it with the 2x2 box filter of the mip level before it(read from gpu)
+ * so the errors of mip levels are not accumulated, the difference of every channel should not be greater than tolerance
+ * the program returns 0 if all checks passed
+ */
+
+int main(int argc, char** argv) {
+	const std::string api = argc > 1 ? argv[1] : "vulkan";
+
+	const size_t size = 256;
+	const size_t mipLevels = 9;
+	const auto format = PixelFormat::RedGreenBlueAlpha8BitUnknown;
+
+	// the linear filter of gpu is not exact, so we allow the difference of one or two steps
+	const int tolerance = 2;
+
+	const auto device = createDevice(api);
+	const auto queue = device->createCommandQueue();
+	const auto allocator = device->createCommandAllocator();
+	const auto commandList = device->createGraphicsCommandList(allocator);
+
+	// in DirectX12 mode, the mip levels are drawn by built-in pipeline, so the texture should be render target
+	const auto texture = device->createTexture(
+		ResourceInfo::Texture2D(size, size, format, mipLevels, ResourceUsage::RenderTarget));
+
+	std::vector<std::shared_ptr<GpuTextureBuffer>> buffers;
+
+	for (size_t mipSlice = 0; mipSlice < mipLevels; mipSlice++)
+		buffers.push_back(device->createTextureBuffer(texture, mipSlice));
+
+	const auto image = randomImage(size, size);
+
+	buffers[0]->write(image);
+
+	commandList->beginRecording();
+
+	commandList->layoutTransition(texture, ResourceLayout::CopyDestination);
+
+	commandList->copyBufferToTexture(
+		TextureBufferCopyInfo(buffers[0]),
+		TextureCopyInfo(texture, texture->index(0, 0)),
+		texture->width(0), texture->height(0));
+
+	commandList->generateMipmaps(texture);
+
+	commandList->layoutTransition(texture, ResourceLayout::CopySource);
+
+	for (size_t mipSlice = 0; mipSlice < mipLevels; mipSlice++) {
+		commandList->copyTextureToBuffer(
+			TextureCopyInfo(texture, texture->index(mipSlice, 0)),
+			TextureBufferCopyInfo(buffers[mipSlice]),
+			texture->width(mipSlice), texture->height(mipSlice));
+	}
+
+	commandList->endRecording();
+
+	queue->execute({ commandList });
+	queue->waitIdle();
+
+	std::cout << "api: " << (api == "dx12" ? "DirectX12" : "Vulkan")
+		<< ", size: " << size << ", mip levels: " << mipLevels << ", tolerance: " << tolerance << std::endl;
+
+	// the mip level 0 is copied, so it should be same as the image
+	auto previous = buffers[0]->read();
+	auto passed = maxDifference(previous, image) == 0;
+
+	std::cout << "mip level 0 : " << texture->width(0) << "x" << texture->height(0)
+		<< ", " << (passed ? "passed" : "failed") << std::endl;
+
+	for (size_t mipSlice = 1; mipSlice < mipLevels; mipSlice++) {
+		const auto level = buffers[mipSlice]->read();
+		const auto expected = boxFilter(previous, texture->width(mipSlice - 1), texture->height(mipSlice - 1));
+		const auto difference = maxDifference(level, expected);
+
+		std::cout << "mip level " << mipSlice << " : " << texture->width(mipSlice) << "x" << texture->height(mipSlice)
+			<< ", max difference " << difference << ", " << (difference <= tolerance ? "passed" : "failed") << std::endl;
+
+		passed = difference <= tolerance && passed;
+		previous = level;
+	}
+
+	std::cout << (passed ? "all checks passed." : "some checks failed.") << std::endl;
+
+	return passed ? 0 : 1;
+}
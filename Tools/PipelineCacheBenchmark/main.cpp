@@ -0,0 +1,282 @@
+#include <Extensions/Compiler/Compiler.hpp>
+
+#include <CodeRed/Core/CodeRedGraphics.hpp>
+
+#include <iostream>
+#include <iomanip>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace CodeRed;
+
+static auto createDevice(const std::string& api) -> std::shared_ptr<GpuLogicalDevice>
+{
+	if (api == "dx12") {
+		const auto systemInfo = std::make_shared<DirectX12SystemInfo>();
+
+		return std::make_shared<DirectX12LogicalDevice>(systemInfo->selectDisplayAdapter()[0]);
+	}
+
+	const auto systemInfo = std::make_shared<VulkanSystemInfo>();
+
+	return std::make_shared<VulkanLogicalDevice>(systemInfo->selectDisplayAdapter()[0]);
+}
+
+/*
+ * the header of pipeline cache blob, it is same as the header in GpuLogicalDevice.cpp
+ * we only use it to make the stale blobs, so it is not a part of interface
+ */
+struct PipelineCacheHeader {
+	UInt32 Magic = 0;
+	UInt32 Version = 0;
+	UInt32 API = 0;
+	UInt32 VendorId = 0;
+	UInt32 DeviceId = 0;
+	UInt32 Reserved = 0;
+	UInt64 DriverVersion = 0;
+	UInt64 DataSize = 0;
+	UInt64 Checksum = 0;
+};
+
+static_assert(sizeof(PipelineCacheHeader) == 48, "the header should be same as the header of GpuLogicalDevice.");
+
+static const std::string vertexShaderCode = R"(
+struct Output
+{
+    float4 Position : SV_POSITION;
+};
+
+Output main(uint id : SV_VERTEXID)
+{
+    Output result;
+
+    float2 uv = float2((id << 1) & 2, id & 2);
+
+    result.Position = float4(uv * float2(2, -2) + float2(-1, 1), 0, 1);
+
+    return result;
+}
+)";
+
+/*
+ * the pixel shaders output different colors, so their byte codes are different
+ */
+static auto pixelShaderCode(const size_t index) -> std::string
+{
+	return
+		"float4 main() : SV_TARGET\n"
+		"{\n"
+		"    return float4(" + std::to_string(index) + ".0 / 8.0, 0.5, 0.5, 1.0);\n"
+		"}\n";
+}
+
+static auto compileShader(const std::string& api, const std::string& code, const ShaderType type) -> std::vector<Byte>
+{
+	const auto option = Compiler::CompileOption(
+		Compiler::SourceLanguage::eHLSL,
+		api == "dx12" ? Compiler::TargetLanguage::eDXIL : Compiler::TargetLanguage::eSPIRV,
+		type);
+
+	const auto result = Compiler::compile(code, option);
+
+	if (result.failed()) std::cout << result.Message << std::endl;
+
+	return result.Code;
+}
+
+struct PipelineSet {
+	std::shared_ptr<GpuRenderPass> RenderPass;
+	std::shared_ptr<GpuResourceLayout> ResourceLayout;
+	std::shared_ptr<GpuInputAssemblyState> InputAssembly;
+	std::shared_ptr<GpuShaderState> VertexShader;
+
+	std::vector<std::shared_ptr<GpuShaderState>> PixelShaders;
+	std::vector<std::shared_ptr<GpuDepthStencilState>> DepthStencils;
+	std::vector<std::shared_ptr<GpuBlendState>> Blends;
+	std::vector<std::shared_ptr<GpuRasterizationState>> Rasterizations;
+
+	auto count() const noexcept -> size_t
+	{
+		return PixelShaders.size() * DepthStencils.size() * Blends.size() * Rasterizations.size();
+	}
+};
+
+/*
+ * create the states of pipeline set, the states are same for every device
+ * so the pipelines of two devices are same and the warm device can find them in cache
+ */
+static auto createPipelineSet(
+	const std::shared_ptr<GpuLogicalDevice>& device,
+	const std::vector<Byte>& vertexShader,
+	const std::vector<std::vector<Byte>>& pixelShaders)
+	-> PipelineSet
+{
+	const auto factory = device->createPipelineFactory();
+
+	PipelineSet set;
+
+	set.RenderPass = device->createRenderPass(
+		{ Attachment::RenderTarget(PixelFormat::RedGreenBlueAlpha8BitUnknown) },
+		Attachment::DepthStencil(PixelFormat::Depth32BitFloat));
+
+	set.ResourceLayout = device->createResourceLayout();
+	set.InputAssembly = factory->createInputAssemblyState({}, PrimitiveTopology::TriangleList);
+	set.VertexShader = factory->createShaderState(ShaderType::Vertex, vertexShader);
+
+	for (const auto& pixelShader : pixelShaders)
+		set.PixelShaders.push_back(factory->createShaderState(ShaderType::Pixel, pixelShader));
+
+	set.DepthStencils.push_back(factory->createDetphStencilState(true, true));
+	set.DepthStencils.push_back(factory->createDetphStencilState(false, false));
+
+	set.Blends.push_back(factory->createBlendState({ BlendProperty(false) }));
+	set.Blends.push_back(factory->createBlendState({ BlendProperty(true,
+		BlendOperator::Add, BlendOperator::Add,
+		BlendFactor::InvSrcAlpha, BlendFactor::InvSrcAlpha,
+		BlendFactor::SrcAlpha, BlendFactor::SrcAlpha) }));
+
+	set.Rasterizations.push_back(factory->createRasterizationState(FrontFace::Clockwise, CullMode::Back));
+	set.Rasterizations.push_back(factory->createRasterizationState(FrontFace::Clockwise, CullMode::None));
+	set.Rasterizations.push_back(factory->createRasterizationState(FrontFace::Clockwise, CullMode::None, FillMode::Wireframe));
+
+	return set;
+}
+
+/*
+ * create all pipelines of set with device(not the factory, it may return the pipelines it created before)
+ * return the seconds of creating them, the states are not measured
+ */
+static auto createPipelines(const std::shared_ptr<GpuLogicalDevice>& device, const PipelineSet& set) -> double
+{
+	std::vector<std::shared_ptr<GpuGraphicsPipeline>> pipelines;
+
+	const auto start = std::chrono::steady_clock::now();
+
+	for (const auto& pixelShader : set.PixelShaders) {
+		for (const auto& depthStencil : set.DepthStencils) {
+			for (const auto& blend : set.Blends) {
+				for (const auto& rasterization : set.Rasterizations) {
+					pipelines.push_back(device->createGraphicsPipeline(
+						set.RenderPass, set.ResourceLayout, set.InputAssembly,
+						set.VertexShader, pixelShader, depthStencil, blend, rasterization));
+				}
+			}
+		}
+	}
+
+	const auto finish = std::chrono::steady_clock::now();
+
+	return std::chrono::duration<double>(finish - start).count();
+}
+
+static auto check(const std::string& name, const bool passed) -> bool
+{
+	std::cout << "check " << name << " : " << (passed ? "passed" : "failed") << std::endl;
+
+	return passed;
+}
+
+/*
+ * copy the blob and modify the header of copy
+ */
+template<typename Function>
+static auto modifyHeader(const std::vector<Byte>& blob, const Function& function) -> std::vector<Byte>
+{
+	auto result = blob;
+
+	PipelineCacheHeader header;
+
+	std::memcpy(&header, result.data(), sizeof(PipelineCacheHeader));
+
+	function(header);
+
+	std::memcpy(result.data(), &header, sizeof(PipelineCacheHeader));
+
+	return result;
+}
+
+/*
+ * program
+ * [dx12] : use DirectX12 instead of Vulkan(default)
+ * create a set of graphics pipelines with a cold cache, save the cache and release the device
+ * then create a new device, load the cache and create the same set again, report the time of both
+ * and check the blobs with other driver version, device id, data, size or magic are rejected
+ * the program returns 0 if all checks passed
+ */
+
+int main(int argc, char** argv) {
+	const std::string api = argc > 1 ? argv[1] : "vulkan";
+	const std::string fileName = "PipelineCacheBenchmark.bin";
+
+	const size_t pixelShaderCount = 8;
+
+	// the shaders are compiled once, so the time of compiler is not measured
+	const auto vertexShader = compileShader(api, vertexShaderCode, ShaderType::Vertex);
+
+	std::vector<std::vector<Byte>> pixelShaders;
+
+	for (size_t index = 0; index < pixelShaderCount; index++)
+		pixelShaders.push_back(compileShader(api, pixelShaderCode(index), ShaderType::Pixel));
+
+	std::cout << "api: " << (api == "dx12" ? "DirectX12" : "Vulkan") << std::endl;
+
+	auto passed = true;
+
+	{
+		// the device is created without loading cache, so the pipelines are compiled by driver
+		const auto device = createDevice(api);
+		const auto set = createPipelineSet(device, vertexShader, pixelShaders);
+
+		const auto seconds = createPipelines(device, set);
+
+		std::cout << "cold : " << set.count() << " pipelines, "
+			<< std::fixed << std::setprecision(2) << seconds * 1000 << " ms" << std::endl;
+
+		device->savePipelineCache(fileName);
+	}
+
+	const auto device = createDevice(api);
+
+	passed = check("load cache", device->loadPipelineCache(fileName)) && passed;
+
+	const auto set = createPipelineSet(device, vertexShader, pixelShaders);
+
+	const auto seconds = createPipelines(device, set);
+
+	std::cout << "warm : " << set.count() << " pipelines, "
+		<< std::fixed << std::setprecision(2) << seconds * 1000 << " ms" << std::endl;
+
+	const auto blob = device->pipelineCacheBlob();
+
+	// the stale blobs should be rejected by header or checksum before they are given to backend
+	passed = check("reject driver version", !device->loadPipelineCacheBlob(
+		modifyHeader(blob, [](PipelineCacheHeader& header) { header.DriverVersion = header.DriverVersion + 1; }))) && passed;
+
+	passed = check("reject device id", !device->loadPipelineCacheBlob(
+		modifyHeader(blob, [](PipelineCacheHeader& header) { header.DeviceId = header.DeviceId + 1; }))) && passed;
+
+	passed = check("reject magic", !device->loadPipelineCacheBlob(
+		modifyHeader(blob, [](PipelineCacheHeader& header) { header.Magic = ~header.Magic; }))) && passed;
+
+	auto truncated = blob;
+
+	truncated.pop_back();
+
+	passed = check("reject truncated blob", !device->loadPipelineCacheBlob(truncated)) && passed;
+
+	// if the backend does not support pipeline cache, the data is empty and there is nothing to flip
+	if (blob.size() > sizeof(PipelineCacheHeader)) {
+		auto corrupted = blob;
+
+		corrupted.back() = static_cast<Byte>(corrupted.back() ^ 0xff);
+
+		passed = check("reject checksum", !device->loadPipelineCacheBlob(corrupted)) && passed;
+	}
+	else std::cout << "check reject checksum : skipped(the cache is empty)" << std::endl;
+
+	std::cout << (passed ? "all checks passed." : "some checks failed.") << std::endl;
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,130 @@
+#include <CodeRed/Core/CodeRedGraphics.hpp>
+
+#include <functional>
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#undef min
+#undef max
+
+using namespace CodeRed;
+
+static auto createDevice(const std::string& api) -> std::shared_ptr<GpuLogicalDevice>
+{
+	if (api == "dx12") {
+		const auto systemInfo = std::make_shared<DirectX12SystemInfo>();
+
+		return std::make_shared<DirectX12LogicalDevice>(systemInfo->selectDisplayAdapter()[0]);
+	}
+
+	const auto systemInfo = std::make_shared<VulkanSystemInfo>();
+
+	return std::make_shared<VulkanLogicalDevice>(systemInfo->selectDisplayAdapter()[0]);
+}
+
+/*
+ * split [0, count) into threads ranges and run function(begin, end) on one thread per range
+ * the ranges are same for the same threads, so the lists of a range are always recorded by one thread
+ */
+static void parallelFor(const size_t threads, const size_t count, const std::function<void(size_t, size_t)>& function)
+{
+	std::vector<std::thread> workers;
+
+	for (size_t index = 0; index < threads; index++) {
+		const auto begin = count * index / threads;
+		const auto end = count * (index + 1) / threads;
+
+		workers.push_back(std::thread(function, begin, end));
+	}
+
+	for (auto& worker : workers) worker.join();
+}
+
+/*
+ * program
+ * [dx12] : use DirectX12 instead of Vulkan(default)
+ * record 1024 command lists(64 buffer copies per list) for 10 frames on 1, 2, 4 ... hardware threads
+ * every thread records its lists with the allocator of GpuCommandAllocatorPool
+ * and report the speed(lists/s and commands/s) of recording, the lists of last frame are executed to check them
+ */
+
+int main(int argc, char** argv) {
+	const std::string api = argc > 1 ? argv[1] : "vulkan";
+
+	const size_t lists = 1024;
+	const size_t commands = 64;
+	const size_t frames = 10;
+	const size_t regionSize = 256;
+
+	const auto maxThreads = std::max(static_cast<size_t>(std::thread::hardware_concurrency()), static_cast<size_t>(1));
+
+	const auto device = createDevice(api);
+	const auto queue = device->createCommandQueue();
+
+	// every command copies a region of source to the same region of destination
+	const auto source = device->createBuffer(
+		ResourceInfo::UploadBuffer(regionSize, commands));
+	const auto destination = device->createBuffer(
+		ResourceInfo::VertexBuffer(regionSize, commands, MemoryHeap::Default, ResourceLayout::CopyDestination));
+
+	std::vector<size_t> threadCounts;
+
+	for (size_t threads = 1; threads < maxThreads; threads = threads * 2) threadCounts.push_back(threads);
+
+	threadCounts.push_back(maxThreads);
+
+	std::cout << "api: " << (api == "dx12" ? "DirectX12" : "Vulkan")
+		<< ", lists: " << lists << ", commands: " << commands << ", frames: " << frames << std::endl;
+
+	for (const auto threads : threadCounts) {
+		const auto pool = std::make_shared<GpuCommandAllocatorPool>(device);
+
+		std::vector<std::shared_ptr<GpuGraphicsCommandList>> commandLists(lists);
+
+		// the lists of a range are allocated from the allocator of one thread in pool, it is not measured
+		// so every allocator is only used by one thread at the same time when we record the lists
+		parallelFor(threads, lists, [&](const size_t begin, const size_t end)
+			{
+				for (auto index = begin; index < end; index++)
+					commandLists[index] = device->createGraphicsCommandList(pool->allocator());
+			});
+
+		const auto start = std::chrono::steady_clock::now();
+
+		for (size_t frame = 0; frame < frames; frame++) {
+			// the lists are not executed before the last frame, so we can reset the allocators directly
+			pool->reset();
+
+			parallelFor(threads, lists, [&](const size_t begin, const size_t end)
+				{
+					for (auto index = begin; index < end; index++) {
+						const auto& commandList = commandLists[index];
+
+						commandList->beginRecording();
+
+						for (size_t command = 0; command < commands; command++)
+							commandList->copyBuffer(source, destination, regionSize, command * regionSize, command * regionSize);
+
+						commandList->endRecording();
+					}
+				});
+		}
+
+		const auto finish = std::chrono::steady_clock::now();
+
+		queue->execute(commandLists);
+		queue->waitIdle();
+
+		const auto seconds = std::chrono::duration<double>(finish - start).count();
+		const auto listSpeed = static_cast<double>(lists * frames) / seconds;
+
+		std::cout << "threads " << std::setw(2) << threads << " : "
+			<< std::fixed << std::setprecision(0) << listSpeed << " lists/s, "
+			<< std::fixed << std::setprecision(1) << listSpeed * commands / 1e6 << " M commands/s" << std::endl;
+	}
+}
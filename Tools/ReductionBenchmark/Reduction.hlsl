@@ -0,0 +1,25 @@
+// every group sums 1024 values(4 values per thread) in group shared memory
+// and adds the sum of group to the output with an atomic operation
+
+StructuredBuffer<uint> input : register(t0, space0);
+RWStructuredBuffer<uint> output : register(u1, space0);
+
+groupshared uint sums[256];
+
+[numthreads(256, 1, 1)]
+void main(uint3 groupId : SV_GROUPID, uint threadId : SV_GROUPINDEX)
+{
+    uint base = groupId.x * 1024 + threadId;
+
+    sums[threadId] = input[base] + input[base + 256] + input[base + 512] + input[base + 768];
+
+    GroupMemoryBarrierWithGroupSync();
+
+    for (uint stride = 128; stride > 0; stride >>= 1) {
+        if (threadId < stride) sums[threadId] += sums[threadId + stride];
+
+        GroupMemoryBarrierWithGroupSync();
+    }
+
+    if (threadId == 0) InterlockedAdd(output[0], sums[0]);
+}
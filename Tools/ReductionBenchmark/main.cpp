@@ -0,0 +1,187 @@
+#include <Extensions/Compiler/Compiler.hpp>
+
+#include <CodeRed/Core/CodeRedGraphics.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <cstring>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#undef min
+#undef max
+
+using namespace CodeRed;
+
+static auto createDevice(const std::string& api) -> std::shared_ptr<GpuLogicalDevice>
+{
+	if (api == "dx12") {
+		const auto systemInfo = std::make_shared<DirectX12SystemInfo>();
+
+		return std::make_shared<DirectX12LogicalDevice>(systemInfo->selectDisplayAdapter()[0]);
+	}
+
+	const auto systemInfo = std::make_shared<VulkanSystemInfo>();
+
+	return std::make_shared<VulkanLogicalDevice>(systemInfo->selectDisplayAdapter()[0]);
+}
+
+static auto readShader(const std::string& fileName) -> std::string
+{
+	std::ifstream file(fileName);
+	std::stringstream stream;
+
+	stream << file.rdbuf();
+
+	return stream.str();
+}
+
+static auto compileShader(const std::string& api, const std::string& code) -> std::vector<Byte>
+{
+	const auto option = Compiler::CompileOption(
+		Compiler::SourceLanguage::eHLSL,
+		api == "dx12" ? Compiler::TargetLanguage::eDXIL : Compiler::TargetLanguage::eSPIRV,
+		ShaderType::Compute);
+
+	const auto result = Compiler::compile(code, option);
+
+	if (result.failed()) std::cout << result.Message << std::endl;
+
+	return result.Code;
+}
+
+/*
+ * program
+ * [dx12] : use DirectX12 instead of Vulkan(default)
+ * [shader] : the file of reduction shader, the default is Reduction.hlsl
+ * sum 16M unsigned integers with Reduction.hlsl and a cpu loop, check the sums are same
+ * and report the best time of both in 10 iterations
+ * the program returns 0 if the sums of all iterations are same
+ */
+
+int main(int argc, char** argv) {
+	const std::string api = argc > 1 ? argv[1] : "vulkan";
+	const std::string shaderName = argc > 2 ? argv[2] : "Reduction.hlsl";
+
+	// every group of shader sums 1024 values, so the count should be multiple of 1024
+	const size_t count = 1 << 24;
+	const size_t groupSize = 1024;
+	const size_t iterations = 10;
+
+	const auto device = createDevice(api);
+	const auto queue = device->createCommandQueue();
+	const auto allocator = device->createCommandAllocator();
+	const auto commandList = device->createGraphicsCommandList(allocator);
+	const auto factory = device->createPipelineFactory();
+
+	std::vector<UInt32> values(count);
+
+	for (size_t index = 0; index < count; index++) values[index] = static_cast<UInt32>(index % 251);
+
+	// the input is in default heap, so we upload it with a copy
+	// the output is cleared by copying zero from the upload buffer before every dispatch
+	const auto upload = device->createBuffer(ResourceInfo::UploadBuffer(sizeof(UInt32), count + 1));
+	const auto input = device->createBuffer(
+		ResourceInfo::GroupBuffer(sizeof(UInt32), count, MemoryHeap::Default, ResourceLayout::CopyDestination));
+	const auto output = device->createBuffer(
+		ResourceInfo::GroupBuffer(sizeof(UInt32), 1, MemoryHeap::Default, ResourceLayout::CopyDestination));
+	const auto readback = device->createBuffer(ResourceInfo::ReadbackBuffer(sizeof(UInt32), 1));
+
+	const UInt32 zero = 0;
+
+	std::memcpy(upload->mappedRange(0, count * sizeof(UInt32)), values.data(), count * sizeof(UInt32));
+	std::memcpy(upload->mappedRange(count * sizeof(UInt32), sizeof(UInt32)), &zero, sizeof(UInt32));
+
+	upload->flush(0, upload->size());
+
+	const auto layout = device->createResourceLayout(
+		{
+			ResourceLayoutElement(ResourceType::GroupBuffer, 0),
+			ResourceLayoutElement(ResourceType::GroupBuffer, 1, 0, ShaderVisibility::All, true)
+		});
+
+	const auto descriptorHeap = device->createDescriptorHeap(layout);
+
+	descriptorHeap->bindBuffer(input, 0);
+	descriptorHeap->bindBuffer(output, 1);
+
+	const auto pipeline = device->createComputePipeline(layout,
+		factory->createShaderState(ShaderType::Compute, compileShader(api, readShader(shaderName))));
+
+	commandList->beginRecording();
+	commandList->copyBuffer(upload, input, count * sizeof(UInt32));
+	commandList->layoutTransition(input, ResourceLayout::CopyDestination, ResourceLayout::GeneralRead);
+	commandList->endRecording();
+
+	queue->execute({ commandList });
+	queue->waitIdle();
+
+	std::cout << "api: " << (api == "dx12" ? "DirectX12" : "Vulkan")
+		<< ", values: " << count << ", iterations: " << iterations << std::endl;
+
+	auto passed = true;
+	auto cpuTime = std::numeric_limits<double>::max();
+	auto gpuTime = std::numeric_limits<double>::max();
+
+	for (size_t iteration = 0; iteration < iterations; iteration++) {
+		// the sum is wrapped in 32bit, the shader does the same thing
+		const auto cpuStart = std::chrono::steady_clock::now();
+
+		UInt32 cpuSum = 0;
+
+		for (size_t index = 0; index < count; index++) cpuSum = cpuSum + values[index];
+
+		const auto cpuFinish = std::chrono::steady_clock::now();
+
+		allocator->reset();
+
+		commandList->beginRecording();
+		commandList->copyBuffer(upload, output, sizeof(UInt32), count * sizeof(UInt32), 0);
+		commandList->layoutTransition(output, ResourceLayout::CopyDestination, ResourceLayout::GeneralReadWrite);
+		commandList->setComputePipeline(pipeline);
+		commandList->setResourceLayout(layout);
+		commandList->setDescriptorHeap(descriptorHeap);
+		commandList->dispatch(count / groupSize);
+		commandList->layoutTransition(output, ResourceLayout::GeneralReadWrite, ResourceLayout::CopySource);
+		commandList->copyBuffer(output, readback, sizeof(UInt32));
+		commandList->layoutTransition(output, ResourceLayout::CopySource, ResourceLayout::CopyDestination);
+		commandList->endRecording();
+
+		// there is no timestamp query, so the time of gpu includes the submission and the wait
+		const auto gpuStart = std::chrono::steady_clock::now();
+
+		queue->execute({ commandList });
+		queue->waitIdle();
+
+		const auto gpuFinish = std::chrono::steady_clock::now();
+
+		readback->invalidate(0, sizeof(UInt32));
+
+		UInt32 gpuSum = 0;
+
+		std::memcpy(&gpuSum, readback->mappedRange(0, sizeof(UInt32)), sizeof(UInt32));
+
+		passed = passed && gpuSum == cpuSum;
+
+		cpuTime = std::min(cpuTime, std::chrono::duration<double>(cpuFinish - cpuStart).count());
+		gpuTime = std::min(gpuTime, std::chrono::duration<double>(gpuFinish - gpuStart).count());
+
+		if (gpuSum != cpuSum)
+			std::cout << "iteration " << iteration << " : gpu sum " << gpuSum << ", cpu sum " << cpuSum << std::endl;
+	}
+
+	const auto bytes = static_cast<double>(count * sizeof(UInt32));
+
+	std::cout << "cpu : " << std::fixed << std::setprecision(3) << cpuTime * 1000 << " ms, "
+		<< std::setprecision(1) << bytes / cpuTime / 1e9 << " GB/s" << std::endl;
+	std::cout << "gpu : " << std::fixed << std::setprecision(3) << gpuTime * 1000 << " ms, "
+		<< std::setprecision(1) << bytes / gpuTime / 1e9 << " GB/s" << std::endl;
+	std::cout << "check sum : " << (passed ? "passed" : "failed") << std::endl;
+
+	return passed ? 0 : 1;
+}
@@ -0,0 +1,167 @@
+#include <CodeRed/Core/CodeRedGraphics.hpp>
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace CodeRed;
+
+static auto createDevice(const std::string& api) -> std::shared_ptr<GpuLogicalDevice>
+{
+	if (api == "dx12") {
+		const auto systemInfo = std::make_shared<DirectX12SystemInfo>();
+
+		return std::make_shared<DirectX12LogicalDevice>(systemInfo->selectDisplayAdapter()[0]);
+	}
+
+	const auto systemInfo = std::make_shared<VulkanSystemInfo>();
+
+	return std::make_shared<VulkanLogicalDevice>(systemInfo->selectDisplayAdapter()[0]);
+}
+
+/*
+ * the color of RGBA8 texture cleared with value, the value should be 0 or 1
+ */
+static auto clearColor(const ClearValue& value) -> std::vector<Byte>
+{
+	return {
+		static_cast<Byte>(value.Red * 255),
+		static_cast<Byte>(value.Green * 255),
+		static_cast<Byte>(value.Blue * 255),
+		static_cast<Byte>(value.Alpha * 255)
+	};
+}
+
+static auto isFilled(const std::shared_ptr<GpuTextureBuffer>& buffer, const std::vector<Byte>& color) -> bool
+{
+	const auto data = buffer->read();
+
+	for (size_t index = 0; index < buffer->width() * buffer->height(); index++) {
+		for (size_t channel = 0; channel < 4; channel++)
+			if (data[index * 4 + channel] != color[channel]) return false;
+	}
+
+	return true;
+}
+
+static auto check(const std::string& name, const bool passed) -> bool
+{
+	std::cout << "check " << name << " : " << (passed ? "passed" : "failed") << std::endl;
+
+	return passed;
+}
+
+/*
+ * program
+ * [dx12] : use DirectX12 instead of Vulkan(default)
+ * build a graph without window and execute it for some frames, every frame checks :
+ * culling : the pass that writes a texture nobody reads is culled
+ * aliasing : two transient textures with same information(but different clear values) share one texture
+ * clear values : the render passes clear the shared texture with the clear values of transient textures
+ * final layout : the imported texture is translated to its final layout at the end of graph
+ * the program returns 0 if all checks passed
+ */
+
+int main(int argc, char** argv) {
+	const std::string api = argc > 1 ? argv[1] : "vulkan";
+
+	const size_t width = 64;
+	const size_t height = 64;
+	const size_t frames = 3;
+	const auto format = PixelFormat::RedGreenBlueAlpha8BitUnknown;
+
+	const auto device = createDevice(api);
+	const auto queue = device->createCommandQueue();
+	const auto allocator = device->createCommandAllocator();
+	const auto commandList = device->createGraphicsCommandList(allocator);
+
+	const auto graph = std::make_shared<GpuRenderGraph>(device);
+
+	const auto target = device->createTexture(ResourceInfo::RenderTarget(width, height, format));
+
+	const auto bufferA = device->createTextureBuffer(TextureBufferInfo::Texture2D(width, height, format));
+	const auto bufferB = device->createTextureBuffer(TextureBufferInfo::Texture2D(width, height, format));
+
+	std::cout << "api: " << (api == "dx12" ? "DirectX12" : "Vulkan") << ", frames: " << frames << std::endl;
+
+	auto passed = true;
+
+	for (size_t frame = 0; frame < frames; frame++) {
+		// the clear values are changed every frame, so the cached render passes should use new values
+		const auto clearA = frame % 2 == 0 ? ClearValue(1, 0, 0, 1) : ClearValue(0, 1, 0, 1);
+		const auto clearB = frame % 2 == 0 ? ClearValue(0, 0, 1, 1) : ClearValue(1, 1, 0, 1);
+
+		graph->reset();
+
+		const auto textureA = graph->createTexture("A", ResourceInfo::RenderTarget(width, height, format, clearA));
+		const auto textureB = graph->createTexture("B", ResourceInfo::RenderTarget(width, height, format, clearB));
+		const auto unused = graph->createTexture("Unused", ResourceInfo::RenderTarget(width, height, format));
+		const auto imported = graph->importTexture("Target", target, ResourceLayout::GeneralRead);
+
+		graph->addPass("ClearA",
+			[&](GpuRenderGraph::Builder& builder) { builder.renderTarget(textureA); },
+			nullptr);
+
+		graph->addPass("ReadA",
+			[&](GpuRenderGraph::Builder& builder) { builder.read(textureA, ResourceLayout::CopySource).sideEffect(); },
+			[&](const GpuRenderGraph::Context& context)
+			{
+				context.commandList()->copyTextureToBuffer(
+					TextureCopyInfo(context.texture(textureA)),
+					TextureBufferCopyInfo(bufferA), width, height);
+			});
+
+		// the lifetime of B starts after the lifetime of A, so they can share one texture
+		graph->addPass("ClearB",
+			[&](GpuRenderGraph::Builder& builder) { builder.renderTarget(textureB); },
+			nullptr);
+
+		graph->addPass("ReadB",
+			[&](GpuRenderGraph::Builder& builder) { builder.read(textureB, ResourceLayout::CopySource).sideEffect(); },
+			[&](const GpuRenderGraph::Context& context)
+			{
+				context.commandList()->copyTextureToBuffer(
+					TextureCopyInfo(context.texture(textureB)),
+					TextureBufferCopyInfo(bufferB), width, height);
+			});
+
+		// nobody reads the unused texture, so the pass is culled
+		graph->addPass("Culled",
+			[&](GpuRenderGraph::Builder& builder) { builder.renderTarget(unused); },
+			nullptr);
+
+		graph->addPass("ClearTarget",
+			[&](GpuRenderGraph::Builder& builder) { builder.renderTarget(imported); },
+			nullptr);
+
+		commandList->beginRecording();
+
+		graph->execute(commandList);
+
+		commandList->endRecording();
+
+		queue->execute({ commandList });
+		queue->waitIdle();
+
+		allocator->reset();
+
+		const auto statistics = graph->statistics();
+
+		std::cout << "frame " << frame << ": "
+			<< "passes " << statistics.Passes << ", "
+			<< "culled " << statistics.CulledPasses << ", "
+			<< "transitions " << statistics.Transitions << ", "
+			<< "barriers " << statistics.Barriers << ", "
+			<< "transient " << statistics.TransientTextures << ", "
+			<< "physical " << statistics.PhysicalTextures << std::endl;
+
+		passed = check("culling", statistics.Passes == 5 && statistics.CulledPasses == 1) && passed;
+		passed = check("aliasing", statistics.TransientTextures == 2 && statistics.PhysicalTextures == 1) && passed;
+		passed = check("clear values", isFilled(bufferA, clearColor(clearA)) && isFilled(bufferB, clearColor(clearB))) && passed;
+		passed = check("final layout", target->layout(0, 0) == ResourceLayout::GeneralRead) && passed;
+	}
+
+	std::cout << (passed ? "all checks passed." : "some checks failed.") << std::endl;
+
+	return passed ? 0 : 1;
+}